@@ -1,8 +1,14 @@
 #include "AnxietyMonitor.h"
 #include "AnxietyScorer.h"
 #include "CSVWriter.h"
+#include "ChangePointDetector.h"
 #include "DataCollector.h"
 #include "EventHandlers.h"
+#include "Instrumentation.h"
+#include "LiveMetricsSegment.h"
+#include "MetricsEndpoint.h"
+#include "SystemSampler.h"
+#include "TraceRecorder.h"
 #include "UIComponents.h"
 
 #ifndef STANDALONE_BUILD
@@ -18,6 +24,7 @@
 #include <cerrno>
 #include <chrono>
 #include <cstring>
+#include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
@@ -33,10 +40,12 @@ enum {
   ID_ANXIETY_EXPORT,
   ID_ANXIETY_SETTINGS,
   ID_ANXIETY_TIMER,
+  ID_ANXIETY_DRAIN_TIMER,
   ID_MENU_START,
   ID_MENU_PAUSE,
   ID_MENU_END,
-  ID_MENU_SHOW_PANEL
+  ID_MENU_SHOW_PANEL,
+  ID_MENU_TRACE
 };
 
 // ============================================================================
@@ -45,6 +54,7 @@ enum {
 wxBEGIN_EVENT_TABLE(AnxietyMonitorPlugin,
                     cbPlugin) EVT_TIMER(ID_ANXIETY_TIMER,
                                         AnxietyMonitorPlugin::OnTimerUpdate)
+    EVT_TIMER(ID_ANXIETY_DRAIN_TIMER, AnxietyMonitorPlugin::OnDrainTimer)
     EVT_BUTTON(ID_ANXIETY_START, AnxietyMonitorPlugin::OnStartButton)
         EVT_BUTTON(ID_ANXIETY_PAUSE, AnxietyMonitorPlugin::OnPauseButton)
             EVT_BUTTON(ID_ANXIETY_EXPORT, AnxietyMonitorPlugin::OnExportButton)
@@ -57,6 +67,8 @@ wxBEGIN_EVENT_TABLE(AnxietyMonitorPlugin,
                                      AnxietyMonitorPlugin::OnMenuEnd)
                                 EVT_MENU(ID_MENU_SHOW_PANEL,
                                          AnxietyMonitorPlugin::OnMenuShowPanel)
+                                    EVT_MENU(ID_MENU_TRACE,
+                                             AnxietyMonitorPlugin::OnMenuTrace)
                                     wxEND_EVENT_TABLE()
 
 // ============================================================================
@@ -111,7 +123,9 @@ AnxietyMonitorPlugin::AnxietyMonitorPlugin()
       m_pauseButtonId(ID_ANXIETY_PAUSE), m_exportButtonId(ID_ANXIETY_EXPORT),
       m_settingsButtonId(ID_ANXIETY_SETTINGS),
       m_updateTimer(this, ID_ANXIETY_TIMER),
-      m_sessionState(SessionState::STOPPED), m_isInitialized(false) {
+      m_drainTimer(this, ID_ANXIETY_DRAIN_TIMER),
+      m_lastRiskLevel(RiskLevel::LOW), m_sessionState(SessionState::STOPPED),
+      m_isInitialized(false) {
   // Set default plugin info (for CB SDK)
   // In real plugin, this uses PluginInfo structure
 }
@@ -135,6 +149,9 @@ void AnxietyMonitorPlugin::OnAttach() {
     RegisterEventHandlers();
     SetupStatusBar();
 
+    // Editor callbacks only enqueue; apply them off the callback stack
+    m_drainTimer.Start(m_settings.eventDrainIntervalMs);
+
     m_isInitialized = true;
 
     wxLogMessage("AnxietyMonitor: Plugin attached successfully.");
@@ -168,14 +185,39 @@ void AnxietyMonitorPlugin::OnRelease(bool appShutDown) {
     }
   }
 
-  // Stop the timer
+  // Stop the timers
   if (m_updateTimer.IsRunning()) {
     m_updateTimer.Stop();
   }
+  if (m_drainTimer.IsRunning()) {
+    m_drainTimer.Stop();
+  }
+
+  // Join the sampler thread before components are destroyed
+  if (m_systemSampler) {
+    m_systemSampler->Stop();
+  }
+
+  // Join the endpoint thread and close scraper connections
+  if (m_metricsEndpoint) {
+    m_metricsEndpoint->Stop();
+  }
+
+  // Detach before the segment goes; the collector publishes on EndSession
+  if (m_liveSegment) {
+    m_dataCollector->SetLiveSegment(nullptr);
+    m_liveSegment->Close();
+  }
 
   // Unregister event handlers
   UnregisterEventHandlers();
 
+  // Keep the trace of this run (tracing is opt-in)
+  if (TraceRecorder::IsEnabled()) {
+    TraceRecorder::SetEnabled(false);
+    DumpTrace();
+  }
+
   // Components will be cleaned up by unique_ptr destructors
   m_isInitialized = false;
 
@@ -203,8 +245,54 @@ void AnxietyMonitorPlugin::InitializeComponents() {
   // Apply default settings
   m_settings = PluginSettings(); // Uses defaults
 
+  m_dataCollector->ApplySettings(m_settings);
+
+  // Machine CPU / IDE memory for the cpu_usage and memory_usage columns
+  m_systemSampler = std::make_unique<SystemSampler>();
+  m_dataCollector->SetSystemSampler(m_systemSampler.get());
+
+  // Live metrics for external tools (shared memory, opt-in)
+  if (m_settings.liveSegmentEnabled) {
+    m_liveSegment = std::make_unique<LiveMetricsSegment>();
+    std::string name = m_settings.liveSegmentName.empty()
+                           ? LiveMetricsSegment::DefaultName()
+                           : m_settings.liveSegmentName;
+    if (m_liveSegment->Create(name)) {
+      if (m_liveSegment->GetName() != name) {
+        wxLogWarning("AnxietyMonitor: %s is in use by another instance; "
+                     "live metrics go to %s",
+                     name.c_str(), m_liveSegment->GetName().c_str());
+      }
+      m_dataCollector->SetLiveSegment(m_liveSegment.get());
+    } else {
+      wxLogWarning("AnxietyMonitor: Live metrics segment unavailable: %s",
+                   m_liveSegment->GetLastError().c_str());
+      m_liveSegment.reset();
+    }
+  }
+
+  // Prometheus / SSE endpoint on localhost or a Unix socket (opt-in)
+  if (m_settings.metricsEndpointEnabled) {
+    m_metricsEndpoint = std::make_unique<MetricsEndpoint>();
+    bool listening = m_settings.metricsEndpointSocket.empty()
+                         ? m_metricsEndpoint->StartTcp(m_settings.metricsEndpointPort)
+                         : m_metricsEndpoint->StartUnix(m_settings.metricsEndpointSocket);
+    if (!listening) {
+      wxLogWarning("AnxietyMonitor: Metrics endpoint unavailable: %s",
+                   m_metricsEndpoint->GetLastError().c_str());
+      m_metricsEndpoint.reset();
+    }
+  }
+
+  // Change-point detection over score / error rate / backspace rate
+  m_shiftDetector = std::make_unique<ShiftDetector>(m_settings);
+
   // Set CSV output directory
   m_csvWriter->SetOutputDirectory(CSVWriter::GetDefaultOutputDirectory());
+  m_csvWriter->SetOverheadColumns(m_settings.csvOverheadColumns);
+  m_csvWriter->SetDigraphColumns(m_settings.csvDigraphColumns);
+
+  TraceRecorder::SetEnabled(m_settings.traceEnabled);
 
   wxLogMessage("AnxietyMonitor: Components initialized. CSV dir: %s",
                CSVWriter::GetDefaultOutputDirectory().c_str());
@@ -333,6 +421,8 @@ void AnxietyMonitorPlugin::BuildMenu(wxMenuBar *menuBar) {
   anxietyMenu->AppendSeparator();
   anxietyMenu->Append(ID_MENU_SHOW_PANEL, "Show &Panel",
                       "Show/hide the anxiety monitor panel");
+  anxietyMenu->Append(ID_MENU_TRACE, "Start/Stop &Trace",
+                      "Record plugin activity; stopping saves a Chrome trace");
 
   // Insert before Help menu (typically last)
   int helpMenuPos = menuBar->FindMenu("Help");
@@ -370,7 +460,8 @@ void AnxietyMonitorPlugin::StartSession() {
 
   // Start CSV file
   if (!m_csvWriter->StartSession(m_currentSessionId)) {
-    wxLogError("AnxietyMonitor: Failed to create session file.");
+    wxLogError("AnxietyMonitor: Failed to create session file. %s",
+               m_csvWriter->GetLastError().c_str());
     wxMessageBox("Failed to create CSV file!\n\nCheck path: " +
                      m_csvWriter->GetDefaultOutputDirectory(),
                  "Error", wxOK | wxICON_ERROR);
@@ -379,14 +470,22 @@ void AnxietyMonitorPlugin::StartSession() {
 
   // Start data collection
   m_dataCollector->StartSession();
+  m_shiftDetector->Reset();
+  m_lastRiskLevel = RiskLevel::LOW;
+  m_systemSampler->Start(m_settings.systemSampleIntervalMs);
 
   // FORCE FLUSH: Write a dummy snapshot or just ensure header is on disk
   m_csvWriter->Flush();
 
-  // Start update timer (30 seconds)
-
-  // Start update timer (30 seconds)
-  m_updateTimer.Start(UPDATE_INTERVAL_MS);
+  // Start sampling timer; display and persist run on their own cadences
+  auto tickStart = std::chrono::steady_clock::now();
+  m_pendingSamples.clear();
+  m_nextDisplayTime =
+      tickStart + std::chrono::milliseconds(m_settings.statusUpdateIntervalMs);
+  m_nextPersistTime =
+      tickStart + std::chrono::milliseconds(m_settings.csvWriteIntervalMs);
+  m_nextLiveDisplayTime = tickStart;
+  m_updateTimer.Start(m_settings.sampleIntervalMs);
 
   m_sessionState = SessionState::RUNNING;
 
@@ -442,8 +541,9 @@ void AnxietyMonitorPlugin::EndSession() {
   // CRITICAL: Force save before ending
   ForceSave();
 
-  // Stop timer
+  // Stop timer and sampler thread
   m_updateTimer.Stop();
+  m_systemSampler->Stop();
 
   // End data collection and CSV
   m_dataCollector->EndSession();
@@ -499,14 +599,20 @@ void AnxietyMonitorPlugin::ExportSession() {
 
 void AnxietyMonitorPlugin::ShowSettings() {
   // Simple settings dialog (keeping it non-intrusive)
-  wxMessageBox("Anxiety Monitor Settings\n\n"
-               "Current Configuration:\n"
-               "- Update interval: 30 seconds\n"
-               "- CSV location: ~/.codeblocks/anxiety_monitor/sessions/\n"
-               "- Popup warnings: Disabled (non-intrusive)\n"
-               "- Sound alerts: Disabled\n\n"
-               "Settings dialog coming in future version.",
-               "Anxiety Monitor Settings", wxOK | wxICON_INFORMATION);
+  std::ostringstream oss;
+  oss << "Anxiety Monitor Settings\n\n"
+      << "Current Configuration:\n"
+      << "- Sample interval: " << m_settings.sampleIntervalMs << " ms\n"
+      << "- Display interval: " << m_settings.statusUpdateIntervalMs << " ms\n"
+      << "- Live display interval: " << m_settings.liveDisplayIntervalMs
+      << " ms (0 = off)\n"
+      << "- CSV write interval: " << m_settings.csvWriteIntervalMs << " ms\n"
+      << "- CSV location: ~/.codeblocks/anxiety_monitor/sessions/\n"
+      << "- Popup warnings: Disabled (non-intrusive)\n"
+      << "- Sound alerts: Disabled\n\n"
+      << "Settings dialog coming in future version.";
+  wxMessageBox(oss.str(), "Anxiety Monitor Settings",
+               wxOK | wxICON_INFORMATION);
 }
 
 // ============================================================================
@@ -532,75 +638,260 @@ double AnxietyMonitorPlugin::GetCurrentScore() const {
 // Timer & Auto-Save
 // ============================================================================
 
+namespace {
+
+// True when a cadence deadline has been reached. Ticks may fire slightly
+// early, so anything within half a sample interval counts as due.
+bool IsDue(std::chrono::steady_clock::time_point &deadline, int intervalMs,
+           int sampleIntervalMs, std::chrono::steady_clock::time_point now) {
+  if (now + std::chrono::milliseconds(sampleIntervalMs / 2) < deadline) {
+    return false;
+  }
+  deadline = now + std::chrono::milliseconds(intervalMs);
+  return true;
+}
+
+} // namespace
+
 void AnxietyMonitorPlugin::OnTimerUpdate(wxTimerEvent &event) {
   (void)event;
+  ANXIETY_PROBE(TIMER_UPDATE);
+  ANXIETY_TRACE("AnxietyMonitorPlugin::OnTimerUpdate");
 
+  if (!m_dataCollector) {
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+
+  // Apply queued editor events (and any trailing paste burst) so they land
+  // in this sample
+  DrainEvents();
+
+  // Sample: one snapshot per tick, scored once, shared by every consumer
+  std::shared_ptr<const MetricsSnapshot> snapshot = CaptureScoredSnapshot();
+
+  // External readers see the same scored sample as the CSV and the panel
+  if (m_liveSegment) {
+    m_dataCollector->PublishLiveSample(*snapshot);
+  }
+
+  // Scrapers read a pre-rendered copy; rendered once per sample
+  if (m_metricsEndpoint) {
+    m_metricsEndpoint->Publish(*snapshot);
+  }
+
+  // Persist: queue the sample, write the batch at the persist cadence
   if (m_sessionState == SessionState::RUNNING) {
-    AutoSaveMetrics();
+    m_pendingSamples.push_back(snapshot);
+    if (IsDue(m_nextPersistTime, m_settings.csvWriteIntervalMs,
+              m_settings.sampleIntervalMs, now)) {
+      AutoSaveMetrics();
+    }
   }
 
-  UpdateStatusBar();
+  // Display: status bar, panel and user-facing analysis
+  if (IsDue(m_nextDisplayTime, m_settings.statusUpdateIntervalMs,
+            m_settings.sampleIntervalMs, now)) {
+    if (m_sessionState == SessionState::RUNNING) {
+      AnalyzeSnapshot(*snapshot);
+    }
+
+    UpdateStatusBar(*snapshot);
 
-  // Update panel if exists
-  if (m_panel && m_dataCollector) {
-    m_panel->UpdateMetrics(m_dataCollector->GetCurrentSnapshot());
+    // Update panel if exists
+    if (m_panel) {
+      m_panel->UpdateMetrics(*snapshot);
+    }
   }
 }
 
-void AnxietyMonitorPlugin::AutoSaveMetrics() {
-  if (!m_dataCollector || !m_csvWriter) {
+void AnxietyMonitorPlugin::OnDrainTimer(wxTimerEvent &event) {
+  (void)event;
+  DrainEvents();
+
+  if (m_settings.liveDisplayIntervalMs > 0 &&
+      m_sessionState == SessionState::RUNNING &&
+      IsDue(m_nextLiveDisplayTime, m_settings.liveDisplayIntervalMs,
+            m_settings.eventDrainIntervalMs,
+            std::chrono::steady_clock::now())) {
+    UpdateLiveDisplay();
+  }
+}
+
+void AnxietyMonitorPlugin::DrainEvents() {
+  ANXIETY_TRACE("AnxietyMonitorPlugin::DrainEvents");
+  if (!m_eventHandlers) {
     return;
   }
+  m_eventHandlers->ProcessPendingEvents();
+
+  // Build results use the parsed log counts, so they agree with the metrics
+  for (const EventHandlers::FinishedBuild &build :
+       m_eventHandlers->GetFinishedBuilds()) {
+    // Once per session: without the saved log only error counts arrive
+    if (build.buildLogDisabled) {
+      wxLogWarning("AnxietyMonitor: The compiler does not save its build "
+                   "log, so only error counts are recorded. Enable \"Save "
+                   "build log to HTML file when finished\" in Settings > "
+                   "Compiler > Other settings for diagnostics.");
+    }
+    if (!m_panel) {
+      continue;
+    }
+    std::string message =
+        build.errors == 0
+            ? std::string("Build succeeded")
+            : "Build failed: " + std::to_string(build.errors) + " error(s)";
+    if (build.warnings > 0) {
+      message += ", " + std::to_string(build.warnings) + " warning(s)";
+    }
+    m_panel->AddEvent(message);
+    if (build.buildLogDisabled) {
+      m_panel->AddEvent("Build diagnostics off: enable \"Save build log to "
+                        "HTML file when finished\" in the compiler settings");
+    }
+  }
+}
 
-  // Get current metrics snapshot
-  MetricsSnapshot snapshot = m_dataCollector->GetCurrentSnapshot();
+void AnxietyMonitorPlugin::UpdateLiveDisplay() {
+  if (!m_dataCollector) {
+    return;
+  }
+
+  // Score is the collector's keystroke-path score; no CSV-only columns
+  MetricsSnapshot snapshot = m_dataCollector->GetCurrentSnapshot(SNAPSHOT_PANEL);
+
+  UpdateStatusBar(snapshot);
+  if (m_panel) {
+    m_panel->UpdateLiveMetrics(snapshot);
+  }
+}
+
+std::shared_ptr<const MetricsSnapshot>
+AnxietyMonitorPlugin::CaptureScoredSnapshot() {
+  auto snapshot =
+      std::make_shared<MetricsSnapshot>(m_dataCollector->GetCurrentSnapshot());
 
   // Calculate and update anxiety score
   if (m_scorer) {
-    snapshot.anxietyScore = m_scorer->CalculateScore(snapshot);
-    RiskLevel level = m_scorer->GetRiskLevel(snapshot.anxietyScore);
-    snapshot.riskLevel = GetRiskLevelLabel(level);
+    ANXIETY_TRACE("AnxietyScorer::CalculateScore");
+    snapshot->anxietyScore = m_scorer->CalculateScore(*snapshot);
+    snapshot->riskLevel =
+        GetRiskLevelLabel(m_scorer->GetRiskLevel(snapshot->anxietyScore));
+  }
 
-    // Check if we should show a warning (respects cooldown, only
-    // HIGH/CRITICAL) But since user wants non-intrusive, this is disabled by
-    // default
-    if (m_settings.showPopupWarnings && m_scorer->ShouldShowWarning(level)) {
+  // Plugin self-overhead so far (panel + optional CSV columns)
+  Instrumentation::GetAllStats(snapshot->overhead);
+
+  m_lastSnapshot = snapshot;
+  return m_lastSnapshot;
+}
+
+void AnxietyMonitorPlugin::AutoSaveMetrics() {
+  if (!m_csvWriter || m_pendingSamples.empty()) {
+    return;
+  }
+
+  // Write the whole batch (single flush for data safety)
+  m_csvWriter->WriteSnapshots(m_pendingSamples);
+  m_pendingSamples.clear();
+}
+
+void AnxietyMonitorPlugin::AnalyzeSnapshot(const MetricsSnapshot &snapshot) {
+  // Check if we should show a warning (respects cooldown, only
+  // HIGH/CRITICAL) But since user wants non-intrusive, this is disabled by
+  // default
+  if (m_scorer && m_settings.showPopupWarnings) {
+    RiskLevel level = m_scorer->GetRiskLevel(snapshot.anxietyScore);
+    if (m_scorer->ShouldShowWarning(level)) {
       std::string recommendation = m_scorer->GetRecommendation(level);
       ShowAnxietyNotification(nullptr, level, recommendation);
     }
   }
 
-  // Write to CSV (auto-flushes immediately for data safety)
-  m_csvWriter->WriteSnapshot(snapshot);
+  if (m_scorer) {
+    RiskLevel level = m_scorer->GetRiskLevel(snapshot.anxietyScore);
+    if (level != m_lastRiskLevel) {
+      if (m_panel) {
+        m_panel->AddEvent(std::string("Risk ") +
+                          GetRiskLevelLabel(m_lastRiskLevel) + " -> " +
+                          GetRiskLevelLabel(level));
+      }
+      m_lastRiskLevel = level;
+    }
+  }
+
+  DetectShifts(snapshot);
+}
+
+void AnxietyMonitorPlugin::DetectShifts(const MetricsSnapshot &snapshot) {
+  if (!m_shiftDetector) {
+    return;
+  }
+
+  m_shiftEvents.clear();
+  if (m_shiftDetector->Update(snapshot, m_shiftEvents) == 0) {
+    return;
+  }
+
+  for (const ShiftEvent &shift : m_shiftEvents) {
+    m_csvWriter->WriteEvent(shift);
+
+    if (m_panel) {
+      std::ostringstream oss;
+      oss << "Shift detected: " << GetShiftMetricLabel(shift.metric)
+          << (shift.direction > 0 ? " up " : " down ") << std::fixed
+          << std::setprecision(1) << shift.baseline << " -> " << shift.value;
+      m_panel->AddEvent(oss.str());
+    }
+
+    wxLogMessage("AnxietyMonitor: Shift detected in %s at %s",
+                 GetShiftMetricLabel(shift.metric), shift.timestamp.c_str());
+  }
 }
 
 void AnxietyMonitorPlugin::ForceSave() {
   // Force immediate write of current state
   if (m_sessionState != SessionState::STOPPED && m_csvWriter &&
       m_dataCollector) {
-    MetricsSnapshot snapshot = m_dataCollector->GetCurrentSnapshot();
-    if (m_scorer) {
-      snapshot.anxietyScore = m_scorer->CalculateScore(snapshot);
-      snapshot.riskLevel =
-          GetRiskLevelLabel(m_scorer->GetRiskLevel(snapshot.anxietyScore));
-    }
-    m_csvWriter->WriteSnapshot(snapshot);
+    DrainEvents();
+    AutoSaveMetrics();
+    m_csvWriter->WriteSnapshot(*CaptureScoredSnapshot());
     m_csvWriter->Flush();
 
     wxLogMessage("AnxietyMonitor: Data force-saved.");
   }
 }
 
+std::string AnxietyMonitorPlugin::DumpTrace() {
+  std::string dir = CSVWriter::GetDefaultOutputDirectory();
+  CSVWriter::EnsureDirectoryExists(dir);
+
+  std::time_t now = std::time(nullptr);
+  std::ostringstream path;
+  path << dir << "/anxiety_trace_"
+       << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S") << ".json";
+
+  if (!TraceRecorder::WriteChromeTraceFile(path.str())) {
+    wxLogError("AnxietyMonitor: Failed to write trace: %s", path.str().c_str());
+    return std::string();
+  }
+
+  wxLogMessage("AnxietyMonitor: Trace written to %s", path.str().c_str());
+  return path.str();
+}
+
 // ============================================================================
 // UI Updates
 // ============================================================================
 
-void AnxietyMonitorPlugin::UpdateStatusBar() {
+void AnxietyMonitorPlugin::UpdateStatusBar(const MetricsSnapshot &snapshot) {
   // Update status bar with current metrics
   // In real CB plugin, we'd use
   // Manager::Get()->GetAppFrame()->SetStatusText()
 
-  if (!m_dataCollector || !m_statusBarManager) {
+  if (!m_statusBarManager) {
     return;
   }
 
@@ -611,7 +902,6 @@ void AnxietyMonitorPlugin::UpdateStatusBar() {
     return;
   }
 
-  MetricsSnapshot snapshot = m_dataCollector->GetCurrentSnapshot();
   std::string statusText = m_statusBarManager->FormatStatusText(snapshot);
 
   // In real plugin:
@@ -714,6 +1004,26 @@ void AnxietyMonitorPlugin::OnMenuEnd(wxCommandEvent &event) {
   EndSession();
 }
 
+void AnxietyMonitorPlugin::OnMenuTrace(wxCommandEvent &event) {
+  (void)event;
+
+  if (!TraceRecorder::IsEnabled()) {
+    // Start a fresh recording
+    TraceRecorder::Clear();
+    TraceRecorder::SetEnabled(true);
+    wxLogMessage("AnxietyMonitor: Trace recording started.");
+    return;
+  }
+
+  TraceRecorder::SetEnabled(false);
+  std::string path = DumpTrace();
+  if (!path.empty()) {
+    wxMessageBox("Trace saved to:\n" + path +
+                     "\n\nOpen it in ui.perfetto.dev or chrome://tracing.",
+                 "Anxiety Monitor", wxOK | wxICON_INFORMATION);
+  }
+}
+
 void AnxietyMonitorPlugin::OnMenuShowPanel(wxCommandEvent &event) {
   (void)event;
 
@@ -12,8 +12,10 @@
 #endif
 
 // Standard includes
+#include <chrono>
 #include <memory>
 #include <string>
+#include <vector>
 
 // Plugin includes
 #include "MetricsData.h"
@@ -26,6 +28,10 @@ class AnxietyScorer;
 class AnxietyPanel;
 class EventHandlers;
 class StatusBarManager;
+class ShiftDetector;
+class SystemSampler;
+class LiveMetricsSegment;
+class MetricsEndpoint;
 } // namespace AnxietyMonitor
 
 /**
@@ -35,7 +41,7 @@ class StatusBarManager;
  * Features:
  * - Real-time monitoring of 12 behavioral metrics
  * - Live anxiety scoring (0-100) with risk levels
- * - Auto-save CSV data every 30 seconds
+ * - Configurable sample / display / persist rates (default 30 seconds)
  * - Auto-save on session stop or plugin exit
  * - Non-intrusive UI (status bar + optional dockable panel)
  * - User-friendly with minimal interruptions
@@ -195,6 +201,7 @@ protected:
   // =========================================================================
 
   void OnTimerUpdate(wxTimerEvent &event);
+  void OnDrainTimer(wxTimerEvent &event);
   void OnStartButton(wxCommandEvent &event);
   void OnPauseButton(wxCommandEvent &event);
   void OnExportButton(wxCommandEvent &event);
@@ -203,6 +210,7 @@ protected:
   void OnMenuPause(wxCommandEvent &event);
   void OnMenuEnd(wxCommandEvent &event);
   void OnMenuShowPanel(wxCommandEvent &event);
+  void OnMenuTrace(wxCommandEvent &event);
 
   // CB SDK Event Handlers (Delegate to EventHandlers class)
 #ifdef CODEBLOCKS_SDK_INCLUDED
@@ -221,7 +229,7 @@ private:
   void RegisterEventHandlers();
   void UnregisterEventHandlers();
   void SetupStatusBar();
-  void UpdateStatusBar();
+  void UpdateStatusBar(const AnxietyMonitor::MetricsSnapshot &snapshot);
   void UpdateUI();
 
   // =========================================================================
@@ -229,17 +237,58 @@ private:
   // =========================================================================
 
   /**
-   * @brief Write current metrics to CSV file.
-   * Called automatically every 30 seconds.
+   * @brief Build and score the snapshot for this tick.
+   * Takes the collector lock once and scores once; every consumer of the
+   * tick (CSV, status bar, panel, shift detection) shares the result.
+   */
+  std::shared_ptr<const AnxietyMonitor::MetricsSnapshot> CaptureScoredSnapshot();
+
+  /**
+   * @brief Apply queued editor events to the collector.
+   * Runs from the drain timer and before every sample, never from an SDK
+   * callback, so callbacks stay lock-free.
+   */
+  void DrainEvents();
+
+  /**
+   * @brief Refresh status bar and panel between samples.
+   * Runs from the drain timer at liveDisplayIntervalMs and asks the
+   * collector only for the displayed fields (SNAPSHOT_PANEL).
+   */
+  void UpdateLiveDisplay();
+
+  /**
+   * @brief Write all pending samples to the CSV file as one batch.
+   * Called at the persist interval (csvWriteIntervalMs).
    */
   void AutoSaveMetrics();
 
+  /**
+   * @brief User-facing analysis of a displayed snapshot.
+   * Popup warnings (if enabled) and shift detection; runs at the display
+   * interval so detection thresholds keep their meaning at any sample rate.
+   */
+  void AnalyzeSnapshot(const AnxietyMonitor::MetricsSnapshot &snapshot);
+
   /**
    * @brief Force save all pending data immediately.
    * Called on pause, stop, or exit.
    */
   void ForceSave();
 
+  /**
+   * @brief Run change-point detection on a scored snapshot.
+   * Detected shifts go to the panel's event log and the CSV event stream.
+   */
+  void DetectShifts(const AnxietyMonitor::MetricsSnapshot &snapshot);
+
+  /**
+   * @brief Write recorded trace spans to anxiety_trace_YYYYMMDD_HHMMSS.json
+   * in the output directory.
+   * @return Path written, or empty on failure
+   */
+  std::string DumpTrace();
+
   // =========================================================================
   // UI State Management
   // =========================================================================
@@ -253,6 +302,16 @@ private:
   std::unique_ptr<AnxietyMonitor::AnxietyScorer> m_scorer;
   std::unique_ptr<AnxietyMonitor::EventHandlers> m_eventHandlers;
   std::unique_ptr<AnxietyMonitor::StatusBarManager> m_statusBarManager;
+  std::unique_ptr<AnxietyMonitor::ShiftDetector> m_shiftDetector;
+  std::unique_ptr<AnxietyMonitor::SystemSampler> m_systemSampler;
+  std::unique_ptr<AnxietyMonitor::LiveMetricsSegment> m_liveSegment; // Null unless enabled
+  std::unique_ptr<AnxietyMonitor::MetricsEndpoint> m_metricsEndpoint; // Null unless enabled
+
+  // Most recent scored snapshot (immutable, shared with consumers)
+  std::shared_ptr<const AnxietyMonitor::MetricsSnapshot> m_lastSnapshot;
+
+  // Reused per tick so detection does not allocate in steady state
+  std::vector<AnxietyMonitor::ShiftEvent> m_shiftEvents;
 
   // UI components
   AnxietyMonitor::AnxietyPanel *m_panel; // Owned by wxWidgets
@@ -264,9 +323,23 @@ private:
   int m_exportButtonId;
   int m_settingsButtonId;
 
-  // Timer for periodic updates (30 seconds)
+  // Sampling timer (fires every sampleIntervalMs)
   wxTimer m_updateTimer;
-  static const int UPDATE_INTERVAL_MS = 30000; // 30 seconds
+
+  // Applies queued editor events (fires every eventDrainIntervalMs)
+  wxTimer m_drainTimer;
+
+  // Display and persist cadences, derived from the sampling timer
+  std::chrono::steady_clock::time_point m_nextDisplayTime;
+  std::chrono::steady_clock::time_point m_nextPersistTime;
+  std::chrono::steady_clock::time_point m_nextLiveDisplayTime;
+
+  // Samples captured since the last CSV batch write
+  std::vector<std::shared_ptr<const AnxietyMonitor::MetricsSnapshot>>
+      m_pendingSamples;
+
+  // Risk level of the last analysed sample (transitions go to the events log)
+  AnxietyMonitor::RiskLevel m_lastRiskLevel;
 
   // Session state
   AnxietyMonitor::SessionState m_sessionState;
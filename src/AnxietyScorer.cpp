@@ -141,7 +141,7 @@ double AnxietyScorer::CalculateScore(const MetricsSnapshot& metrics) const
     return std::max(0.0, std::min(100.0, score));
 }
 
-RiskLevel AnxietyScorer::GetRiskLevel(double score) const
+RiskLevel AnxietyScorer::GetRiskLevel(double score)
 {
     if (score <= 30.0) {
         return RiskLevel::LOW;
@@ -155,6 +155,11 @@ RiskLevel AnxietyScorer::GetRiskLevel(double score) const
 }
 
 std::string AnxietyScorer::GetRecommendation(RiskLevel level) const
+{
+    return GetRecommendationText(level);
+}
+
+const char* AnxietyScorer::GetRecommendationText(RiskLevel level)
 {
     switch (level) {
         case RiskLevel::LOW:
@@ -35,7 +35,7 @@ public:
      * @param score Anxiety score (0-100)
      * @return RiskLevel enum value
      */
-    RiskLevel GetRiskLevel(double score) const;
+    static RiskLevel GetRiskLevel(double score);
     
     /**
      * @brief Get recommendation message for a risk level.
@@ -44,6 +44,11 @@ public:
      */
     std::string GetRecommendation(RiskLevel level) const;
     
+    /**
+     * @brief Recommendation text without a scorer instance (UI labels).
+     */
+    static const char* GetRecommendationText(RiskLevel level);
+    
     /**
      * @brief Check if warning should be shown (respects cooldown).
      * @param level Current risk level
@@ -0,0 +1,106 @@
+#include "BurstFilter.h"
+#include "DigraphMatrix.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace AnxietyMonitor {
+
+KeystrokeBurstFilter::KeystrokeBurstFilter(CollectorEventQueue* queue,
+                                           const PluginSettings& settings)
+    : m_queue(queue)
+    , m_burstGapUs(settings.burstGapMs * 1000LL)
+    , m_repeatJitterUs(settings.repeatJitterMs * 1000LL)
+    , m_repeatMaxIntervalUs(settings.repeatMaxIntervalMs * 1000LL)
+    , m_repeatMinStreak(settings.repeatMinStreak)
+    , m_burstMinChars(std::max(2, std::min(settings.burstMinChars, MAX_HELD_CHARS + 1)))
+    , m_hasLast(false)
+    , m_lastCharCode(0)
+    , m_lastGapUs(0)
+    , m_repeatStreak(0)
+    , m_pendingChars(0)
+{
+}
+
+void KeystrokeBurstFilter::OnChar(int charCode, bool isBackspace, TimePoint when)
+{
+    long long gapUs = m_hasLast ?
+        std::chrono::duration_cast<std::chrono::microseconds>(when - m_lastTime).count() :
+        m_repeatMaxIntervalUs + m_burstGapUs + 1;
+    
+    // Auto-repeat: same key at a steady, short interval
+    bool steadyRepeat = m_hasLast && charCode == m_lastCharCode &&
+        gapUs <= m_repeatMaxIntervalUs &&
+        std::abs(gapUs - m_lastGapUs) <= m_repeatJitterUs;
+    m_repeatStreak = steadyRepeat ? m_repeatStreak + 1 : 0;
+    
+    // Deletions are never folded into a bulk insert: a held backspace is
+    // forwarded key by key so it still counts towards the backspace rate
+    bool inBurst = !isBackspace &&
+        (gapUs <= m_burstGapUs || m_repeatStreak >= m_repeatMinStreak);
+    
+    m_hasLast = true;
+    m_lastTime = when;
+    m_lastCharCode = charCode;
+    m_lastGapUs = gapUs;
+    
+    if (inBurst) {
+        if (m_pendingChars < MAX_HELD_CHARS) {
+            m_held[m_pendingChars].when = when;
+            m_held[m_pendingChars].charCode = charCode;
+        }
+        ++m_pendingChars;
+        return;
+    }
+    
+    CloseBurst();
+    Forward(charCode, isBackspace, when);
+}
+
+void KeystrokeBurstFilter::Flush(TimePoint now)
+{
+    if (m_pendingChars == 0) return;
+    
+    auto idleUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        now - m_lastTime).count();
+    if (idleUs > std::max(m_burstGapUs, m_repeatMaxIntervalUs)) {
+        CloseBurst();
+        m_repeatStreak = 0;
+    }
+}
+
+void KeystrokeBurstFilter::CloseBurst()
+{
+    if (m_pendingChars == 0) return;
+    
+    if (m_pendingChars >= m_burstMinChars) {
+        if (m_queue) {
+            CollectorEvent event;
+            event.type = CollectorEventType::BULK_INSERT;
+            event.when = m_lastTime;
+            event.count = m_pendingChars;
+            m_queue->TryPush(std::move(event));
+        }
+    } else {
+        // Short burst: genuine fast typing, replay faithfully
+        for (int i = 0; i < m_pendingChars; ++i) {
+            Forward(m_held[i].charCode, false, m_held[i].when);
+        }
+    }
+    
+    m_pendingChars = 0;
+}
+
+void KeystrokeBurstFilter::Forward(int charCode, bool isBackspace, TimePoint when)
+{
+    if (m_queue) {
+        CollectorEvent event;
+        event.type = CollectorEventType::KEYSTROKE;
+        event.when = when;
+        event.flag = isBackspace;
+        event.count = static_cast<int>(isBackspace ? KeyClass::BACKSPACE
+                                                   : DigraphMatrix::Classify(charCode));
+        m_queue->TryPush(std::move(event));
+    }
+}
+
+} // namespace AnxietyMonitor
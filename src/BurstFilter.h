@@ -0,0 +1,92 @@
+#ifndef BURST_FILTER_H
+#define BURST_FILTER_H
+
+#include <chrono>
+#include "MetricsData.h"
+#include "EventQueue.h"
+
+namespace AnxietyMonitor {
+
+/**
+ * @class KeystrokeBurstFilter
+ * @brief Ingestion filter that coalesces paste floods and key auto-repeat.
+ *
+ * Characters arriving within burstGapMs of each other, or as a steady
+ * same-key auto-repeat stream, are held instead of being forwarded one by
+ * one. When the burst ends:
+ * - bursts of at least burstMinChars become a single bulk-insert event;
+ * - shorter bursts are replayed as ordinary keystrokes with their original
+ *   timestamps, so fast genuine typing is not lost.
+ *
+ * Backspaces are never held: they end any open burst and are forwarded as
+ * keystrokes, so a held-down backspace is counted as deletions rather than
+ * as a bulk insert.
+ *
+ * Forwarded keystrokes carry their key class (DigraphMatrix::Classify) for
+ * digraph timing.
+ *
+ * Output goes to the collector's event queue. Inside a burst each character
+ * costs one compare and an increment - no queue push, no allocation.
+ */
+class KeystrokeBurstFilter {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+    
+    explicit KeystrokeBurstFilter(CollectorEventQueue* queue,
+                                  const PluginSettings& settings = PluginSettings());
+    
+    /**
+     * @brief Feed one character event.
+     * @param charCode Character code from the editor event
+     * @param isBackspace true for backspace/delete
+     * @param when Time the event was received
+     */
+    void OnChar(int charCode, bool isBackspace, TimePoint when);
+    
+    /**
+     * @brief Close a pending burst if no character arrived recently.
+     * Called periodically (timer tick) so a trailing paste is not held.
+     */
+    void Flush(TimePoint now);
+    
+    /**
+     * @brief Number of characters currently held in an open burst.
+     */
+    int GetPendingChars() const { return m_pendingChars; }
+
+private:
+    void CloseBurst();
+    void Forward(int charCode, bool isBackspace, TimePoint when);
+
+private:
+    // Held characters are replayed individually if the burst stays short
+    static const int MAX_HELD_CHARS = 16;
+    struct HeldChar {
+        TimePoint when;
+        int charCode;
+    };
+    
+    CollectorEventQueue* m_queue;
+    
+    // Thresholds (microseconds)
+    long long m_burstGapUs;
+    long long m_repeatJitterUs;
+    long long m_repeatMaxIntervalUs;
+    int m_repeatMinStreak;
+    int m_burstMinChars;
+    
+    // Stream state
+    bool m_hasLast;
+    TimePoint m_lastTime;
+    int m_lastCharCode;
+    long long m_lastGapUs;
+    int m_repeatStreak;
+    
+    // Open burst
+    int m_pendingChars;
+    HeldChar m_held[MAX_HELD_CHARS];
+};
+
+} // namespace AnxietyMonitor
+
+#endif // BURST_FILTER_H
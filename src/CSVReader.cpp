@@ -0,0 +1,315 @@
+#include "CSVReader.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace AnxietyMonitor {
+
+// ============================================================================
+// Column Table
+// ============================================================================
+
+namespace {
+
+double ToDouble(const std::string& value)
+{
+    return value.empty() ? 0.0 : std::strtod(value.c_str(), nullptr);
+}
+
+long ToLong(const std::string& value)
+{
+    return value.empty() ? 0L : std::strtol(value.c_str(), nullptr, 10);
+}
+
+struct Column {
+    const char* name;
+    void (*apply)(MetricsSnapshot& s, const std::string& v);
+};
+
+// Keep in sync with CSVWriter::CSV_HEADERS
+const Column COLUMNS[] = {
+    {"timestamp",             [](MetricsSnapshot& s, const std::string& v) { s.timestamp = v; }},
+    {"session_id",            [](MetricsSnapshot& s, const std::string& v) { s.sessionId = v; }},
+    {"project_name",          [](MetricsSnapshot& s, const std::string& v) { s.projectName = v; }},
+    {"file_path",             [](MetricsSnapshot& s, const std::string& v) { s.filePath = v; }},
+    {"language",              [](MetricsSnapshot& s, const std::string& v) { s.language = v; }},
+    {"typing_speed_wpm",      [](MetricsSnapshot& s, const std::string& v) { s.typingSpeedWpm = ToDouble(v); }},
+    {"latency_variance_ms",   [](MetricsSnapshot& s, const std::string& v) { s.latencyVarianceMs = ToDouble(v); }},
+    {"error_freq_permin",     [](MetricsSnapshot& s, const std::string& v) { s.errorFreqPerMin = ToDouble(v); }},
+    {"pause_ratio",           [](MetricsSnapshot& s, const std::string& v) { s.pauseRatio = ToDouble(v); }},
+    {"error_resolution_time", [](MetricsSnapshot& s, const std::string& v) { s.errorResolutionTime = ToDouble(v); }},
+    {"backspace_rate",        [](MetricsSnapshot& s, const std::string& v) { s.backspaceRate = ToDouble(v); }},
+    {"consecutive_errors",    [](MetricsSnapshot& s, const std::string& v) { s.consecutiveErrors = static_cast<int>(ToLong(v)); }},
+    {"undo_redo_count",       [](MetricsSnapshot& s, const std::string& v) { s.undoRedoCount = static_cast<int>(ToLong(v)); }},
+    {"idle_ratio",            [](MetricsSnapshot& s, const std::string& v) { s.idleRatio = ToDouble(v); }},
+    {"focus_switches",        [](MetricsSnapshot& s, const std::string& v) { s.focusSwitches = ToDouble(v); }},
+    {"compile_success_rate",  [](MetricsSnapshot& s, const std::string& v) { s.compileSuccessRate = ToDouble(v); }},
+    {"session_fragmentation", [](MetricsSnapshot& s, const std::string& v) { s.sessionFragmentation = ToDouble(v); }},
+    {"anxiety_score",         [](MetricsSnapshot& s, const std::string& v) { s.anxietyScore = ToDouble(v); }},
+    {"risk_level",            [](MetricsSnapshot& s, const std::string& v) { s.riskLevel = v; }},
+    {"timestamp_batch",       [](MetricsSnapshot& s, const std::string& v) { s.timestampBatch = v; }},
+    {"cpu_usage",             [](MetricsSnapshot& s, const std::string& v) { s.cpuUsage = ToDouble(v); }},
+    {"memory_usage",          [](MetricsSnapshot& s, const std::string& v) { s.memoryUsage = ToDouble(v); }},
+    {"window_focused",        [](MetricsSnapshot& s, const std::string& v) { s.windowFocused = (v == "true" || v == "1"); }},
+    {"keystrokes_total",      [](MetricsSnapshot& s, const std::string& v) { s.keystrokesTotal = ToLong(v); }},
+    {"compile_attempts",      [](MetricsSnapshot& s, const std::string& v) { s.compileAttempts = static_cast<int>(ToLong(v)); }},
+    {"error_count_total",     [](MetricsSnapshot& s, const std::string& v) { s.errorCountTotal = static_cast<int>(ToLong(v)); }},
+    {"bulk_inserts",          [](MetricsSnapshot& s, const std::string& v) { s.bulkInserts = static_cast<int>(ToLong(v)); }},
+    {"bulk_insert_chars",     [](MetricsSnapshot& s, const std::string& v) { s.bulkInsertChars = ToLong(v); }},
+};
+
+const int COLUMN_COUNT = static_cast<int>(sizeof(COLUMNS) / sizeof(COLUMNS[0]));
+
+// Optional overhead columns: overhead_<site>_{p50,p99,max}_ns, encoded
+// after the fixed columns as COLUMN_COUNT + site * 3 + stat
+const char* const OVERHEAD_STATS[] = {"_p50_ns", "_p99_ns", "_max_ns"};
+
+// Optional digraph columns: digraph<rank>_{pair,delta_ms,z}, encoded after
+// the overhead columns as DIGRAPH_BASE + (rank - 1) * 3 + stat
+const int DIGRAPH_BASE = COLUMN_COUNT + static_cast<int>(PROBE_SITE_COUNT) * 3;
+const char* const DIGRAPH_STATS[] = {"_pair", "_delta_ms", "_z"};
+
+KeyClass ParseKeyClass(const std::string& label)
+{
+    for (size_t i = 1; i < KEY_CLASS_COUNT; ++i) {
+        if (label == GetKeyClassLabel(static_cast<KeyClass>(i))) return static_cast<KeyClass>(i);
+    }
+    return KeyClass::UNKNOWN;
+}
+
+int FindColumn(const std::string& name)
+{
+    for (int i = 0; i < COLUMN_COUNT; ++i) {
+        if (name == COLUMNS[i].name) return i;
+    }
+    for (size_t site = 0; site < PROBE_SITE_COUNT; ++site) {
+        std::string prefix = std::string("overhead_") +
+                             GetProbeSiteLabel(static_cast<ProbeSite>(site));
+        for (int stat = 0; stat < 3; ++stat) {
+            if (name == prefix + OVERHEAD_STATS[stat]) {
+                return COLUMN_COUNT + static_cast<int>(site) * 3 + stat;
+            }
+        }
+    }
+    for (size_t rank = 0; rank < DIGRAPH_TOP_N; ++rank) {
+        std::string prefix = "digraph" + std::to_string(rank + 1);
+        for (int stat = 0; stat < 3; ++stat) {
+            if (name == prefix + DIGRAPH_STATS[stat]) {
+                return DIGRAPH_BASE + static_cast<int>(rank) * 3 + stat;
+            }
+        }
+    }
+    return -1;
+}
+
+void ApplyColumn(int target, MetricsSnapshot& snapshot, const std::string& value)
+{
+    if (target < COLUMN_COUNT) {
+        COLUMNS[target].apply(snapshot, value);
+        return;
+    }
+    if (target >= DIGRAPH_BASE) {
+        DigraphDeviation& digraph = snapshot.digraphs[(target - DIGRAPH_BASE) / 3];
+        switch ((target - DIGRAPH_BASE) % 3) {
+            case 0: {
+                // "first>second"; empty for an unused rank
+                size_t arrow = value.find('>');
+                if (arrow != std::string::npos) {
+                    digraph.first = ParseKeyClass(value.substr(0, arrow));
+                    digraph.second = ParseKeyClass(value.substr(arrow + 1));
+                }
+                break;
+            }
+            case 1:  digraph.deltaMs = ToDouble(value); break;
+            default: digraph.zScore = ToDouble(value); break;
+        }
+        return;
+    }
+    OverheadStats& stats = snapshot.overhead[(target - COLUMN_COUNT) / 3];
+    switch ((target - COLUMN_COUNT) % 3) {
+        case 0:  stats.p50Ns = ToDouble(value); break;
+        case 1:  stats.p99Ns = ToDouble(value); break;
+        default: stats.maxNs = ToDouble(value); break;
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// CSVReader
+// ============================================================================
+
+CSVReader::CSVReader()
+    : m_rowsRead(0)
+{
+}
+
+bool CSVReader::Open(const std::string& path)
+{
+    Close();
+    m_lastError.clear();
+
+    m_file.open(path, std::ios::in | std::ios::binary);
+    if (!m_file.is_open()) {
+        m_lastError = "Failed to open " + path;
+        return false;
+    }
+
+    std::vector<std::string> header;
+    if (!ReadRecord(m_file, header)) {
+        m_lastError = "Empty file: " + path;
+        Close();
+        return false;
+    }
+
+    if (!SetHeader(header)) {
+        m_lastError = "Not an anxiety session CSV (no anxiety_score column): " + path;
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool CSVReader::SetHeader(const std::vector<std::string>& header)
+{
+    m_header = header;
+
+    // Tolerate a UTF-8 byte order mark (files re-saved by spreadsheets)
+    if (!m_header.empty() && m_header[0].compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        m_header[0].erase(0, 3);
+    }
+
+    m_columnTargets.clear();
+    for (const std::string& name : m_header) {
+        m_columnTargets.push_back(FindColumn(name));
+    }
+    m_rowsRead = 0;
+    return HasColumn("anxiety_score");
+}
+
+bool CSVReader::ParseRow(const std::vector<std::string>& fields, MetricsSnapshot& snapshot) const
+{
+    // Skip blank lines (e.g. a trailing newline)
+    if (fields.empty() || (fields.size() == 1 && fields[0].empty())) {
+        return false;
+    }
+
+    snapshot = MetricsSnapshot();
+    size_t count = std::min(fields.size(), m_columnTargets.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (m_columnTargets[i] >= 0) {
+            ApplyColumn(m_columnTargets[i], snapshot, fields[i]);
+        }
+    }
+    return true;
+}
+
+bool CSVReader::ReadNext(MetricsSnapshot& snapshot)
+{
+    if (!m_file.is_open()) {
+        return false;
+    }
+
+    while (ReadRecord(m_file, m_fields)) {
+        if (ParseRow(m_fields, snapshot)) {
+            ++m_rowsRead;
+            return true;
+        }
+    }
+    return false;
+}
+
+void CSVReader::Close()
+{
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+    m_file.clear();
+    m_header.clear();
+    m_columnTargets.clear();
+    m_rowsRead = 0;
+}
+
+bool CSVReader::HasColumn(const std::string& name) const
+{
+    return std::find(m_header.begin(), m_header.end(), name) != m_header.end();
+}
+
+bool CSVReader::ReadSession(const std::string& path, std::vector<MetricsSnapshot>& snapshots,
+                            std::string* error)
+{
+    CSVReader reader;
+    if (!reader.Open(path)) {
+        if (error) *error = reader.GetLastError();
+        return false;
+    }
+
+    MetricsSnapshot snapshot;
+    while (reader.ReadNext(snapshot)) {
+        snapshots.push_back(snapshot);
+    }
+    return true;
+}
+
+bool CSVReader::ReadRecord(std::istream& in, std::vector<std::string>& fields)
+{
+    fields.clear();
+    if (in.peek() == std::char_traits<char>::eof()) {
+        return false;
+    }
+
+    // Whole lines until ParseRecord() sees the record end outside quotes
+    std::string record;
+    std::string line;
+    while (std::getline(in, line)) {
+        record += line;
+        if (!in.eof()) record += '\n';     // getline drops it; the last line may have none
+        if (ParseRecord(record.data(), record.size(), fields) > 0) {
+            return true;
+        }
+    }
+    // Last line without a newline, or an unterminated quote: keep what was read
+    ParseRecord(record.data(), record.size(), fields, true);
+    return true;
+}
+
+size_t CSVReader::ParseRecord(const char* data, size_t length, std::vector<std::string>& fields,
+                              bool endOfInput)
+{
+    fields.clear();
+    std::string field;
+    bool quoted = false;
+    for (size_t i = 0; i < length; ++i) {
+        char c = data[i];
+        if (quoted) {
+            if (c == '"') {
+                if (i + 1 == length && !endOfInput) return 0;   // Escaped quote or end: undecided
+                if (i + 1 < length && data[i + 1] == '"') {
+                    ++i;
+                    field += '"';
+                } else {
+                    quoted = false;
+                }
+            } else {
+                field += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.push_back(field);
+            field.clear();
+        } else if (c == '\n') {
+            fields.push_back(field);
+            return i + 1;
+        } else if (c != '\r') {
+            field += c;
+        }
+    }
+    if (endOfInput && length > 0) {
+        fields.push_back(field);
+        return length;
+    }
+    fields.clear();
+    return 0;
+}
+
+} // namespace AnxietyMonitor
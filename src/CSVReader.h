@@ -0,0 +1,109 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+#include "MetricsData.h"
+
+namespace AnxietyMonitor {
+
+/**
+ * @class CSVReader
+ * @brief Reads session CSV files written by CSVWriter back into snapshots.
+ *
+ * Columns are matched by header name, so files from older releases (fewer
+ * columns) and files with the optional overhead columns both load; unknown
+ * columns are skipped and missing ones read as zero. Rows are streamed one
+ * at a time, so large sessions do not have to fit in memory.
+ */
+class CSVReader {
+public:
+    CSVReader();
+
+    /**
+     * @brief Open a session file and read its header row.
+     * @param path Session CSV path
+     * @return false if the file cannot be opened or is not a session CSV
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Read the next data row.
+     * @param snapshot Overwritten with the row's values
+     * @return false at end of file
+     */
+    bool ReadNext(MetricsSnapshot& snapshot);
+
+    void Close();
+
+    /**
+     * @brief Check whether the open file has a column.
+     */
+    bool HasColumn(const std::string& name) const;
+
+    /**
+     * @brief Map columns from a header record without opening a file
+     * (rows read by other means, e.g. SessionTailFollower).
+     * @return false if it is not a session CSV header
+     */
+    bool SetHeader(const std::vector<std::string>& header);
+
+    /**
+     * @brief Convert one data record using the current header.
+     * @return false for a blank record
+     */
+    bool ParseRow(const std::vector<std::string>& fields, MetricsSnapshot& snapshot) const;
+
+    /**
+     * @brief Get the number of data rows read so far.
+     */
+    size_t GetRowsRead() const { return m_rowsRead; }
+
+    /**
+     * @brief Reason the last Open() failed.
+     */
+    const std::string& GetLastError() const { return m_lastError; }
+
+    /**
+     * @brief Read a whole session file.
+     * @param path Session CSV path
+     * @param snapshots Receives one snapshot per row
+     * @param error Receives the reason on failure (optional)
+     * @return false if the file could not be read
+     */
+    static bool ReadSession(const std::string& path, std::vector<MetricsSnapshot>& snapshots,
+                            std::string* error = nullptr);
+
+    /**
+     * @brief Read one CSV record from a stream (ParseRecord() over the
+     * record's lines).
+     * @return false at end of input
+     */
+    static bool ReadRecord(std::istream& in, std::vector<std::string>& fields);
+
+    /**
+     * @brief Split the first record of a buffer into fields (RFC 4180
+     * quoting; a quoted field may span lines).
+     * @param endOfInput No more data follows: the buffer end also ends
+     * the record (an unterminated last line or quote)
+     * @return Bytes consumed, or 0 if the record is not complete yet (no
+     * newline outside quotes)
+     */
+    static size_t ParseRecord(const char* data, size_t length, std::vector<std::string>& fields,
+                              bool endOfInput = false);
+
+private:
+    // Index into the column table, or -1 for unknown columns
+    std::vector<int> m_columnTargets;
+    std::vector<std::string> m_header;
+    std::vector<std::string> m_fields;
+    std::ifstream m_file;
+    size_t m_rowsRead;
+    std::string m_lastError;
+};
+
+} // namespace AnxietyMonitor
+
+#endif // CSV_READER_H
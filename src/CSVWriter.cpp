@@ -1,19 +1,18 @@
 #include "CSVWriter.h"
+#include "Instrumentation.h"
+#include "TraceRecorder.h"
 #include <chrono>
 #include <ctime>
+#include <filesystem>
 #include <iomanip>
 #include <sstream>
-
-// Use wxWidgets filesystem classes for robustness
-#include <wx/dir.h>
-#include <wx/file.h>
-#include <wx/filename.h>
-#include <wx/log.h>
-#include <wx/stdpaths.h>
+#include <system_error>
 
 namespace AnxietyMonitor {
 
-// CSV column headers (24 columns as specified)
+// Fixed CSV column headers (28 columns). Optional columns follow them:
+// 3 per probe site (SetOverheadColumns), then 3 per digraph rank
+// (SetDigraphColumns)
 const std::vector<std::string> CSVWriter::CSV_HEADERS = {
     "timestamp",
     "session_id",
@@ -40,9 +39,17 @@ const std::vector<std::string> CSVWriter::CSV_HEADERS = {
     "window_focused",
     "keystrokes_total",
     "compile_attempts",
-    "error_count_total"};
+    "error_count_total",
+    "bulk_inserts",
+    "bulk_insert_chars"};
+
+// Change-point event stream columns
+const std::vector<std::string> CSVWriter::EVENT_HEADERS = {
+    "timestamp", "session_id", "metric", "direction", "value", "baseline"};
 
-CSVWriter::CSVWriter() : m_isSessionActive(false), m_rowsWritten(0) {
+CSVWriter::CSVWriter()
+    : m_isSessionActive(false), m_rowsWritten(0), m_overheadColumns(false),
+      m_digraphColumns(false) {
   m_outputDirectory = GetDefaultOutputDirectory();
 }
 
@@ -74,19 +81,24 @@ std::string CSVWriter::GetDefaultOutputDirectory() {
   return path + "/Datasets";
 }
 
-bool CSVWriter::EnsureDirectoryExists(const std::string &path) {
-  wxString wxPath(path);
-
-  // wxFileName::Mkdir with wxPATH_MKDIR_FULL creates all intermediate
-  // directories recursively, handling platform-specific separators and Unicode
-  // correctly.
-  if (!wxFileName::DirExists(wxPath)) {
-    if (!wxFileName::Mkdir(wxPath, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
-      // Log failure
-      wxLogMessage("AnxietyMonitor: Failed to create directory: %s", wxPath);
-      wxLogError("AnxietyMonitor: Failed to create directory: %s", wxPath);
-      return false;
+bool CSVWriter::EnsureDirectoryExists(const std::string &path,
+                                      std::string *error) {
+  // create_directories builds every missing parent and is a no-op for an
+  // existing directory. The narrow string is read in the native encoding
+  // (the ANSI code page on Windows, not UTF-8), the same way the CSV
+  // streams open their files, so both resolve to the same directory.
+  std::error_code ec;
+  std::filesystem::path dir(path);
+  if (std::filesystem::is_directory(dir, ec)) {
+    return true;
+  }
+  std::filesystem::create_directories(dir, ec);
+  if (ec || !std::filesystem::is_directory(dir, ec)) {
+    if (error) {
+      *error = "Failed to create directory " + path +
+               (ec ? ": " + ec.message() : std::string());
     }
+    return false;
   }
   return true;
 }
@@ -133,36 +145,49 @@ std::string CSVWriter::EscapeCSV(const std::string &value) {
 }
 
 bool CSVWriter::StartSession(const std::string &sessionId) {
+  // Generate filename: anxiety_session_YYYYMMDD_HHMMSS.csv
+  std::string timestamp = GenerateTimestamp();
+  return OpenSession(sessionId, "anxiety_session_" + timestamp + ".csv",
+                     timestamp);
+}
+
+bool CSVWriter::StartSession(const std::string &sessionId,
+                             const std::string &fileName) {
+  return OpenSession(sessionId, fileName, GenerateTimestamp());
+}
+
+bool CSVWriter::OpenSession(const std::string &sessionId,
+                            const std::string &fileName,
+                            const std::string &fileTimestamp) {
   std::lock_guard<std::mutex> lock(m_mutex);
 
-  // Close any existing session
+  m_lastError.clear();
+
+  // Close any existing session (already holding m_mutex, so no Flush())
   if (m_isSessionActive) {
-    Flush();
+    m_file.flush();
     m_file.close();
   }
 
   // Ensure output directory exists
-  if (!EnsureDirectoryExists(m_outputDirectory)) {
+  if (!EnsureDirectoryExists(m_outputDirectory, &m_lastError)) {
     return false;
   }
 
-  // Generate filename: anxiety_session_YYYYMMDD_HHMMSS.csv
-  std::string filename = "anxiety_session_" + GenerateTimestamp() + ".csv";
-
-#ifdef _WIN32
-  std::string filePath = m_outputDirectory;
-  for (char &c : filePath) {
-    if (c == '/')
-      c = '\\';
+  // Any event stream belongs to the previous session
+  if (m_eventFile.is_open()) {
+    m_eventFile.close();
   }
-  m_currentFilePath = filePath + "\\" + filename;
-#else
-  m_currentFilePath = m_outputDirectory + "/" + filename;
-#endif
+  m_eventFilePath.clear();
+
+  // The event stream shares the session's timestamp
+  m_fileTimestamp = fileTimestamp;
+  m_currentFilePath = MakeOutputPath(fileName);
 
   // Open file for writing
   m_file.open(m_currentFilePath, std::ios::out | std::ios::trunc);
   if (!m_file.is_open()) {
+    m_lastError = "Failed to open " + m_currentFilePath;
     return false;
   }
 
@@ -176,6 +201,19 @@ bool CSVWriter::StartSession(const std::string &sessionId) {
   return true;
 }
 
+std::string CSVWriter::MakeOutputPath(const std::string &filename) const {
+#ifdef _WIN32
+  std::string filePath = m_outputDirectory;
+  for (char &c : filePath) {
+    if (c == '/')
+      c = '\\';
+  }
+  return filePath + "\\" + filename;
+#else
+  return m_outputDirectory + "/" + filename;
+#endif
+}
+
 void CSVWriter::WriteHeader() {
   if (!m_file.is_open())
     return;
@@ -185,19 +223,69 @@ void CSVWriter::WriteHeader() {
       m_file << ",";
     m_file << CSV_HEADERS[i];
   }
+
+  // Optional plugin self-overhead columns, three per probe site
+  if (m_overheadColumns) {
+    for (size_t i = 0; i < PROBE_SITE_COUNT; ++i) {
+      std::string prefix = std::string(",overhead_") +
+                           GetProbeSiteLabel(static_cast<ProbeSite>(i));
+      m_file << prefix << "_p50_ns" << prefix << "_p99_ns" << prefix
+             << "_max_ns";
+    }
+  }
+
+  // Optional digraph deviation columns, three per rank
+  if (m_digraphColumns) {
+    for (size_t rank = 1; rank <= DIGRAPH_TOP_N; ++rank) {
+      std::string prefix = ",digraph" + std::to_string(rank);
+      m_file << prefix << "_pair" << prefix << "_delta_ms" << prefix << "_z";
+    }
+  }
   m_file << "\n";
   m_file.flush(); // Immediate flush for header
 }
 
 bool CSVWriter::WriteSnapshot(const MetricsSnapshot &snapshot) {
+  ANXIETY_PROBE(WRITE_SNAPSHOT);
+  ANXIETY_TRACE("CSVWriter::WriteSnapshot");
   std::lock_guard<std::mutex> lock(m_mutex);
 
   if (!m_isSessionActive || !m_file.is_open()) {
     return false;
   }
 
-  // Write all 24 columns (with additional error_count_total = 26 total per
-  // spec)
+  WriteRow(snapshot);
+
+  // Flush immediately for data safety (auto-save behavior)
+  m_file.flush();
+
+  ++m_rowsWritten;
+  return true;
+}
+
+bool CSVWriter::WriteSnapshots(
+    const std::vector<std::shared_ptr<const MetricsSnapshot>> &snapshots) {
+  ANXIETY_PROBE(WRITE_SNAPSHOT);
+  ANXIETY_TRACE("CSVWriter::WriteSnapshots");
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_isSessionActive || !m_file.is_open()) {
+    return false;
+  }
+
+  for (const auto &snapshot : snapshots) {
+    WriteRow(*snapshot);
+  }
+
+  // One flush for the whole batch
+  m_file.flush();
+
+  m_rowsWritten += static_cast<int>(snapshots.size());
+  return true;
+}
+
+void CSVWriter::WriteRow(const MetricsSnapshot &snapshot) {
+  // The 28 fixed columns, then the enabled optional columns in header order
   m_file << EscapeCSV(snapshot.timestamp) << ","
          << EscapeCSV(snapshot.sessionId) << ","
          << EscapeCSV(snapshot.projectName) << ","
@@ -214,12 +302,61 @@ bool CSVWriter::WriteSnapshot(const MetricsSnapshot &snapshot) {
          << "," << snapshot.memoryUsage << ","
          << (snapshot.windowFocused ? "true" : "false") << ","
          << snapshot.keystrokesTotal << "," << snapshot.compileAttempts << ","
-         << snapshot.errorCountTotal << "\n";
+         << snapshot.errorCountTotal << "," << snapshot.bulkInserts << ","
+         << snapshot.bulkInsertChars;
 
-  // Flush immediately for data safety (auto-save behavior)
-  m_file.flush();
+  if (m_overheadColumns) {
+    m_file << std::setprecision(0);
+    for (const OverheadStats &stats : snapshot.overhead) {
+      m_file << "," << stats.p50Ns << "," << stats.p99Ns << "," << stats.maxNs;
+    }
+    m_file << std::setprecision(2);
+  }
+  if (m_digraphColumns) {
+    for (const DigraphDeviation &digraph : snapshot.digraphs) {
+      m_file << ",";
+      if (digraph.first != KeyClass::UNKNOWN) {
+        m_file << GetKeyClassLabel(digraph.first) << ">"
+               << GetKeyClassLabel(digraph.second);
+      }
+      m_file << "," << digraph.deltaMs << "," << digraph.zScore;
+    }
+  }
+  m_file << "\n";
+}
 
-  ++m_rowsWritten;
+bool CSVWriter::WriteEvent(const ShiftEvent &event) {
+  ANXIETY_TRACE("CSVWriter::WriteEvent");
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (!m_isSessionActive) {
+    return false;
+  }
+
+  // Lazily create the event stream so quiet sessions leave no empty file
+  if (!m_eventFile.is_open()) {
+    m_eventFilePath =
+        MakeOutputPath("anxiety_events_" + m_fileTimestamp + ".csv");
+    m_eventFile.open(m_eventFilePath, std::ios::out | std::ios::trunc);
+    if (!m_eventFile.is_open()) {
+      return false;
+    }
+    for (size_t i = 0; i < EVENT_HEADERS.size(); ++i) {
+      if (i > 0)
+        m_eventFile << ",";
+      m_eventFile << EVENT_HEADERS[i];
+    }
+    m_eventFile << "\n";
+  }
+
+  m_eventFile << EscapeCSV(event.timestamp) << "," << EscapeCSV(m_sessionId)
+              << "," << GetShiftMetricLabel(event.metric) << ","
+              << (event.direction > 0 ? "up" : "down") << "," << std::fixed
+              << std::setprecision(2) << event.value << "," << event.baseline
+              << "\n";
+
+  // Events are rare - flush immediately like snapshot rows
+  m_eventFile.flush();
   return true;
 }
 
@@ -229,6 +366,9 @@ void CSVWriter::Flush() {
   if (m_file.is_open()) {
     m_file.flush();
   }
+  if (m_eventFile.is_open()) {
+    m_eventFile.flush();
+  }
 }
 
 void CSVWriter::EndSession() {
@@ -238,6 +378,9 @@ void CSVWriter::EndSession() {
     m_file.flush();
     m_file.close();
   }
+  if (m_eventFile.is_open()) {
+    m_eventFile.close();
+  }
 
   m_isSessionActive = false;
 }
@@ -247,6 +390,26 @@ std::string CSVWriter::GetCurrentFilePath() const {
   return m_currentFilePath;
 }
 
+std::string CSVWriter::GetEventFilePath() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_eventFilePath;
+}
+
+std::string CSVWriter::GetLastError() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_lastError;
+}
+
+void CSVWriter::SetOverheadColumns(bool enabled) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_overheadColumns = enabled;
+}
+
+void CSVWriter::SetDigraphColumns(bool enabled) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_digraphColumns = enabled;
+}
+
 void CSVWriter::SetOutputDirectory(const std::string &directory) {
   std::lock_guard<std::mutex> lock(m_mutex);
   m_outputDirectory = directory;
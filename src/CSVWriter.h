@@ -3,6 +3,7 @@
 
 #include <string>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include "MetricsData.h"
@@ -15,10 +16,10 @@ namespace AnxietyMonitor {
  * 
  * Features:
  * - Auto-creates session files with timestamp-based naming
- * - Real-time append every 30 seconds
+ * - Batched append at the configured persist interval (default 30 seconds)
  * - Auto-save on session stop or plugin exit
  * - Thread-safe write operations
- * - 24-column CSV format per research specifications
+ * - 28 fixed columns, plus optional overhead / digraph columns
  */
 class CSVWriter {
 public:
@@ -32,6 +33,16 @@ public:
      */
     bool StartSession(const std::string& sessionId);
     
+    /**
+     * @brief Initialize a session CSV file with an explicit name.
+     * Used by bulk exports (e.g. synthetic workloads) that write many
+     * sessions per second, where timestamp-based names would collide.
+     * @param sessionId Unique session identifier
+     * @param fileName File name inside the output directory
+     * @return true if file was created successfully
+     */
+    bool StartSession(const std::string& sessionId, const std::string& fileName);
+    
     /**
      * @brief Write a metrics snapshot to the current session file.
      * @param snapshot The metrics data to write
@@ -39,6 +50,22 @@ public:
      */
     bool WriteSnapshot(const MetricsSnapshot& snapshot);
     
+    /**
+     * @brief Write a batch of samples with a single flush.
+     * @param snapshots Samples in capture order
+     * @return true if write was successful
+     */
+    bool WriteSnapshots(const std::vector<std::shared_ptr<const MetricsSnapshot>>& snapshots);
+    
+    /**
+     * @brief Append a change-point event to the session's event stream.
+     * The events file (anxiety_events_YYYYMMDD_HHMMSS.csv) is created next to
+     * the session file on the first event.
+     * @param event The detected shift
+     * @return true if write was successful
+     */
+    bool WriteEvent(const ShiftEvent& event);
+    
     /**
      * @brief Force flush all buffered data to disk.
      * Called on pause, stop, or exit for auto-save functionality.
@@ -57,18 +84,51 @@ public:
      */
     std::string GetCurrentFilePath() const;
     
+    /**
+     * @brief Get the current event stream file path.
+     * @return Full path to the events CSV, or empty if no event was written
+     */
+    std::string GetEventFilePath() const;
+    
+    /**
+     * @brief Reason the last StartSession() failed.
+     * @return Error message, or empty if the last start succeeded
+     */
+    std::string GetLastError() const;
+    
     /**
      * @brief Set the output directory for CSV files.
      * @param directory The directory path (will be created if needed)
      */
     void SetOutputDirectory(const std::string& directory);
     
+    /**
+     * @brief Append plugin self-overhead columns (p50/p99/max ns per probe
+     * site) to each row. Takes effect from the next StartSession().
+     */
+    void SetOverheadColumns(bool enabled);
+    
+    /**
+     * @brief Append the top digraph latency deviations (pair, delta ms,
+     * z-score per rank) after any overhead columns. Takes effect from the
+     * next StartSession().
+     */
+    void SetDigraphColumns(bool enabled);
+    
     /**
      * @brief Get the default output directory.
      * @return Path to ~/.codeblocks/anxiety_monitor/sessions/
      */
     static std::string GetDefaultOutputDirectory();
     
+    /**
+     * @brief Create a directory and any missing parents.
+     * @param path Directory to create (existing directories are fine)
+     * @param error Receives the reason on failure (optional)
+     * @return true if the directory exists afterwards
+     */
+    static bool EnsureDirectoryExists(const std::string& path, std::string* error = nullptr);
+    
     /**
      * @brief Check if a session is currently active.
      */
@@ -80,15 +140,22 @@ public:
     int GetRowsWritten() const { return m_rowsWritten; }
 
 private:
+    /**
+     * @brief Open the session file and write its header.
+     * @param fileTimestamp Names the matching event stream file
+     */
+    bool OpenSession(const std::string& sessionId, const std::string& fileName,
+                     const std::string& fileTimestamp);
+    
     /**
      * @brief Write the CSV header row.
      */
     void WriteHeader();
     
     /**
-     * @brief Create the output directory if it doesn't exist.
+     * @brief Append one CSV row for a snapshot to the session file.
      */
-    bool EnsureDirectoryExists(const std::string& path);
+    void WriteRow(const MetricsSnapshot& snapshot);
     
     /**
      * @brief Generate timestamp string for filenames.
@@ -99,18 +166,32 @@ private:
      * @brief Escape a string value for CSV format.
      */
     static std::string EscapeCSV(const std::string& value);
+    
+    /**
+     * @brief Build a path in the output directory for the given filename.
+     */
+    std::string MakeOutputPath(const std::string& filename) const;
 
 private:
     std::ofstream m_file;
+    std::ofstream m_eventFile;
     std::string m_outputDirectory;
     std::string m_currentFilePath;
+    std::string m_eventFilePath;
+    std::string m_fileTimestamp;    // Shared by session and event filenames
     std::string m_sessionId;
     bool m_isSessionActive;
     int m_rowsWritten;
+    bool m_overheadColumns;
+    bool m_digraphColumns;
+    std::string m_lastError;
     mutable std::mutex m_mutex;
     
-    // CSV column headers (24 columns)
+    // Fixed CSV column headers (28 columns)
     static const std::vector<std::string> CSV_HEADERS;
+    
+    // Event stream column headers
+    static const std::vector<std::string> EVENT_HEADERS;
 };
 
 } // namespace AnxietyMonitor
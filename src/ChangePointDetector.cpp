@@ -0,0 +1,108 @@
+#include "ChangePointDetector.h"
+#include <algorithm>
+
+namespace AnxietyMonitor {
+
+// ============================================================================
+// PageHinkleyDetector Implementation
+// ============================================================================
+
+PageHinkleyDetector::PageHinkleyDetector(double delta, double threshold, int minSamples)
+    : m_delta(delta)
+    , m_threshold(threshold)
+    , m_minSamples(minSamples)
+{
+    Reset();
+}
+
+void PageHinkleyDetector::Reset()
+{
+    m_count = 0;
+    m_mean = 0.0;
+    m_cumUp = 0.0;
+    m_minCumUp = 0.0;
+    m_cumDown = 0.0;
+    m_maxCumDown = 0.0;
+}
+
+int PageHinkleyDetector::Update(double value)
+{
+    // Incremental mean of the current regime
+    ++m_count;
+    m_mean += (value - m_mean) / m_count;
+    
+    m_cumUp += value - m_mean - m_delta;
+    m_minCumUp = std::min(m_minCumUp, m_cumUp);
+    
+    m_cumDown += value - m_mean + m_delta;
+    m_maxCumDown = std::max(m_maxCumDown, m_cumDown);
+    
+    if (m_count < m_minSamples) {
+        return 0;
+    }
+    
+    int direction = 0;
+    if (m_cumUp - m_minCumUp > m_threshold) {
+        direction = 1;
+    } else if (m_maxCumDown - m_cumDown > m_threshold) {
+        direction = -1;
+    }
+    
+    if (direction != 0) {
+        // Re-baseline on the new regime, seeded with the triggering value
+        Reset();
+        m_count = 1;
+        m_mean = value;
+    }
+    
+    return direction;
+}
+
+// ============================================================================
+// ShiftDetector Implementation
+// ============================================================================
+
+ShiftDetector::ShiftDetector(const PluginSettings& settings)
+    : m_scoreDetector(settings.scoreShiftDelta, settings.scoreShiftThreshold,
+                      settings.shiftMinSamples)
+    , m_errorRateDetector(settings.errorRateShiftDelta, settings.errorRateShiftThreshold,
+                          settings.shiftMinSamples)
+    , m_backspaceDetector(settings.backspaceShiftDelta, settings.backspaceShiftThreshold,
+                          settings.shiftMinSamples)
+{
+}
+
+size_t ShiftDetector::Update(const MetricsSnapshot& snapshot, std::vector<ShiftEvent>& events)
+{
+    size_t detected = 0;
+    
+    auto check = [&](PageHinkleyDetector& detector, ShiftMetric metric, double value) {
+        double baseline = detector.GetBaseline();
+        int direction = detector.Update(value);
+        if (direction != 0) {
+            ShiftEvent event;
+            event.timestamp = snapshot.timestamp;
+            event.metric = metric;
+            event.direction = direction;
+            event.value = value;
+            event.baseline = baseline;
+            events.push_back(event);
+            ++detected;
+        }
+    };
+    
+    check(m_scoreDetector, ShiftMetric::ANXIETY_SCORE, snapshot.anxietyScore);
+    check(m_errorRateDetector, ShiftMetric::ERROR_RATE, snapshot.errorFreqPerMin);
+    check(m_backspaceDetector, ShiftMetric::BACKSPACE_RATE, snapshot.backspaceRate);
+    
+    return detected;
+}
+
+void ShiftDetector::Reset()
+{
+    m_scoreDetector.Reset();
+    m_errorRateDetector.Reset();
+    m_backspaceDetector.Reset();
+}
+
+} // namespace AnxietyMonitor
@@ -0,0 +1,88 @@
+#ifndef CHANGE_POINT_DETECTOR_H
+#define CHANGE_POINT_DETECTOR_H
+
+#include <vector>
+#include "MetricsData.h"
+
+namespace AnxietyMonitor {
+
+/**
+ * @class PageHinkleyDetector
+ * @brief Two-sided Page-Hinkley test over a single metric stream.
+ *
+ * Keeps only a running mean and two cumulative sums, so every update is
+ * O(1) in time and memory. After a shift is reported the detector
+ * re-baselines on the new regime.
+ */
+class PageHinkleyDetector {
+public:
+    /**
+     * @param delta Magnitude of change tolerated before accumulating evidence
+     * @param threshold Cumulative evidence (lambda) required to report a shift
+     * @param minSamples Samples needed to establish a baseline before testing
+     */
+    PageHinkleyDetector(double delta, double threshold, int minSamples);
+    
+    /**
+     * @brief Feed one observation.
+     * @return +1 for an upward shift, -1 for a downward shift, 0 otherwise
+     */
+    int Update(double value);
+    
+    /**
+     * @brief Forget all history and start a new baseline.
+     */
+    void Reset();
+    
+    /**
+     * @brief Running mean of the current regime.
+     */
+    double GetBaseline() const { return m_mean; }
+
+private:
+    double m_delta;
+    double m_threshold;
+    int m_minSamples;
+    
+    long m_count;
+    double m_mean;
+    double m_cumUp;      // Sum of (x - mean - delta)
+    double m_minCumUp;
+    double m_cumDown;    // Sum of (x - mean + delta)
+    double m_maxCumDown;
+};
+
+/**
+ * @class ShiftDetector
+ * @brief Online change-point detection over the anxiety score, error rate
+ *        and backspace rate.
+ *
+ * Fed once per scored snapshot; emits timestamped ShiftEvents that the
+ * plugin forwards to the panel and the CSV event stream.
+ */
+class ShiftDetector {
+public:
+    explicit ShiftDetector(const PluginSettings& settings = PluginSettings());
+    
+    /**
+     * @brief Update all metric detectors with a scored snapshot.
+     * @param snapshot Snapshot with anxietyScore already computed
+     * @param events Detected shifts are appended here
+     * @return Number of shifts detected by this update
+     */
+    size_t Update(const MetricsSnapshot& snapshot, std::vector<ShiftEvent>& events);
+    
+    /**
+     * @brief Reset all detectors (called when a new session starts).
+     */
+    void Reset();
+
+private:
+    PageHinkleyDetector m_scoreDetector;
+    PageHinkleyDetector m_errorRateDetector;
+    PageHinkleyDetector m_backspaceDetector;
+};
+
+} // namespace AnxietyMonitor
+
+#endif // CHANGE_POINT_DETECTOR_H
@@ -0,0 +1,162 @@
+#include "CompileHistory.h"
+#include <algorithm>
+#include <cmath>
+
+namespace AnxietyMonitor {
+
+// ============================================================================
+// ResolutionSketch
+// ============================================================================
+
+int ResolutionSketch::BucketFor(uint64_t ms)
+{
+    if (ms < SUB_BUCKETS) return static_cast<int>(ms);
+
+    // Octave e = floor(log2(ms)) >= 3, split into 8 linear sub-buckets
+    int octave = 0;
+    for (uint64_t v = ms; v > 1; v >>= 1) ++octave;
+    int sub = static_cast<int>((ms >> (octave - 3)) & (SUB_BUCKETS - 1));
+    int bucket = SUB_BUCKETS + (octave - 3) * SUB_BUCKETS + sub;
+    return std::min(bucket, BUCKET_COUNT - 1);
+}
+
+double ResolutionSketch::BucketMidpoint(int bucket)
+{
+    if (bucket < SUB_BUCKETS) return bucket;
+
+    int shift = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+    int sub = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+    double width = std::ldexp(1.0, shift);
+    return (SUB_BUCKETS + sub) * width + width / 2.0;
+}
+
+void ResolutionSketch::Record(long long ms)
+{
+    if (ms < 0) ms = 0;
+    ++m_buckets[BucketFor(static_cast<uint64_t>(ms))];
+    ++m_count;
+    m_max = std::max(m_max, ms);
+}
+
+void ResolutionSketch::Clear()
+{
+    std::fill(m_buckets, m_buckets + BUCKET_COUNT, 0);
+    m_count = 0;
+    m_max = 0;
+}
+
+double ResolutionSketch::Quantile(double fraction) const
+{
+    if (m_count == 0) return 0.0;
+
+    fraction = std::max(0.0, std::min(1.0, fraction));
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * m_count));
+    if (rank == 0) rank = 1;
+
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKET_COUNT; ++b) {
+        seen += m_buckets[b];
+        if (seen >= rank) {
+            return std::min(BucketMidpoint(b), static_cast<double>(m_max));
+        }
+    }
+    return static_cast<double>(m_max);
+}
+
+// ============================================================================
+// CompileHistory
+// ============================================================================
+
+CompileHistory::CompileHistory(size_t capacity)
+    : m_entries(capacity)
+    , m_hasOpen(false)
+    , m_recentSumMs(0)
+    , m_recentCount(0)
+    , m_sessionSumMs(0)
+    , m_sessionMaxMs(0)
+{
+}
+
+void CompileHistory::OnStart(std::chrono::steady_clock::time_point when)
+{
+    m_openStart = when;
+    m_hasOpen = true;
+}
+
+void CompileHistory::OnEnd(int errorCount, int warningCount, bool success,
+                           std::chrono::steady_clock::time_point when,
+                           const DiagnosticCounts* diagnostics,
+                           const ErrorRecurrence* recurrence)
+{
+    Entry entry;
+    entry.compile.startTime = m_hasOpen ? m_openStart : when;
+    entry.compile.endTime = when;
+    entry.compile.errorCount = errorCount;
+    entry.compile.warningCount = warningCount;
+    entry.compile.success = success;
+    entry.resolutionMs = -1;
+    if (diagnostics) {
+        entry.compile.diagnostics = *diagnostics;
+        m_sessionDiagnostics += *diagnostics;
+    }
+    if (recurrence) {
+        entry.compile.recurrence = *recurrence;
+        m_sessionRecurrence += *recurrence;
+    }
+    m_hasOpen = false;
+
+    // A success right after a failure resolves it
+    if (success && !m_entries.empty() && !m_entries[m_entries.size() - 1].compile.success) {
+        entry.resolutionMs = std::max<long long>(0,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                when - m_entries[m_entries.size() - 1].compile.endTime).count());
+
+        m_sessionSumMs += entry.resolutionMs;
+        m_sessionMaxMs = std::max(m_sessionMaxMs, entry.resolutionMs);
+        m_sketch.Record(entry.resolutionMs);
+    }
+
+    // The push below overwrites the oldest entry once the ring is full
+    if (m_entries.size() == m_entries.capacity() && m_entries[0].resolutionMs >= 0) {
+        m_recentSumMs -= m_entries[0].resolutionMs;
+        --m_recentCount;
+    }
+    if (entry.resolutionMs >= 0) {
+        m_recentSumMs += entry.resolutionMs;
+        ++m_recentCount;
+    }
+    m_entries.push(entry);
+}
+
+void CompileHistory::Clear()
+{
+    m_entries.clear();
+    m_hasOpen = false;
+    m_recentSumMs = 0;
+    m_recentCount = 0;
+    m_sessionSumMs = 0;
+    m_sessionMaxMs = 0;
+    m_sketch.Clear();
+    m_sessionDiagnostics = DiagnosticCounts();
+    m_sessionRecurrence = ErrorRecurrence();
+}
+
+double CompileHistory::GetRecentMeanResolutionSec() const
+{
+    return m_recentCount > 0 ? m_recentSumMs / 1000.0 / m_recentCount : 0.0;
+}
+
+ResolutionStats CompileHistory::GetSessionStats() const
+{
+    ResolutionStats stats;
+    stats.count = m_sketch.GetCount();
+    if (stats.count == 0) return stats;
+
+    stats.meanSec = m_sessionSumMs / 1000.0 / stats.count;
+    stats.maxSec = m_sessionMaxMs / 1000.0;
+    stats.p50Sec = m_sketch.Quantile(0.50) / 1000.0;
+    stats.p90Sec = m_sketch.Quantile(0.90) / 1000.0;
+    return stats;
+}
+
+} // namespace AnxietyMonitor
@@ -0,0 +1,118 @@
+#ifndef COMPILE_HISTORY_H
+#define COMPILE_HISTORY_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "MetricsData.h"
+
+namespace AnxietyMonitor {
+
+/**
+ * @class ResolutionSketch
+ * @brief Fixed-size quantile sketch of error resolution times (ms).
+ *
+ * Log-linear buckets: 8 per power of two, so a quantile is within 12.5%
+ * of the true value. Covers 0 ms to ~50 days in 256 counters; memory does
+ * not grow with the number of samples.
+ */
+class ResolutionSketch {
+public:
+    static const int SUB_BUCKETS = 8;
+    static const int BUCKET_COUNT = 256;
+
+    void Record(long long ms);
+    void Clear();
+
+    uint64_t GetCount() const { return m_count; }
+
+    // Approximate quantile (fraction in [0, 1]), clamped to the exact maximum
+    double Quantile(double fraction) const;
+
+private:
+    static int BucketFor(uint64_t ms);
+    static double BucketMidpoint(int bucket);
+
+    uint64_t m_buckets[BUCKET_COUNT] = {};
+    uint64_t m_count = 0;
+    long long m_max = 0;
+};
+
+/**
+ * @brief Error resolution statistics: time from a failed build to the next
+ * successful one.
+ */
+struct ResolutionStats {
+    uint64_t count = 0;
+    double meanSec = 0.0;
+    double maxSec = 0.0;
+    double p50Sec = 0.0;
+    double p90Sec = 0.0;
+};
+
+/**
+ * @class CompileHistory
+ * @brief Ring of recent compiles with incrementally kept resolution stats.
+ *
+ * Every successful compile that directly follows a failed one records a
+ * resolution time (end to end). Two sets of statistics are updated as
+ * compiles end, so reading either is O(1):
+ * - recent: mean over the compiles still in the ring (the snapshot's
+ *   error_resolution_time); an evicted compile's resolution is subtracted
+ * - session: count / sum / max and a quantile sketch over every
+ *   resolution since Clear(), in constant memory
+ */
+class CompileHistory {
+public:
+    struct Entry {
+        CompileEvent compile;
+        long long resolutionMs;     // -1: this compile resolved nothing
+    };
+
+    explicit CompileHistory(size_t capacity = 20);
+
+    void OnStart(std::chrono::steady_clock::time_point when);
+    void OnEnd(int errorCount, int warningCount, bool success,
+               std::chrono::steady_clock::time_point when,
+               const DiagnosticCounts* diagnostics = nullptr,
+               const ErrorRecurrence* recurrence = nullptr);
+    void Clear();
+
+    // Retained compiles in time order (0 = oldest); in-progress one excluded
+    size_t Size() const { return m_entries.size(); }
+    size_t Capacity() const { return m_entries.capacity(); }
+    const Entry& operator[](size_t i) const { return m_entries[i]; }
+
+    // Mean resolution of the retained compiles in seconds (0 if none)
+    double GetRecentMeanResolutionSec() const;
+
+    ResolutionStats GetSessionStats() const;
+
+    // Build log diagnostics summed over the session
+    const DiagnosticCounts& GetSessionDiagnostics() const { return m_sessionDiagnostics; }
+
+    // New / repeated / resolved errors summed over the session
+    const ErrorRecurrence& GetSessionRecurrence() const { return m_sessionRecurrence; }
+
+private:
+    RollingBuffer<Entry> m_entries;
+
+    // Compile in progress (OnStart seen, OnEnd not yet)
+    std::chrono::steady_clock::time_point m_openStart;
+    bool m_hasOpen;
+
+    // Recent window (retained entries)
+    long long m_recentSumMs;
+    size_t m_recentCount;
+
+    // Whole session
+    long long m_sessionSumMs;
+    long long m_sessionMaxMs;
+    ResolutionSketch m_sketch;
+    DiagnosticCounts m_sessionDiagnostics;
+    ErrorRecurrence m_sessionRecurrence;
+};
+
+} // namespace AnxietyMonitor
+
+#endif // COMPILE_HISTORY_H
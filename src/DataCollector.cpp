@@ -1,5 +1,8 @@
 #include "DataCollector.h"
-#include "AnxietyScorer.h"
+#include "Instrumentation.h"
+#include "LiveMetricsSegment.h"
+#include "TraceRecorder.h"
+#include "SystemSampler.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -11,17 +14,20 @@ namespace AnxietyMonitor {
 
 DataCollector::DataCollector()
     : m_sessionState(SessionState::STOPPED)
+    , m_generation(0)
+    , m_lastKeyClass(KeyClass::UNKNOWN)
     , m_totalKeystrokes(0)
     , m_keystrokesInWindow(0)
     , m_backspaceCount(0)
     , m_undoCount(0)
     , m_redoCount(0)
+    , m_bulkInsertCount(0)
+    , m_bulkInsertChars(0)
     , m_compileAttempts(0)
     , m_successfulCompiles(0)
     , m_totalErrors(0)
     , m_errorsInWindow(0)
     , m_totalPauseTimeMs(0)
-    , m_totalIdleTimeMs(0)
     , m_totalActiveTimeMs(0)
     , m_breakCount(0)
     , m_focusSwitchCount(0)
@@ -32,6 +38,11 @@ DataCollector::DataCollector()
     , m_cachedRiskLevel(RiskLevel::LOW)
     , m_interKeyDelays(300)   // ~5 minutes worth at typical typing
     , m_typingSpeedSamples(10)
+    , m_compiles(MAX_RECENT_COMPILES)
+    , m_scoringSnapshot()
+    , m_systemSampler(nullptr)
+    , m_liveSegment(nullptr)
+    , m_liveSample()
 {
 }
 
@@ -41,70 +52,110 @@ DataCollector::~DataCollector()
 }
 
 void DataCollector::StartSession()
+{
+    StartSession(std::chrono::steady_clock::now());
+}
+
+void DataCollector::StartSession(std::chrono::steady_clock::time_point start)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
     
     if (m_sessionState != SessionState::STOPPED) {
         return;
     }
     
     Reset();
+    m_clock.SetIdleThreshold(m_settings.pauseThresholdMs);
+    m_clock.Start(start);
+    m_lastKeystrokeTime = start;
+    m_lastKeyClass = KeyClass::UNKNOWN;
     m_sessionState = SessionState::RUNNING;
-    m_sessionStart = std::chrono::steady_clock::now();
-    m_lastKeystrokeTime = m_sessionStart;
-    m_lastActivityTime = m_sessionStart;
+    PublishLive();
 }
 
 void DataCollector::PauseSession()
+{
+    PauseSession(std::chrono::steady_clock::now());
+}
+
+void DataCollector::PauseSession(std::chrono::steady_clock::time_point when)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
     
     if (m_sessionState == SessionState::RUNNING) {
+        m_clock.Pause(when);
         m_sessionState = SessionState::PAUSED;
+        PublishLive();
     }
 }
 
 void DataCollector::ResumeSession()
+{
+    ResumeSession(std::chrono::steady_clock::now());
+}
+
+void DataCollector::ResumeSession(std::chrono::steady_clock::time_point when)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
     
     if (m_sessionState == SessionState::PAUSED) {
+        // Move the keystroke mark past the pause, so the next key measures
+        // only the unpaused gap (not a pause or break of the whole pause)
+        m_lastKeystrokeTime += m_clock.Resume(when);
         m_sessionState = SessionState::RUNNING;
-        m_lastActivityTime = std::chrono::steady_clock::now();
+        PublishLive();
     }
 }
 
 void DataCollector::EndSession()
+{
+    EndSession(std::chrono::steady_clock::now());
+}
+
+void DataCollector::EndSession(std::chrono::steady_clock::time_point when)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    m_clock.Stop(when);
     m_sessionState = SessionState::STOPPED;
+    PublishLive();
 }
 
 void DataCollector::Reset()
 {
+    BumpGeneration();
+    m_liveSample = LiveMetrics();
     m_totalKeystrokes = 0;
     m_keystrokesInWindow = 0;
     m_backspaceCount = 0;
     m_undoCount = 0;
     m_redoCount = 0;
+    m_bulkInsertCount = 0;
+    m_bulkInsertChars = 0;
     m_compileAttempts = 0;
     m_successfulCompiles = 0;
     m_totalErrors = 0;
     m_errorsInWindow = 0;
     m_totalPauseTimeMs = 0;
-    m_totalIdleTimeMs = 0;
     m_totalActiveTimeMs = 0;
     m_breakCount = 0;
     m_focusSwitchCount = 0;
     
     m_interKeyDelays.clear();
     m_typingSpeedSamples.clear();
-    m_recentCompiles.clear();
+    m_digraphs.Clear();
+    m_compiles.Clear();
+    m_errorFingerprints.Clear();
+    m_lastRecurrence = ErrorRecurrence();
     
     m_cachedLatencyVariance = 0.0;
     m_cachedTypingSpeed = 0.0;
     m_cachedAnxietyScore = 0.0;
     m_cachedRiskLevel = RiskLevel::LOW;
+    m_scoringSnapshot = MetricsSnapshot();
 }
 
 long DataCollector::GetCurrentTimeMs() const
@@ -116,12 +167,217 @@ long DataCollector::GetCurrentTimeMs() const
 
 void DataCollector::OnKeystroke(bool isBackspace)
 {
-    if (m_sessionState != SessionState::RUNNING) return;
+    OnKeystroke(isBackspace, std::chrono::steady_clock::now());
+}
+
+void DataCollector::OnKeystroke(bool isBackspace, std::chrono::steady_clock::time_point when)
+{
+    if (!IsRunning()) return;
     
     std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    HandleKeystroke(isBackspace, isBackspace ? KeyClass::BACKSPACE : KeyClass::UNKNOWN, when);
+}
+
+void DataCollector::OnKeystroke(KeyClass key, std::chrono::steady_clock::time_point when)
+{
+    if (!IsRunning()) return;
     
-    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    HandleKeystroke(key == KeyClass::BACKSPACE, key, when);
+}
+
+void DataCollector::OnBulkInsert(int charCount, std::chrono::steady_clock::time_point when)
+{
+    if (!IsRunning()) return;
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    HandleBulkInsert(charCount, when);
+}
+
+void DataCollector::OnUndo()
+{
+    if (!IsRunning()) return;
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    HandleUndoRedo(true, std::chrono::steady_clock::now());
+}
+
+void DataCollector::OnRedo()
+{
+    if (!IsRunning()) return;
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    HandleUndoRedo(false, std::chrono::steady_clock::now());
+}
+
+void DataCollector::OnCompileStart()
+{
+    if (!IsRunning()) return;
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    HandleCompileStart(std::chrono::steady_clock::now());
+}
+
+void DataCollector::OnCompileEnd(int errorCount, int warningCount, bool success)
+{
+    if (!IsRunning()) return;
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    HandleCompileEnd(errorCount, warningCount, success, std::chrono::steady_clock::now());
+}
+
+void DataCollector::OnEditorFocusChange(bool hasFocus)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    HandleFocusChange(hasFocus);
+}
+
+void DataCollector::OnTabChange()
+{
+    if (!IsRunning()) return;
     
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    HandleTabChange(std::chrono::steady_clock::now());
+}
+
+void DataCollector::OnIdleTick()
+{
+    // Idle spans are measured by m_clock from the last activity, so a tick
+    // carries no information; kept for callers that still deliver them
+}
+
+void DataCollector::SetActiveProject(const std::string& projectName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    m_projectName = projectName;
+}
+
+void DataCollector::SetActiveFile(const std::string& filePath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    HandleActiveFile(filePath);
+}
+
+void DataCollector::SetLanguage(const std::string& language)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    m_language = language;
+}
+
+void DataCollector::SetWindowFocused(bool focused)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    BumpGeneration();
+    m_windowHasFocus = focused;
+}
+
+// ============================================================================
+// Queued event processing
+// ============================================================================
+
+size_t DataCollector::ProcessEvents(CollectorEventQueue& queue, size_t maxEvents)
+{
+    size_t processed = 0;
+    
+    // Drain in bounded batches so the lock is held only briefly and
+    // readers (snapshot, status bar) interleave with a large backlog
+    const size_t BATCH_SIZE = 256;
+    CollectorEvent event;
+    
+    while (processed < maxEvents) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        
+        size_t batch = 0;
+        while (batch < BATCH_SIZE && processed < maxEvents && queue.TryPop(event)) {
+            DispatchEvent(event);
+            ++batch;
+            ++processed;
+        }
+        
+        if (batch < BATCH_SIZE) {
+            break;  // Queue drained
+        }
+    }
+    
+    return processed;
+}
+
+void DataCollector::DispatchEvent(const CollectorEvent& event)
+{
+    // Idle ticks and activity marks only move idle accounting, which the
+    // snapshot cache refreshes per time bucket anyway
+    if (event.type != CollectorEventType::IDLE_TICK && event.type != CollectorEventType::ACTIVITY) {
+        BumpGeneration();
+    }
+    
+    // Context events apply in any state; behavioral events only while running
+    switch (event.type) {
+        case CollectorEventType::FOCUS_CHANGE:
+            HandleFocusChange(event.flag);
+            return;
+        case CollectorEventType::ACTIVE_FILE:
+            HandleActiveFile(event.text);
+            return;
+        case CollectorEventType::ACTIVE_PROJECT:
+            m_projectName = event.text;
+            return;
+        default:
+            break;
+    }
+    
+    if (!IsRunning()) return;
+    
+    switch (event.type) {
+        case CollectorEventType::KEYSTROKE:
+            HandleKeystroke(event.flag, static_cast<KeyClass>(event.count), event.when);
+            break;
+        case CollectorEventType::BULK_INSERT:
+            HandleBulkInsert(event.count, event.when);
+            break;
+        case CollectorEventType::UNDO:
+            HandleUndoRedo(true, event.when);
+            break;
+        case CollectorEventType::REDO:
+            HandleUndoRedo(false, event.when);
+            break;
+        case CollectorEventType::COMPILE_START:
+            HandleCompileStart(event.when);
+            break;
+        case CollectorEventType::COMPILE_END:
+            HandleCompileEnd(event.count, event.count2, event.flag, event.when,
+                             event.diagnostics.get());
+            break;
+        case CollectorEventType::TAB_CHANGE:
+            HandleTabChange(event.when);
+            break;
+        case CollectorEventType::IDLE_TICK:
+            break;  // See OnIdleTick
+        case CollectorEventType::ACTIVITY:
+            m_clock.MarkActivity(event.when);
+            break;
+        default:
+            break;
+    }
+}
+
+// ============================================================================
+// Event handlers (caller holds m_mutex)
+// ============================================================================
+
+void DataCollector::HandleKeystroke(bool isBackspace, KeyClass key, std::chrono::steady_clock::time_point now)
+{
     // Calculate inter-key delay
     auto delayMs = std::chrono::duration_cast<std::chrono::milliseconds>(
         now - m_lastKeystrokeTime).count();
@@ -137,6 +393,7 @@ void DataCollector::OnKeystroke(bool isBackspace)
         // Normal keystroke - record inter-key delay
         m_interKeyDelays.push(delayMs);
         m_totalActiveTimeMs += delayMs;
+        m_digraphs.Record(m_lastKeyClass, key, static_cast<float>(delayMs));
     }
     
     // Update counters
@@ -148,53 +405,47 @@ void DataCollector::OnKeystroke(bool isBackspace)
     }
     
     m_lastKeystrokeTime = now;
-    m_lastActivityTime = now;
+    m_lastKeyClass = key < KeyClass::COUNT ? key : KeyClass::UNKNOWN;
+    m_clock.MarkActivity(now);
     
     // Update derived metrics periodically
     if (m_totalKeystrokes % 10 == 0) {
-        UpdateDerivedMetrics();
+        UpdateDerivedMetrics(now);
     }
 }
 
-void DataCollector::OnUndo()
+void DataCollector::HandleBulkInsert(int charCount, std::chrono::steady_clock::time_point when)
 {
-    if (m_sessionState != SessionState::RUNNING) return;
+    // One event for the whole burst: no inter-key delays, no typing speed
+    ++m_bulkInsertCount;
+    m_bulkInsertChars += charCount;
     
-    std::lock_guard<std::mutex> lock(m_mutex);
-    ++m_undoCount;
-    m_lastActivityTime = std::chrono::steady_clock::now();
+    // Next typed key measures its delay from the end of the burst
+    m_lastKeystrokeTime = when;
+    m_lastKeyClass = KeyClass::UNKNOWN;
+    m_clock.MarkActivity(when);
 }
 
-void DataCollector::OnRedo()
+void DataCollector::HandleUndoRedo(bool isUndo, std::chrono::steady_clock::time_point when)
 {
-    if (m_sessionState != SessionState::RUNNING) return;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
-    ++m_redoCount;
-    m_lastActivityTime = std::chrono::steady_clock::now();
+    if (isUndo) {
+        ++m_undoCount;
+    } else {
+        ++m_redoCount;
+    }
+    m_clock.MarkActivity(when);
 }
 
-void DataCollector::OnCompileStart()
+void DataCollector::HandleCompileStart(std::chrono::steady_clock::time_point when)
 {
-    if (m_sessionState != SessionState::RUNNING) return;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    CompileEvent event;
-    event.startTime = std::chrono::steady_clock::now();
-    m_recentCompiles.push_back(event);
-    
-    m_lastActivityTime = event.startTime;
+    m_compiles.OnStart(when);
+    m_clock.MarkActivity(when);
 }
 
-void DataCollector::OnCompileEnd(int errorCount, int warningCount, bool success)
+void DataCollector::HandleCompileEnd(int errorCount, int warningCount, bool success,
+                                     std::chrono::steady_clock::time_point now,
+                                     const BuildDiagnostics* diagnostics)
 {
-    if (m_sessionState != SessionState::RUNNING) return;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    auto now = std::chrono::steady_clock::now();
-    
     ++m_compileAttempts;
     
     if (success) {
@@ -204,73 +455,41 @@ void DataCollector::OnCompileEnd(int errorCount, int warningCount, bool success)
     m_totalErrors += errorCount;
     m_errorsInWindow += errorCount;
     
-    // Update the most recent compile event
-    if (!m_recentCompiles.empty()) {
-        auto& lastCompile = m_recentCompiles.back();
-        lastCompile.endTime = now;
-        lastCompile.errorCount = errorCount;
-        lastCompile.warningCount = warningCount;
-        lastCompile.success = success;
+    // Ring of the last 20 compiles; updates the resolution statistics
+    if (diagnostics) {
+        m_lastRecurrence = m_errorFingerprints.Record(diagnostics->errorFingerprints.data(),
+                                                      diagnostics->errorFingerprints.size());
+        m_compiles.OnEnd(errorCount, warningCount, success, now,
+                         &diagnostics->counts, &m_lastRecurrence);
+    } else {
+        m_compiles.OnEnd(errorCount, warningCount, success, now);
     }
     
     m_lastCompileEndTime = now;
-    m_lastActivityTime = now;
-    
-    // Keep only last 20 compiles
-    if (m_recentCompiles.size() > 20) {
-        m_recentCompiles.erase(m_recentCompiles.begin());
-    }
+    m_clock.MarkActivity(now);
     
-    UpdateDerivedMetrics();
+    UpdateDerivedMetrics(now);
 }
 
-void DataCollector::OnEditorFocusChange(bool hasFocus)
+void DataCollector::HandleFocusChange(bool hasFocus)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
     if (hasFocus != m_windowHasFocus) {
         m_windowHasFocus = hasFocus;
         
-        if (m_sessionState == SessionState::RUNNING) {
+        if (IsRunning()) {
             // Could track focus loss time here for idle calculation
         }
     }
 }
 
-void DataCollector::OnTabChange()
+void DataCollector::HandleTabChange(std::chrono::steady_clock::time_point when)
 {
-    if (m_sessionState != SessionState::RUNNING) return;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
     ++m_focusSwitchCount;
-    m_lastActivityTime = std::chrono::steady_clock::now();
-}
-
-void DataCollector::OnIdleTick()
-{
-    if (m_sessionState != SessionState::RUNNING) return;
-    
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    auto now = std::chrono::steady_clock::now();
-    auto idleMs = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now - m_lastActivityTime).count();
-    
-    // Track idle time if no activity for more than 2 seconds
-    if (idleMs > m_settings.pauseThresholdMs) {
-        m_totalIdleTimeMs += 1000;  // Add tick interval (assumed 1 second)
-    }
+    m_clock.MarkActivity(when);
 }
 
-void DataCollector::SetActiveProject(const std::string& projectName)
+void DataCollector::HandleActiveFile(const std::string& filePath)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_projectName = projectName;
-}
-
-void DataCollector::SetActiveFile(const std::string& filePath)
-{
-    std::lock_guard<std::mutex> lock(m_mutex);
     m_activeFilePath = filePath;
     
     // Attempt to detect language from file extension
@@ -293,28 +512,80 @@ void DataCollector::SetActiveFile(const std::string& filePath)
     }
 }
 
-void DataCollector::SetLanguage(const std::string& language)
+void DataCollector::ApplySettings(const PluginSettings& settings)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_language = language;
+    BumpGeneration();
+    m_settings = settings;
+    m_clock.SetIdleThreshold(settings.pauseThresholdMs);
 }
 
-void DataCollector::SetWindowFocused(bool focused)
+void DataCollector::SetSystemSampler(const SystemSampler* sampler)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
-    m_windowHasFocus = focused;
+    BumpGeneration();
+    m_systemSampler = sampler;
 }
 
-void DataCollector::UpdateDerivedMetrics()
+void DataCollector::SetLiveSegment(LiveMetricsSegment* segment)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_liveSegment = segment;
+    PublishLive();
+}
+
+void DataCollector::UpdateDerivedMetrics(std::chrono::steady_clock::time_point now)
 {
     m_cachedLatencyVariance = CalculateLatencyVariance();
     m_cachedTypingSpeed = CalculateTypingSpeed();
     
-    // Calculate anxiety score using AnxietyScorer
-    MetricsSnapshot snapshot = GetCurrentSnapshot();
-    AnxietyScorer scorer;
-    m_cachedAnxietyScore = scorer.CalculateScore(snapshot);
-    m_cachedRiskLevel = scorer.GetRiskLevel(m_cachedAnxietyScore);
+    // Calculate anxiety score using AnxietyScorer (m_mutex is already held)
+    // Runs on the keystroke path: score from the numeric fields only, into a
+    // reused snapshot, so no strings are built and nothing is allocated
+    FillNumericMetrics(m_scoringSnapshot, now, SNAPSHOT_SCORER_INPUTS);
+    m_cachedAnxietyScore = m_scorer.CalculateScore(m_scoringSnapshot);
+    m_cachedRiskLevel = m_scorer.GetRiskLevel(m_cachedAnxietyScore);
+}
+
+void DataCollector::PublishLiveSample(const MetricsSnapshot& scored)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_liveSegment) return;
+    
+    // Fixed-size copy of the sample: no strings, no allocation
+    LiveMetrics& live = m_liveSample;
+    RiskLevel level;
+    if (!ParseRiskLevelLabel(scored.riskLevel, level)) {
+        level = AnxietyScorer::GetRiskLevel(scored.anxietyScore);
+    }
+    live.riskLevel = static_cast<uint32_t>(level);
+    live.anxietyScore = scored.anxietyScore;
+    live.typingSpeedWpm = scored.typingSpeedWpm;
+    live.latencyVarianceMs = scored.latencyVarianceMs;
+    live.errorFreqPerMin = scored.errorFreqPerMin;
+    live.pauseRatio = scored.pauseRatio;
+    live.errorResolutionTime = scored.errorResolutionTime;
+    live.backspaceRate = scored.backspaceRate;
+    live.consecutiveErrors = scored.consecutiveErrors;
+    live.undoRedoCount = scored.undoRedoCount;
+    live.idleRatio = scored.idleRatio;
+    live.focusSwitches = scored.focusSwitches;
+    live.compileSuccessRate = scored.compileSuccessRate;
+    live.sessionFragmentation = scored.sessionFragmentation;
+    live.keystrokesTotal = scored.keystrokesTotal;
+    live.compileAttempts = scored.compileAttempts;
+    live.errorCountTotal = scored.errorCountTotal;
+    PublishLive();
+}
+
+void DataCollector::PublishLive()
+{
+    if (!m_liveSegment) return;
+    
+    m_liveSample.updatedUnixMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    m_liveSample.sessionState = static_cast<uint32_t>(m_sessionState.load(std::memory_order_relaxed));
+    m_liveSegment->Publish(m_liveSample);
 }
 
 double DataCollector::CalculateLatencyVariance() const
@@ -342,22 +613,25 @@ double DataCollector::CalculatePauseRatio() const
     return static_cast<double>(m_totalPauseTimeMs) / totalTime;
 }
 
-double DataCollector::CalculateIdleRatio() const
+double DataCollector::RunningMinutes(std::chrono::steady_clock::time_point now) const
 {
-    auto now = std::chrono::steady_clock::now();
-    auto sessionMs = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now - m_sessionStart).count();
+    // Per-minute rates use unpaused session time; floor avoids division by zero
+    double minutes = m_clock.RunningMs(now) / 60000.0;
+    return minutes < 0.1 ? 0.1 : minutes;
+}
+
+double DataCollector::CalculateIdleRatio(std::chrono::steady_clock::time_point now) const
+{
+    long long runningMs = m_clock.RunningMs(now);
     
-    if (sessionMs <= 0) return 0.0;
+    if (runningMs <= 0) return 0.0;
     
-    return static_cast<double>(m_totalIdleTimeMs) / sessionMs;
+    return static_cast<double>(m_clock.IdleMs(now)) / runningMs;
 }
 
-double DataCollector::CalculateSessionFragmentation() const
+double DataCollector::CalculateSessionFragmentation(std::chrono::steady_clock::time_point now) const
 {
-    auto now = std::chrono::steady_clock::now();
-    auto sessionMinutes = std::chrono::duration_cast<std::chrono::minutes>(
-        now - m_sessionStart).count();
+    long long sessionMinutes = m_clock.RunningMs(now) / 60000;
     
     if (sessionMinutes <= 0) return 0.0;
     
@@ -373,77 +647,150 @@ double DataCollector::CalculateCompileSuccessRate() const
 
 MetricsSnapshot DataCollector::GetCurrentSnapshot() const
 {
+    return *GetSharedSnapshot();
+}
+
+std::shared_ptr<const MetricsSnapshot> DataCollector::GetSharedSnapshot() const
+{
+    ANXIETY_PROBE(GET_SNAPSHOT);
+    ANXIETY_TRACE("DataCollector::GetCurrentSnapshot");
+    
+    auto now = std::chrono::steady_clock::now();
+    long long nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        now.time_since_epoch()).count();
+    
+    // Fast path: no new input and same time bucket -> no m_mutex, no rebuild.
+    // std::atomic_load on a shared_ptr is not lock-free in libstdc++ (it
+    // briefly takes a mutex from a hashed pool), but it never waits on
+    // m_mutex, so readers do not queue behind event processing.
+    std::shared_ptr<const SnapshotCacheEntry> cached = std::atomic_load(&m_snapshotCache);
+    if (cached && cached->generation == GetGeneration() &&
+        cached->bucket == nowMs / cached->bucketMs) {
+        return std::shared_ptr<const MetricsSnapshot>(cached, &cached->snapshot);
+    }
+    
+    auto entry = std::make_shared<SnapshotCacheEntry>();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Generation only changes under m_mutex, so it matches what is built
+        entry->generation = GetGeneration();
+        entry->bucketMs = std::max(1, std::min(1000, m_settings.sampleIntervalMs / 2));
+        entry->bucket = nowMs / entry->bucketMs;
+        entry->snapshot = BuildSnapshot(now, SNAPSHOT_ALL);
+    }
+    std::atomic_store(&m_snapshotCache, std::shared_ptr<const SnapshotCacheEntry>(entry));
+    return std::shared_ptr<const MetricsSnapshot>(entry, &entry->snapshot);
+}
+
+MetricsSnapshot DataCollector::GetCurrentSnapshot(uint32_t fields) const
+{
+    ANXIETY_TRACE("DataCollector::GetCurrentSnapshot(fields)");
     std::lock_guard<std::mutex> lock(m_mutex);
+    return BuildSnapshot(std::chrono::steady_clock::now(), fields);
+}
+
+MetricsSnapshot DataCollector::GetSnapshotAt(std::chrono::steady_clock::time_point now,
+                                             uint32_t fields) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return BuildSnapshot(now, fields);
+}
+
+MetricsSnapshot DataCollector::BuildSnapshot(std::chrono::steady_clock::time_point steadyNow,
+                                             uint32_t fields) const
+{
+    MetricsSnapshot snapshot = MetricsSnapshot();
+    
+    if (fields & SNAPSHOT_TIMESTAMP) {
+        // Generate timestamp
+        auto now = std::chrono::system_clock::now();
+        auto time = std::chrono::system_clock::to_time_t(now);
+        std::tm* tm = std::localtime(&time);
+        std::ostringstream oss;
+        oss << std::put_time(tm, "%Y-%m-%dT%H:%M:%S");
+        
+        // Sub-second sampling needs millisecond timestamps to keep rows distinct
+        if (m_settings.sampleIntervalMs < 1000) {
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                now.time_since_epoch()).count() % 1000;
+            oss << '.' << std::setfill('0') << std::setw(3) << ms;
+        }
+        snapshot.timestamp = oss.str();
+        
+        // Session info
+        oss.str("");
+        oss << std::put_time(tm, "%Y%m%d%H%M%S");
+        snapshot.sessionId = "session_" + oss.str();
+        
+        // Metadata
+        snapshot.timestampBatch = snapshot.timestamp;
+    }
     
-    MetricsSnapshot snapshot;
+    if (fields & SNAPSHOT_CONTEXT) {
+        snapshot.projectName = m_projectName;
+        snapshot.filePath = m_activeFilePath;
+        snapshot.language = m_language;
+    }
     
-    // Generate timestamp
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    std::tm* tm = std::localtime(&time);
-    std::ostringstream oss;
-    oss << std::put_time(tm, "%Y-%m-%dT%H:%M:%S");
-    snapshot.timestamp = oss.str();
+    FillNumericMetrics(snapshot, steadyNow, fields);
     
-    // Session info
-    oss.str("");
-    oss << std::put_time(tm, "%Y%m%d%H%M%S");
-    snapshot.sessionId = "session_" + oss.str();
-    snapshot.projectName = m_projectName;
-    snapshot.filePath = m_activeFilePath;
-    snapshot.language = m_language;
+    // Computed values
+    if (fields & SNAPSHOT_SCORE) {
+        snapshot.riskLevel = GetRiskLevelLabel(m_cachedRiskLevel);
+    }
     
-    // Calculate session duration
-    auto sessionDuration = std::chrono::steady_clock::now() - m_sessionStart;
-    double sessionMinutes = std::chrono::duration_cast<std::chrono::seconds>(sessionDuration).count() / 60.0;
-    if (sessionMinutes < 0.1) sessionMinutes = 0.1;  // Avoid division by zero
+    return snapshot;
+}
+
+void DataCollector::FillNumericMetrics(MetricsSnapshot& snapshot,
+                                       std::chrono::steady_clock::time_point now,
+                                       uint32_t fields) const
+{
+    double sessionMinutes = RunningMinutes(now);
     
     // Tier 1 Metrics
-    snapshot.typingSpeedWpm = m_cachedTypingSpeed;
-    snapshot.latencyVarianceMs = m_cachedLatencyVariance;
-    snapshot.errorFreqPerMin = m_errorsInWindow / sessionMinutes;
-    snapshot.pauseRatio = CalculatePauseRatio();
+    if (fields & SNAPSHOT_TYPING_SPEED) snapshot.typingSpeedWpm = m_cachedTypingSpeed;
+    if (fields & SNAPSHOT_LATENCY_VARIANCE) snapshot.latencyVarianceMs = m_cachedLatencyVariance;
+    if (fields & SNAPSHOT_ERROR_FREQ) snapshot.errorFreqPerMin = m_errorsInWindow / sessionMinutes;
+    if (fields & SNAPSHOT_PAUSE_RATIO) snapshot.pauseRatio = CalculatePauseRatio();
     
     // Error resolution time (average time between error and next successful compile)
-    double totalResolutionTime = 0.0;
-    int resolutionCount = 0;
-    for (size_t i = 1; i < m_recentCompiles.size(); ++i) {
-        if (!m_recentCompiles[i-1].success && m_recentCompiles[i].success) {
-            auto resTime = std::chrono::duration_cast<std::chrono::seconds>(
-                m_recentCompiles[i].endTime - m_recentCompiles[i-1].endTime).count();
-            totalResolutionTime += resTime;
-            ++resolutionCount;
-        }
-    }
-    snapshot.errorResolutionTime = resolutionCount > 0 ? 
-        totalResolutionTime / resolutionCount : 0.0;
+    if (fields & SNAPSHOT_ERROR_RESOLUTION) snapshot.errorResolutionTime = m_compiles.GetRecentMeanResolutionSec();
     
     // Tier 2 Metrics
-    snapshot.backspaceRate = m_totalKeystrokes > 0 ? 
-        (static_cast<double>(m_backspaceCount) / m_totalKeystrokes) * 100.0 : 0.0;
-    snapshot.consecutiveErrors = m_errorsInWindow;
-    snapshot.undoRedoCount = static_cast<int>(m_undoCount + m_redoCount);
-    snapshot.idleRatio = CalculateIdleRatio();
+    if (fields & SNAPSHOT_BACKSPACE_RATE) {
+        snapshot.backspaceRate = m_totalKeystrokes > 0 ? 
+            (static_cast<double>(m_backspaceCount) / m_totalKeystrokes) * 100.0 : 0.0;
+    }
+    if (fields & SNAPSHOT_CONSECUTIVE_ERRORS) snapshot.consecutiveErrors = m_errorsInWindow;
+    if (fields & SNAPSHOT_UNDO_REDO) snapshot.undoRedoCount = static_cast<int>(m_undoCount + m_redoCount);
+    if (fields & SNAPSHOT_IDLE_RATIO) snapshot.idleRatio = CalculateIdleRatio(now);
     
     // Tier 3 Metrics
-    snapshot.focusSwitches = m_focusSwitchCount / sessionMinutes;
-    snapshot.compileSuccessRate = CalculateCompileSuccessRate();
-    snapshot.sessionFragmentation = CalculateSessionFragmentation();
+    if (fields & SNAPSHOT_FOCUS_SWITCHES) snapshot.focusSwitches = m_focusSwitchCount / sessionMinutes;
+    if (fields & SNAPSHOT_COMPILE_SUCCESS) snapshot.compileSuccessRate = CalculateCompileSuccessRate();
+    if (fields & SNAPSHOT_FRAGMENTATION) snapshot.sessionFragmentation = CalculateSessionFragmentation(now);
     
     // Computed values
-    snapshot.anxietyScore = m_cachedAnxietyScore;
-    snapshot.riskLevel = GetRiskLevelLabel(m_cachedRiskLevel);
+    if (fields & SNAPSHOT_SCORE) snapshot.anxietyScore = m_cachedAnxietyScore;
     
     // Metadata
-    snapshot.timestampBatch = snapshot.timestamp;
-    snapshot.cpuUsage = 0.0;   // Would need platform-specific code
-    snapshot.memoryUsage = 0.0; // Would need platform-specific code
-    snapshot.windowFocused = m_windowHasFocus;
-    snapshot.keystrokesTotal = m_totalKeystrokes;
-    snapshot.compileAttempts = m_compileAttempts;
-    snapshot.errorCountTotal = m_totalErrors;
-    
-    return snapshot;
+    if (fields & SNAPSHOT_SYSTEM) {
+        // Published atomically by the sampler thread
+        snapshot.cpuUsage = m_systemSampler ? m_systemSampler->GetCpuUsage() : 0.0;
+        snapshot.memoryUsage = m_systemSampler ? m_systemSampler->GetMemoryUsageMb() : 0.0;
+    }
+    if (fields & SNAPSHOT_COUNTERS) {
+        snapshot.windowFocused = m_windowHasFocus;
+        snapshot.keystrokesTotal = m_totalKeystrokes;
+        snapshot.compileAttempts = m_compileAttempts;
+        snapshot.errorCountTotal = m_totalErrors;
+        snapshot.bulkInserts = m_bulkInsertCount;
+        snapshot.bulkInsertChars = m_bulkInsertChars;
+    }
+    if (fields & SNAPSHOT_DIGRAPHS) {
+        m_digraphs.TopDeviations(snapshot.digraphs, DIGRAPH_TOP_N);
+    }
 }
 
 double DataCollector::GetTypingSpeedWpm() const
@@ -456,11 +803,10 @@ double DataCollector::GetErrorsPerMinute() const
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     
-    auto sessionDuration = std::chrono::steady_clock::now() - m_sessionStart;
-    double sessionMinutes = std::chrono::duration_cast<std::chrono::seconds>(sessionDuration).count() / 60.0;
-    if (sessionMinutes < 0.1) return 0.0;
+    auto now = std::chrono::steady_clock::now();
+    if (m_clock.RunningMs(now) < 6000) return 0.0;
     
-    return m_errorsInWindow / sessionMinutes;
+    return m_errorsInWindow / RunningMinutes(now);
 }
 
 double DataCollector::GetPauseRatio() const
@@ -489,4 +835,28 @@ RiskLevel DataCollector::GetRiskLevel() const
     return m_cachedRiskLevel;
 }
 
+ResolutionStats DataCollector::GetResolutionStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_compiles.GetSessionStats();
+}
+
+DiagnosticCounts DataCollector::GetDiagnosticTotals() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_compiles.GetSessionDiagnostics();
+}
+
+ErrorRecurrence DataCollector::GetLastErrorRecurrence() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastRecurrence;
+}
+
+ErrorRecurrence DataCollector::GetErrorRecurrenceTotals() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_compiles.GetSessionRecurrence();
+}
+
 } // namespace AnxietyMonitor
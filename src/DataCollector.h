@@ -1,21 +1,25 @@
 #ifndef DATA_COLLECTOR_H
 #define DATA_COLLECTOR_H
 
-#ifdef STANDALONE_BUILD
-#include "wx_stubs.h"
-#else
-#include <wx/timer.h>
-#include <wx/event.h>
-#endif
-
+#include <atomic>
+#include <memory>
 #include <string>
 #include <chrono>
 #include <vector>
 #include <mutex>
 #include "MetricsData.h"
+#include "AnxietyScorer.h"
+#include "CompileHistory.h"
+#include "DigraphMatrix.h"
+#include "ErrorFingerprintCache.h"
+#include "EventQueue.h"
+#include "LiveMetricsSegment.h"
+#include "SessionClock.h"
 
 namespace AnxietyMonitor {
 
+class SystemSampler;
+
 /**
  * @class DataCollector
  * @brief Collects and aggregates all 12 behavioral metrics for anxiety detection.
@@ -32,20 +36,35 @@ public:
     
     // Session control
     void StartSession();
+    void StartSession(std::chrono::steady_clock::time_point start);  // Replay / simulated time
     void PauseSession();
+    void PauseSession(std::chrono::steady_clock::time_point when);
     void ResumeSession();
+    void ResumeSession(std::chrono::steady_clock::time_point when);
     void EndSession();
+    void EndSession(std::chrono::steady_clock::time_point when);
     void Reset();
     
     // Event handlers (called from plugin event callbacks)
     void OnKeystroke(bool isBackspace = false);
+    void OnKeystroke(bool isBackspace, std::chrono::steady_clock::time_point when);
+    void OnKeystroke(KeyClass key, std::chrono::steady_clock::time_point when);  // Feeds digraph timing
+    void OnBulkInsert(int charCount, std::chrono::steady_clock::time_point when);
     void OnUndo();
     void OnRedo();
     void OnCompileStart();
     void OnCompileEnd(int errorCount, int warningCount, bool success);
     void OnEditorFocusChange(bool hasFocus);
     void OnTabChange();
-    void OnIdleTick();  // Called periodically to track idle time
+    void OnIdleTick();  // Idle wakeup; idle time itself comes from the session clock
+    
+    /**
+     * @brief Apply queued SDK events (see EventHandlers).
+     * Callbacks only enqueue; this runs later, off the callback stack, and
+     * takes the lock once per batch.
+     * @return Number of events processed
+     */
+    size_t ProcessEvents(CollectorEventQueue& queue, size_t maxEvents = static_cast<size_t>(-1));
     
     // Set context information
     void SetActiveProject(const std::string& projectName);
@@ -53,9 +72,67 @@ public:
     void SetLanguage(const std::string& language);
     void SetWindowFocused(bool focused);
     
-    // Get current metrics snapshot
+    // Apply plugin settings (thresholds, sampling rate)
+    void ApplySettings(const PluginSettings& settings);
+    
+    // Source for the cpu_usage / memory_usage columns (not owned; may be null)
+    void SetSystemSampler(const SystemSampler* sampler);
+    
+    /**
+     * @brief Shared-memory segment to publish numeric metrics to (not owned;
+     * may be null). Published per sample (PublishLiveSample) and on session
+     * state changes, which repeat the last sample with the new state.
+     */
+    void SetLiveSegment(LiveMetricsSegment* segment);
+    
+    /**
+     * @brief Publish one scored sample to the live segment: the plugin's
+     * per-tick snapshot, so the segment shows the same score as the CSV
+     * and the panel, and keeps updating while the user is idle or paused.
+     */
+    void PublishLiveSample(const MetricsSnapshot& scored);
+    
+    // Get current metrics snapshot (copy of GetSharedSnapshot())
     MetricsSnapshot GetCurrentSnapshot() const;
     
+    /**
+     * @brief Current full snapshot, built at most once per input and time bucket.
+     *
+     * The cached snapshot is reused, without locking or recomputing, while
+     * both hold:
+     * - no input arrived since it was built (same GetGeneration()), and
+     * - the steady clock is still in the same time bucket.
+     * Time-dependent fields (per-minute rates, idle ratio, fragmentation,
+     * timestamps, CPU/memory) can therefore be up to one bucket old. The
+     * bucket is half the sample interval, capped at 1 s, so consecutive
+     * samples always get fresh values and timestamps.
+     */
+    std::shared_ptr<const MetricsSnapshot> GetSharedSnapshot() const;
+    
+    /**
+     * @brief Input generation: increases on every event or setting that
+     * changes collector state. Idle ticks do not count; idle accounting is
+     * time-dependent and refreshed per time bucket.
+     */
+    uint64_t GetGeneration() const { return m_generation.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Snapshot with only the requested fields (SnapshotField mask).
+     * Everything else stays zero / empty and is not computed: no timestamp
+     * formatting or string copies unless asked for.
+     * Meant for frequent UI refreshes, e.g. GetCurrentSnapshot(SNAPSHOT_PANEL).
+     */
+    MetricsSnapshot GetCurrentSnapshot(uint32_t fields) const;
+    
+    /**
+     * @brief Snapshot as of a given steady time instead of now.
+     * Session-relative rates use `now`, so replayed or synthetic timelines
+     * (see WorkloadGenerator) produce the metrics they would have live.
+     * Timestamp strings still come from the wall clock.
+     */
+    MetricsSnapshot GetSnapshotAt(std::chrono::steady_clock::time_point now,
+                                  uint32_t fields = SNAPSHOT_ALL) const;
+    
     // Get individual metrics (for status bar display)
     double GetTypingSpeedWpm() const;
     double GetErrorsPerMinute() const;
@@ -64,18 +141,73 @@ public:
     double GetAnxietyScore() const;
     RiskLevel GetRiskLevel() const;
     
-    // Session state
-    SessionState GetSessionState() const { return m_sessionState; }
-    bool IsRunning() const { return m_sessionState == SessionState::RUNNING; }
+    /**
+     * @brief Error resolution statistics over the whole session (count,
+     * mean, max, p50/p90). Kept incrementally; O(1), constant memory.
+     */
+    ResolutionStats GetResolutionStats() const;
+    
+    /**
+     * @brief Build log diagnostics (errors by kind, warnings, notes) summed
+     * over the session's compiles that carried a parsed log.
+     */
+    DiagnosticCounts GetDiagnosticTotals() const;
+    
+    /**
+     * @brief New / repeated / resolved errors of the last compile with a
+     * parsed build log, and the same summed over the session.
+     */
+    ErrorRecurrence GetLastErrorRecurrence() const;
+    ErrorRecurrence GetErrorRecurrenceTotals() const;
+    
+    // Session state (lock-free, safe to call from any callback)
+    SessionState GetSessionState() const { return m_sessionState.load(std::memory_order_acquire); }
+    bool IsRunning() const { return GetSessionState() == SessionState::RUNNING; }
 
 private:
+    // Cached snapshot with its validity key (see GetSharedSnapshot)
+    struct SnapshotCacheEntry {
+        uint64_t generation;
+        long long bucket;       // Steady time / bucketMs
+        long long bucketMs;
+        MetricsSnapshot snapshot;
+    };
+    
+    // Collector state changed; the caller holds m_mutex
+    void BumpGeneration() { m_generation.fetch_add(1, std::memory_order_release); }
+    
+    // Event handlers; the caller holds m_mutex
+    void DispatchEvent(const CollectorEvent& event);
+    void HandleKeystroke(bool isBackspace, KeyClass key, std::chrono::steady_clock::time_point when);
+    void HandleBulkInsert(int charCount, std::chrono::steady_clock::time_point when);
+    void HandleUndoRedo(bool isUndo, std::chrono::steady_clock::time_point when);
+    void HandleCompileStart(std::chrono::steady_clock::time_point when);
+    void HandleCompileEnd(int errorCount, int warningCount, bool success,
+                          std::chrono::steady_clock::time_point when,
+                          const BuildDiagnostics* diagnostics = nullptr);
+    void HandleFocusChange(bool hasFocus);
+    void HandleTabChange(std::chrono::steady_clock::time_point when);
+    void HandleActiveFile(const std::string& filePath);
+    
+    // Build a snapshot of the masked fields; the caller holds m_mutex
+    MetricsSnapshot BuildSnapshot(std::chrono::steady_clock::time_point now, uint32_t fields) const;
+    
+    // Numeric metric fields only (no strings, no allocation); caller holds m_mutex
+    void FillNumericMetrics(MetricsSnapshot& snapshot, std::chrono::steady_clock::time_point now,
+                            uint32_t fields) const;
+    
     // Internal calculation methods
-    void UpdateDerivedMetrics();
+    void UpdateDerivedMetrics(std::chrono::steady_clock::time_point now);
+    
+    // Write the last sample with the current state to the live segment;
+    // caller holds m_mutex
+    void PublishLive();
     double CalculateLatencyVariance() const;
     double CalculateTypingSpeed() const;
     double CalculatePauseRatio() const;
-    double CalculateIdleRatio() const;
-    double CalculateSessionFragmentation() const;
+    double RunningMinutes(std::chrono::steady_clock::time_point now) const;
+    double CalculateIdleRatio(std::chrono::steady_clock::time_point now) const;
+    double CalculateSessionFragmentation(std::chrono::steady_clock::time_point now) const;
     double CalculateCompileSuccessRate() const;
     
     // Get current time in milliseconds
@@ -85,18 +217,25 @@ private:
     void CheckForPauseOrBreak();
 
 private:
-    SessionState m_sessionState;
+    std::atomic<SessionState> m_sessionState;
     mutable std::mutex m_mutex;
     
-    // Session timing
-    std::chrono::steady_clock::time_point m_sessionStart;
+    // Snapshot cache: generation of the state, entry published with
+    // std::atomic_load / std::atomic_store so readers never take m_mutex
+    // (libstdc++ still guards the pointer copy with a hashed pool mutex)
+    std::atomic<uint64_t> m_generation;
+    mutable std::shared_ptr<const SnapshotCacheEntry> m_snapshotCache;
+    
+    // Session timing: running / paused / idle spans and last activity
+    SessionClock m_clock;
     std::chrono::steady_clock::time_point m_lastKeystrokeTime;
-    std::chrono::steady_clock::time_point m_lastActivityTime;
+    KeyClass m_lastKeyClass;    // UNKNOWN after a pause or bulk insert
     std::chrono::steady_clock::time_point m_lastCompileEndTime;
     
     // Rolling buffers for metrics
     RollingBuffer<long> m_interKeyDelays;       // Keystroke intervals in ms
     RollingBuffer<double> m_typingSpeedSamples; // WPM samples
+    DigraphMatrix m_digraphs;                   // Key-pair latencies
     
     // Counters
     long m_totalKeystrokes;
@@ -104,17 +243,21 @@ private:
     long m_backspaceCount;
     long m_undoCount;
     long m_redoCount;
+    int m_bulkInsertCount;      // Coalesced paste / auto-repeat bursts
+    long m_bulkInsertChars;
     
     // Compile tracking
     int m_compileAttempts;
     int m_successfulCompiles;
     int m_totalErrors;
     int m_errorsInWindow;  // Errors in last 5 minutes
-    std::vector<CompileEvent> m_recentCompiles;  // For error resolution time
+    CompileHistory m_compiles;  // Recent compiles + resolution statistics
+    ErrorFingerprintCache m_errorFingerprints;  // Errors of recent builds
+    ErrorRecurrence m_lastRecurrence;
+    static const size_t MAX_RECENT_COMPILES = 20;
     
-    // Time tracking
+    // Time tracking (session pauses excluded; idle time is in m_clock)
     long m_totalPauseTimeMs;     // Time in pauses (>2s gaps)
-    long m_totalIdleTimeMs;      // Time idle (no activity)
     long m_totalActiveTimeMs;    // Time actively typing
     int m_breakCount;            // Breaks > 30s
     
@@ -133,6 +276,17 @@ private:
     double m_cachedAnxietyScore;
     RiskLevel m_cachedRiskLevel;
     
+    // Scoring state reused by UpdateDerivedMetrics (keystroke path)
+    AnxietyScorer m_scorer;
+    MetricsSnapshot m_scoringSnapshot;
+    
+    // Machine load / process memory source (not owned)
+    const SystemSampler* m_systemSampler;
+    
+    // External live view (not owned) and the last sample published to it
+    LiveMetricsSegment* m_liveSegment;
+    LiveMetrics m_liveSample;
+    
     // Settings reference
     PluginSettings m_settings;
 };
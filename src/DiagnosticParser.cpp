@@ -0,0 +1,370 @@
+#include "DiagnosticParser.h"
+#include <algorithm>
+#include <cstring>
+
+namespace AnxietyMonitor {
+
+namespace {
+
+struct Marker {
+    const char* text;
+    size_t length;
+    DiagnosticSeverity severity;
+};
+
+// Text after "<location>: "
+const Marker MARKERS[] = {
+    {"error: ",       7,  DiagnosticSeverity::ERR},
+    {"fatal error: ", 13, DiagnosticSeverity::ERR},
+    {"warning: ",     9,  DiagnosticSeverity::WARNING},
+    {"note: ",        6,  DiagnosticSeverity::NOTE},
+};
+
+// Linker errors printed without a severity marker
+const char* const LINK_PHRASES[] = {
+    "undefined reference to", "multiple definition of",
+};
+
+struct KindRule {
+    DiagnosticKind kind;
+    const char* const* phrases;
+    size_t count;
+};
+
+// First matching rule wins; order matters ("expected" is very generic)
+const char* const LINK_WORDS[] = {
+    "undefined reference", "multiple definition", "undefined symbol",
+    "ld returned", "linker command failed", "cannot find -l",
+};
+const char* const PREPROCESSOR_WORDS[] = {
+    "No such file or directory", "file not found", "#error", "#include",
+};
+const char* const UNDECLARED_WORDS[] = {
+    "was not declared", "undeclared", "does not name a type", "unknown type name",
+    "has no member", "no member named", "is not a member", "redefinition",
+    "conflicting declaration",
+};
+const char* const TYPE_WORDS[] = {
+    "cannot convert", "invalid conversion", "could not convert", "no matching",
+    "no match for", "no viable", "invalid operands", "incompatible", "cannot bind",
+    "invalid initialization", "cannot initialize", "discards qualifiers",
+    "ambiguous", "narrowing", "too many arguments", "too few arguments",
+};
+const char* const SYNTAX_WORDS[] = {
+    "expected", "stray", "missing terminating", "unterminated", "extraneous",
+    "unexpected",
+};
+
+#define ANXIETY_KIND_RULE(kind, words) {kind, words, sizeof(words) / sizeof(words[0])}
+const KindRule KIND_RULES[] = {
+    ANXIETY_KIND_RULE(DiagnosticKind::LINK, LINK_WORDS),
+    ANXIETY_KIND_RULE(DiagnosticKind::PREPROCESSOR, PREPROCESSOR_WORDS),
+    ANXIETY_KIND_RULE(DiagnosticKind::UNDECLARED, UNDECLARED_WORDS),
+    ANXIETY_KIND_RULE(DiagnosticKind::TYPE, TYPE_WORDS),
+    ANXIETY_KIND_RULE(DiagnosticKind::SYNTAX, SYNTAX_WORDS),
+};
+#undef ANXIETY_KIND_RULE
+
+bool StartsWith(std::string_view text, const char* prefix, size_t length)
+{
+    return text.size() >= length && std::memcmp(text.data(), prefix, length) == 0;
+}
+
+bool IsNumber(std::string_view text)
+{
+    if (text.empty()) return false;
+    for (char c : text) {
+        if (c < '0' || c > '9') return false;
+    }
+    return true;
+}
+
+int ToInt(std::string_view digits)
+{
+    int value = 0;
+    for (char c : digits) {
+        value = value * 10 + (c - '0');
+        if (value > 100000000) break;   // Garbage; keep it bounded
+    }
+    return value;
+}
+
+// Split "file:line:col" / "file:line" / "file" (Windows drive colons kept)
+void ParseLocation(std::string_view location, Diagnostic& out, std::string_view& file)
+{
+    int numbers[2] = {0, 0};
+    int found = 0;
+    while (found < 2) {
+        size_t colon = location.rfind(':');
+        if (colon == std::string_view::npos || !IsNumber(location.substr(colon + 1))) break;
+        numbers[found++] = ToInt(location.substr(colon + 1));
+        location = location.substr(0, colon);
+    }
+    out.line = found == 2 ? numbers[1] : (found == 1 ? numbers[0] : 0);
+    out.column = found == 2 ? numbers[0] : 0;
+    file = location;
+}
+
+bool IsOpenQuote(std::string_view text, size_t i, size_t& length)
+{
+    if (text[i] == '\'' || text[i] == '`') { length = 1; return true; }
+    // UTF-8 left single quotation mark (GCC in UTF-8 locales)
+    if (text[i] == '\xE2' && text.compare(i, 3, "\xE2\x80\x98") == 0) { length = 3; return true; }
+    length = 0;
+    return false;
+}
+
+// Closing quote at or after `from`, or npos; `length` gets its size
+size_t FindCloseQuote(std::string_view text, size_t from, size_t& length)
+{
+    for (size_t i = from; i < text.size(); ++i) {
+        if (text[i] == '\'') { length = 1; return i; }
+        if (text[i] == '\xE2' && text.compare(i, 3, "\xE2\x80\x99") == 0) { length = 3; return i; }
+    }
+    return std::string_view::npos;
+}
+
+} // namespace
+
+std::string_view DiagnosticParser::StripQuoted(std::string_view message, char* buffer, size_t capacity)
+{
+    // Quoted names and types carry no category information and can be
+    // kilobytes long in template errors; keep only the wording around them
+    size_t out = 0;
+    size_t i = 0;
+    while (i < message.size() && out < capacity) {
+        size_t openLength;
+        if (IsOpenQuote(message, i, openLength)) {
+            size_t closeLength;
+            size_t close = FindCloseQuote(message, i + openLength, closeLength);
+            if (close == std::string_view::npos) break;
+            buffer[out++] = '\'';
+            if (out < capacity) buffer[out++] = '\'';
+            i = close + closeLength;
+        } else {
+            buffer[out++] = message[i++];
+        }
+    }
+    return std::string_view(buffer, out);
+}
+
+void DiagnosticParser::HtmlToText(std::string_view html, std::string& text)
+{
+    static const struct { const char* name; size_t length; char value; } ENTITIES[] = {
+        {"&amp;", 5, '&'}, {"&lt;", 4, '<'}, {"&gt;", 4, '>'},
+        {"&quot;", 6, '"'}, {"&apos;", 6, '\''}, {"&nbsp;", 6, ' '},
+    };
+
+    text.clear();
+    text.reserve(html.size());
+    size_t i = 0;
+    while (i < html.size()) {
+        // Copy up to the next tag or entity in one append
+        size_t special = html.find_first_of("<&", i);
+        if (special == std::string_view::npos) special = html.size();
+        text.append(html.data() + i, special - i);
+        i = special;
+        if (i == html.size()) break;
+
+        if (html[i] == '<') {
+            size_t close = html.find('>', i);
+            if (close == std::string_view::npos) break;
+            // A line break not already followed by a newline ends the line
+            bool lineBreak = html.compare(i, 3, "<br") == 0;
+            i = close + 1;
+            if (lineBreak && (i == html.size() || html[i] != '\n')) text.push_back('\n');
+            continue;
+        }
+        bool decoded = false;
+        for (const auto& entity : ENTITIES) {
+            if (html.compare(i, entity.length, entity.name) == 0) {
+                text.push_back(entity.value);
+                i += entity.length;
+                decoded = true;
+                break;
+            }
+        }
+        if (!decoded) text.push_back(html[i++]);
+    }
+}
+
+namespace {
+
+uint64_t HashFile(std::string_view file)
+{
+    uint64_t hash = 14695981039346656037ULL;   // FNV-1a
+    for (unsigned char c : file) {
+        hash = (hash ^ c) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+DiagnosticParser::DiagnosticParser()
+    : m_lines(0)
+    , m_fileHashes{}
+    , m_fileCount(0)
+{
+    m_errors.reserve(MAX_KEPT_ERRORS);
+}
+
+void DiagnosticParser::Reset()
+{
+    m_partial.clear();
+    m_counts = DiagnosticCounts();
+    m_errors.clear();
+    m_lines = 0;
+    m_fileCount = 0;
+}
+
+void DiagnosticParser::Parse(const char* data, size_t size)
+{
+    Reset();
+    Feed(data, size);
+    Finish();
+}
+
+void DiagnosticParser::Feed(const char* data, size_t size)
+{
+    const char* end = data + size;
+
+    // Complete the line carried over from the previous chunk
+    if (!m_partial.empty()) {
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', size));
+        if (!newline) {
+            m_partial.append(data, size);
+            return;
+        }
+        m_partial.append(data, newline - data);
+        HandleLine(m_partial);
+        m_partial.clear();
+        data = newline + 1;
+    }
+
+    while (data < end) {
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', end - data));
+        if (!newline) {
+            m_partial.assign(data, end - data);
+            return;
+        }
+        HandleLine(std::string_view(data, newline - data));
+        data = newline + 1;
+    }
+}
+
+void DiagnosticParser::Finish()
+{
+    if (!m_partial.empty()) {
+        HandleLine(m_partial);
+        m_partial.clear();
+    }
+}
+
+void DiagnosticParser::HandleLine(std::string_view line)
+{
+    ++m_lines;
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    // The location ends at the first ": " (drive letters and "::" are not
+    // followed by a space); the marker, if any, comes right after it. Long
+    // template lines are therefore never scanned past their location.
+    Diagnostic parsed;
+    std::string_view location;
+    std::string_view message;
+    bool found = false;
+
+    size_t pos = 0;
+    for (;;) {
+        const char* colon = static_cast<const char*>(
+            std::memchr(line.data() + pos, ':', line.size() - pos));
+        if (!colon) break;
+        pos = static_cast<size_t>(colon - line.data()) + 1;
+        if (pos >= line.size() || line[pos] != ' ') continue;
+
+        std::string_view rest = line.substr(pos + 1);
+        for (const Marker& marker : MARKERS) {
+            if (StartsWith(rest, marker.text, marker.length)) {
+                parsed.severity = marker.severity;
+                location = line.substr(0, pos - 1);
+                message = rest.substr(marker.length);
+                found = true;
+                break;
+            }
+        }
+        break;
+    }
+
+    if (!found) {
+        // "main.o:main.cpp:(.text+0x1a): undefined reference to `foo'"
+        for (const char* phrase : LINK_PHRASES) {
+            size_t at = line.find(phrase);
+            if (at != std::string_view::npos) {
+                parsed.severity = DiagnosticSeverity::ERR;
+                size_t separator = line.rfind(": ", at);
+                location = separator == std::string_view::npos ? std::string_view()
+                                                               : line.substr(0, separator);
+                message = line.substr(at);
+                found = true;
+                break;
+            }
+        }
+        if (!found) return;     // Context line (In function..., required from...)
+    }
+
+    if (parsed.severity == DiagnosticSeverity::NOTE) {
+        ++m_counts.notes;
+        return;
+    }
+    if (parsed.severity == DiagnosticSeverity::WARNING) {
+        ++m_counts.warnings;
+        return;
+    }
+
+    std::string_view file;
+    ParseLocation(location, parsed, file);
+    char wording[160];
+    parsed.kind = Classify(StripQuoted(message, wording, sizeof(wording)));
+
+    ++m_counts.errors;
+    ++m_counts.errorsByKind[static_cast<size_t>(parsed.kind)];
+    if (parsed.kind != DiagnosticKind::LINK) {
+        CountFile(file);    // Link locations are objects / the linker itself
+    }
+
+    if (m_errors.size() < MAX_KEPT_ERRORS) {
+        parsed.file.assign(file.data(), file.size());
+        parsed.message.assign(message.data(), message.size());
+        m_errors.push_back(std::move(parsed));
+    }
+}
+
+void DiagnosticParser::CountFile(std::string_view file)
+{
+    if (file.empty()) return;
+
+    uint64_t hash = HashFile(file);
+    for (size_t i = 0; i < m_fileCount; ++i) {
+        if (m_fileHashes[i] == hash) return;
+    }
+    if (m_fileCount < MAX_TRACKED_FILES) {
+        m_fileHashes[m_fileCount++] = hash;
+        m_counts.filesWithErrors = static_cast<int>(m_fileCount);
+    }
+}
+
+DiagnosticKind DiagnosticParser::Classify(std::string_view message)
+{
+    for (const KindRule& rule : KIND_RULES) {
+        for (size_t i = 0; i < rule.count; ++i) {
+            if (message.find(rule.phrases[i]) != std::string_view::npos) {
+                return rule.kind;
+            }
+        }
+    }
+    return DiagnosticKind::OTHER;
+}
+
+} // namespace AnxietyMonitor
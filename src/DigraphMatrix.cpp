@@ -0,0 +1,87 @@
+#include "DigraphMatrix.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace AnxietyMonitor {
+
+DigraphMatrix::DigraphMatrix()
+{
+    Clear();
+}
+
+KeyClass DigraphMatrix::Classify(int charCode)
+{
+    if (charCode == 8 || charCode == 127) return KeyClass::BACKSPACE;
+    if (charCode == '\r' || charCode == '\n') return KeyClass::ENTER;
+    if (charCode == '\t') return KeyClass::TAB;
+    if (charCode == ' ') return KeyClass::SPACE;
+    if (charCode < 0 || charCode > 127) return KeyClass::OTHER;
+    if (charCode < ' ') return KeyClass::UNKNOWN;   // Other control keys
+
+    if (charCode >= 'A' && charCode <= 'Z') return KeyClass::UPPER;
+    if (charCode >= 'a' && charCode <= 'z') {
+        return std::strchr("qwertasdfgzxcvb", charCode) ? KeyClass::LETTER_LEFT : KeyClass::LETTER_RIGHT;
+    }
+    if (charCode >= '0' && charCode <= '9') return KeyClass::DIGIT;
+    if (std::strchr("()[]{}", charCode)) return KeyClass::BRACKET;
+    if (std::strchr(";,.:", charCode)) return KeyClass::PUNCTUATION;
+    if (std::strchr("+-*/=<>&|!^%~?", charCode)) return KeyClass::OPERATOR;
+    if (std::strchr("'\"`", charCode)) return KeyClass::QUOTE;
+    return KeyClass::SYMBOL;
+}
+
+void DigraphMatrix::Record(KeyClass first, KeyClass second, float latencyMs)
+{
+    if (first == KeyClass::UNKNOWN || second == KeyClass::UNKNOWN ||
+        first >= KeyClass::COUNT || second >= KeyClass::COUNT) {
+        return;
+    }
+
+    Stats& cell = m_cells[static_cast<size_t>(first) * KEY_CLASS_COUNT + static_cast<size_t>(second)];
+    ++cell.count;
+    float delta = latencyMs - cell.mean;
+    cell.mean += delta / cell.count;
+    cell.m2 += delta * (latencyMs - cell.mean);
+    cell.recent = cell.count == 1 ? latencyMs : cell.recent + RECENT_WEIGHT * (latencyMs - cell.recent);
+}
+
+void DigraphMatrix::Clear()
+{
+    std::memset(m_cells, 0, sizeof(m_cells));
+}
+
+size_t DigraphMatrix::TopDeviations(DigraphDeviation* out, size_t count) const
+{
+    size_t filled = 0;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = DigraphDeviation();
+    }
+    if (count == 0) return 0;
+
+    for (size_t index = 0; index < KEY_CLASS_COUNT * KEY_CLASS_COUNT; ++index) {
+        const Stats& cell = m_cells[index];
+        if (cell.count < MIN_SAMPLES) continue;
+
+        double stddev = std::max<double>(MIN_STDDEV_MS, std::sqrt(cell.m2 / (cell.count - 1)));
+        DigraphDeviation candidate;
+        candidate.first = static_cast<KeyClass>(index / KEY_CLASS_COUNT);
+        candidate.second = static_cast<KeyClass>(index % KEY_CLASS_COUNT);
+        candidate.deltaMs = static_cast<double>(cell.recent) - cell.mean;
+        candidate.zScore = candidate.deltaMs / stddev;
+
+        // Insertion into the short ranked list
+        size_t rank = filled;
+        while (rank > 0 && std::fabs(out[rank - 1].zScore) < std::fabs(candidate.zScore)) {
+            if (rank < count) out[rank] = out[rank - 1];
+            --rank;
+        }
+        if (rank < count) {
+            out[rank] = candidate;
+            filled = std::min(filled + 1, count);
+        }
+    }
+    return filled;
+}
+
+} // namespace AnxietyMonitor
@@ -0,0 +1,68 @@
+#ifndef DIGRAPH_MATRIX_H
+#define DIGRAPH_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include "MetricsData.h"
+
+namespace AnxietyMonitor {
+
+/**
+ * @class DigraphMatrix
+ * @brief Per key-pair (digraph) latency statistics over a compact key
+ * alphabet.
+ *
+ * One flat KEY_CLASS_COUNT x KEY_CLASS_COUNT array of 16-byte cells
+ * (3.6 KB, resident in L1) holds, per digraph, a session mean / variance
+ * (Welford) and an exponentially weighted recent mean. Record() touches a
+ * single cell: O(1), no allocation, no branches on history.
+ *
+ * TopDeviations() scans the matrix for the digraphs whose recent latency
+ * drifted furthest from their session baseline, in standard deviations.
+ * It runs when a snapshot is built, not per keystroke.
+ */
+class DigraphMatrix {
+public:
+    static const uint32_t MIN_SAMPLES = 20;     // Before a digraph is ranked
+    static constexpr float RECENT_WEIGHT = 0.1f;    // EWMA: ~last 10 samples
+    static constexpr float MIN_STDDEV_MS = 10.0f;   // Floor for z-scores
+
+    DigraphMatrix();
+
+    // Key class of an editor character code (8 / 127 = backspace / delete)
+    static KeyClass Classify(int charCode);
+
+    // Latency from `first` to `second`; UNKNOWN on either side is ignored
+    void Record(KeyClass first, KeyClass second, float latencyMs);
+
+    void Clear();
+
+    uint32_t GetCount(KeyClass first, KeyClass second) const { return Cell(first, second).count; }
+    double GetMeanMs(KeyClass first, KeyClass second) const { return Cell(first, second).mean; }
+    double GetRecentMs(KeyClass first, KeyClass second) const { return Cell(first, second).recent; }
+
+    /**
+     * @brief Fill `out` with up to `count` digraphs with at least
+     * MIN_SAMPLES samples, largest |z| first; unused ranks are cleared.
+     * @return Number of ranks filled
+     */
+    size_t TopDeviations(DigraphDeviation* out, size_t count) const;
+
+private:
+    struct Stats {
+        uint32_t count;
+        float mean;         // Session mean (ms)
+        float m2;           // Sum of squared deviations (Welford)
+        float recent;       // EWMA of recent latencies (ms)
+    };
+
+    const Stats& Cell(KeyClass first, KeyClass second) const {
+        return m_cells[static_cast<size_t>(first) * KEY_CLASS_COUNT + static_cast<size_t>(second)];
+    }
+
+    Stats m_cells[KEY_CLASS_COUNT * KEY_CLASS_COUNT];
+};
+
+} // namespace AnxietyMonitor
+
+#endif // DIGRAPH_MATRIX_H
@@ -0,0 +1,146 @@
+#include "ErrorFingerprintCache.h"
+#include <algorithm>
+
+namespace AnxietyMonitor {
+
+namespace {
+
+const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+// FNV-1a over `text` without its digits (line numbers, template depths,
+// linker offsets change from build to build)
+uint64_t HashWithoutDigits(uint64_t hash, std::string_view text)
+{
+    for (unsigned char c : text) {
+        if (c >= '0' && c <= '9') continue;
+        hash = (hash ^ c) * FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t HashByte(uint64_t hash, unsigned char c)
+{
+    return (hash ^ c) * FNV_PRIME;
+}
+
+} // namespace
+
+ErrorFingerprintCache::ErrorFingerprintCache()
+    : m_slots{}
+    , m_size(0)
+    , m_build(0)
+{
+    m_previous.reserve(DiagnosticParser::MAX_KEPT_ERRORS);
+    m_current.reserve(DiagnosticParser::MAX_KEPT_ERRORS);
+}
+
+uint64_t ErrorFingerprintCache::Fingerprint(std::string_view file, int line, std::string_view message)
+{
+    // File name only: the same file may be reported by relative or full path
+    size_t slash = file.find_last_of("/\\");
+    if (slash != std::string_view::npos) file.remove_prefix(slash + 1);
+
+    uint64_t hash = HashWithoutDigits(FNV_OFFSET, file);
+    hash = HashByte(hash, 0);
+
+    unsigned int bucket = static_cast<unsigned int>(std::max(0, line) / LINE_BUCKET);
+    for (int i = 0; i < 4; ++i) {
+        hash = HashByte(hash, static_cast<unsigned char>(bucket >> (8 * i)));
+    }
+
+    char wording[256];
+    hash = HashWithoutDigits(hash, DiagnosticParser::StripQuoted(message, wording, sizeof(wording)));
+
+    return hash != 0 ? hash : 1;    // 0 marks an empty slot
+}
+
+uint64_t ErrorFingerprintCache::Fingerprint(const Diagnostic& error)
+{
+    return Fingerprint(error.file, error.line, error.message);
+}
+
+ErrorRecurrence ErrorFingerprintCache::Record(const uint64_t* fingerprints, size_t count)
+{
+    ErrorRecurrence result;
+    ++m_build;
+    m_current.clear();
+
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = fingerprints[i] != 0 ? fingerprints[i] : 1;
+        size_t index = Find(key);
+        if (index != SLOT_COUNT) {
+            if (m_slots[index].lastBuild == m_build) continue;     // Same build
+            m_slots[index].lastBuild = m_build;
+            ++result.repeatedErrors;
+        } else {
+            if (m_size >= MAX_ENTRIES) EvictLeastRecent();
+            if (m_size < MAX_ENTRIES) Insert(key, m_build);     // Else too many in one build
+            ++result.newErrors;
+        }
+        m_current.push_back(key);
+    }
+
+    // Errors of the previous build not touched by this one
+    for (uint64_t key : m_previous) {
+        size_t index = Find(key);
+        if (index == SLOT_COUNT || m_slots[index].lastBuild != m_build) {
+            ++result.resolvedErrors;
+        }
+    }
+
+    m_previous.swap(m_current);
+    return result;
+}
+
+void ErrorFingerprintCache::Clear()
+{
+    std::fill(m_slots, m_slots + SLOT_COUNT, Slot{0, 0});
+    m_size = 0;
+    m_build = 0;
+    m_previous.clear();
+    m_current.clear();
+}
+
+size_t ErrorFingerprintCache::Find(uint64_t key) const
+{
+    for (size_t i = Home(key);; i = (i + 1) & (SLOT_COUNT - 1)) {
+        if (m_slots[i].key == key) return i;
+        if (m_slots[i].key == 0) return SLOT_COUNT;
+    }
+}
+
+void ErrorFingerprintCache::Insert(uint64_t key, uint32_t build)
+{
+    size_t i = Home(key);
+    while (m_slots[i].key != 0) {
+        i = (i + 1) & (SLOT_COUNT - 1);
+    }
+    m_slots[i].key = key;
+    m_slots[i].lastBuild = build;
+    ++m_size;
+}
+
+void ErrorFingerprintCache::EvictLeastRecent()
+{
+    Slot live[MAX_ENTRIES];
+    size_t count = 0;
+    for (size_t i = 0; i < SLOT_COUNT && count < MAX_ENTRIES; ++i) {
+        if (m_slots[i].key != 0) live[count++] = m_slots[i];
+    }
+
+    // Last-seen build at the quarter mark; everything up to it goes
+    size_t quarter = count / 4;
+    std::nth_element(live, live + quarter, live + count,
+                     [](const Slot& a, const Slot& b) { return a.lastBuild < b.lastBuild; });
+    uint32_t cutoff = std::min(live[quarter].lastBuild, m_build - 1);
+
+    // Reinserting the survivors leaves no deletion holes in probe runs
+    std::fill(m_slots, m_slots + SLOT_COUNT, Slot{0, 0});
+    m_size = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (live[i].lastBuild > cutoff) Insert(live[i].key, live[i].lastBuild);
+    }
+}
+
+} // namespace AnxietyMonitor
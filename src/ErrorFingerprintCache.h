@@ -0,0 +1,79 @@
+#ifndef ERROR_FINGERPRINT_CACHE_H
+#define ERROR_FINGERPRINT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "DiagnosticParser.h"
+#include "MetricsData.h"
+
+namespace AnxietyMonitor {
+
+/**
+ * @class ErrorFingerprintCache
+ * @brief Remembers recent build errors by fingerprint to tell new,
+ * repeated and resolved errors apart.
+ *
+ * A fingerprint is an FNV-1a hash of the file name, a bucket of
+ * LINE_BUCKET lines and the message with digits and quoted names
+ * stripped, so "'x' was not declared" on line 41 and "'y' was not
+ * declared" on line 43 of the same file are the same error.
+ *
+ * Fingerprints live in a fixed open-addressing table (linear probing, at
+ * most half full). Each entry carries the build it was last seen in; when
+ * the table fills, the least recently seen quarter is dropped in one
+ * rebuild pass, so eviction is amortized O(1) per new error. Memory is
+ * constant however long the session runs, and Record() is O(errors in
+ * the build).
+ */
+class ErrorFingerprintCache {
+public:
+    static const size_t SLOT_COUNT = 1024;      // Power of two
+    static const size_t MAX_ENTRIES = 512;      // Load factor <= 0.5
+    static const int LINE_BUCKET = 8;
+
+    ErrorFingerprintCache();
+
+    static uint64_t Fingerprint(std::string_view file, int line, std::string_view message);
+    static uint64_t Fingerprint(const Diagnostic& error);
+
+    /**
+     * @brief Record the errors of one build (duplicates count once).
+     * @return New / repeated errors of this build, and errors of the
+     * previous recorded build that no longer appear
+     */
+    ErrorRecurrence Record(const uint64_t* fingerprints, size_t count);
+
+    void Clear();
+
+    size_t Size() const { return m_size; }
+
+private:
+    struct Slot {
+        uint64_t key;           // 0 = empty
+        uint32_t lastBuild;
+    };
+
+    static const int SLOT_BITS = 10;            // log2(SLOT_COUNT)
+
+    // Fibonacci hashing: top bits of key * 2^64/phi, so keys that differ
+    // only in their high bits do not share a probe run
+    static size_t Home(uint64_t key) { return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> (64 - SLOT_BITS)); }
+
+    size_t Find(uint64_t key) const;    // Slot index or SLOT_COUNT
+    void Insert(uint64_t key, uint32_t build);
+    void EvictLeastRecent();            // Oldest quarter, current build kept
+
+    Slot m_slots[SLOT_COUNT];
+    size_t m_size;
+    uint32_t m_build;                   // Builds recorded so far
+
+    // Distinct fingerprints of the previous / current build
+    std::vector<uint64_t> m_previous;
+    std::vector<uint64_t> m_current;
+};
+
+} // namespace AnxietyMonitor
+
+#endif // ERROR_FINGERPRINT_CACHE_H
@@ -1,5 +1,19 @@
 #include "EventHandlers.h"
 #include "DataCollector.h"
+#include "ErrorFingerprintCache.h"
+#include "Instrumentation.h"
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <fstream>
+
+#ifdef CODEBLOCKS_SDK_INCLUDED
+#include <cbproject.h>
+#include <configmanager.h>
+#include <manager.h>
+#include <projectmanager.h>
+#include <wx/filename.h>
+#endif
 
 // Code::Blocks SDK compatibility layer
 // In real build, these come from <sdk.h> and Code::Blocks headers
@@ -15,6 +29,7 @@ public:
 
   // Stub methods
   wxString GetEditor() const { return wxEmptyString; }
+  cbProject *GetProject() const { return nullptr; }
   int GetInt() const { return 0; }
   wxString GetString() const { return wxEmptyString; }
 };
@@ -30,72 +45,191 @@ public:
 
 namespace AnxietyMonitor {
 
+namespace {
+// High-frequency notifications (cursor moves, idle events) are folded into
+// at most one queued event per interval
+const long long ACTIVITY_INTERVAL_MS = 1000;
+
+#ifdef CODEBLOCKS_SDK_INCLUDED
+// HTML build log the compiler writes next to the project file when a build
+// finishes (<project>_build_log.html). The path is the same in every UI
+// language, unlike the log tab's title. It is returned even when saving is
+// off: a log the user enables mid-session is picked up, and a stale one is
+// rejected by its timestamp.
+std::string BuildLogPath(CodeBlocksEvent &event) {
+  cbProject *project = event.GetProject();
+  if (!project) {
+    project = Manager::Get()->GetProjectManager()->GetActiveProject();
+  }
+  if (!project) {
+    return std::string();
+  }
+  wxFileName file(project->GetFilename());
+  file.SetName(file.GetName() + wxT("_build_log"));
+  file.SetExt(wxT("html"));
+  return std::string(file.GetFullPath().utf8_str());
+}
+
+// "Save build log to HTML file when finished" (off by default)
+bool BuildLogSaved() {
+  ConfigManager *config = Manager::Get()->GetConfigManager(wxT("compiler"));
+  return config && config->ReadBool(wxT("/save_html_build_log"), false);
+}
+#else
+std::string BuildLogPath(CodeBlocksEvent &) { return std::string(); }
+bool BuildLogSaved() { return false; }
+#endif
+
+// Whole file into `contents` (capacity reused); false if unreadable
+bool ReadWholeFile(const std::string &path, std::string &contents) {
+  std::ifstream in(path, std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  in.seekg(0, std::ios::end);
+  std::streamoff size = in.tellg();
+  if (size < 0) {
+    return false;
+  }
+  contents.resize(static_cast<size_t>(size));
+  in.seekg(0, std::ios::beg);
+  in.read(&contents[0], size);
+  return in.gcount() == size;
+}
+
+// Start of the build on the file clock, rounded down to whole seconds so
+// file systems with coarse timestamps still date its log at or after it
+std::filesystem::file_time_type CompileStartTime() {
+  using FileTime = std::filesystem::file_time_type;
+  FileTime now = FileTime::clock::now();
+  return FileTime(std::chrono::duration_cast<std::chrono::seconds>(
+      now.time_since_epoch()));
+}
+
+// True if the file was last written at or after `since`
+bool WrittenSince(const std::string &path,
+                  std::filesystem::file_time_type since) {
+  if (since == std::filesystem::file_time_type::min()) {
+    return false;
+  }
+  std::error_code error;
+  std::filesystem::file_time_type written =
+      std::filesystem::last_write_time(std::filesystem::u8path(path), error);
+  return !error && written >= since;
+}
+} // namespace
+
 EventHandlers::EventHandlers(DataCollector *collector)
-    : m_collector(collector) {}
+    : m_collector(collector), m_burstFilter(&m_queue) {}
+
+void EventHandlers::Enqueue(CollectorEventType type, bool flag, int count,
+                            int count2) {
+  CollectorEvent event;
+  event.type = type;
+  event.when = std::chrono::steady_clock::now();
+  event.flag = flag;
+  event.count = count;
+  event.count2 = count2;
+  m_queue.TryPush(std::move(event));
+}
+
+void EventHandlers::EnqueueText(CollectorEventType type,
+                                const std::string &text) {
+  CollectorEvent event;
+  event.type = type;
+  event.when = std::chrono::steady_clock::now();
+  event.text = text;
+  m_queue.TryPush(std::move(event));
+}
+
+bool EventHandlers::ActivityDue(std::chrono::steady_clock::time_point &last,
+                                std::chrono::steady_clock::time_point now) {
+  if (now - last < std::chrono::milliseconds(ACTIVITY_INTERVAL_MS)) {
+    return false;
+  }
+  last = now;
+  return true;
+}
 
 void EventHandlers::OnEditorUpdateUI(CodeBlocksEvent &event) {
-  // DISABLED for debugging freeze
-  /*
-  if (m_collector && m_collector->IsRunning()) {
+  ANXIETY_PROBE(EDITOR_CALLBACK);
+  ANXIETY_TRACE("EventHandlers::OnEditorUpdateUI");
+
+  if (m_collector && m_collector->IsRunning() &&
+      ActivityDue(m_lastUiActivity, std::chrono::steady_clock::now())) {
+    Enqueue(CollectorEventType::ACTIVITY);
   }
-  */
   event.Skip();
 }
 
 void EventHandlers::OnEditorCharAdded(CodeBlocksEvent &event) {
+  ANXIETY_PROBE(EDITOR_CALLBACK);
+  ANXIETY_TRACE("EventHandlers::OnEditorCharAdded");
+
   // Character was added to editor - this is our main keystroke capture
   if (m_collector && m_collector->IsRunning()) {
     int charCode = event.GetInt();
     bool isBackspace = (charCode == 8 || charCode == 127);
-    m_collector->OnKeystroke(isBackspace);
+    m_burstFilter.OnChar(charCode, isBackspace,
+                         std::chrono::steady_clock::now());
   }
   event.Skip();
 }
 
 void EventHandlers::OnCompilerStart(CodeBlocksEvent &event) {
-  // DISABLED: Suspected deadlock source
-  /*
+  ANXIETY_PROBE(EDITOR_CALLBACK);
+  ANXIETY_TRACE("EventHandlers::OnCompilerStart");
+
+  m_compileStartedAt = CompileStartTime();
   if (m_collector && m_collector->IsRunning()) {
-      m_collector->OnCompileStart();
+    Enqueue(CollectorEventType::COMPILE_START);
   }
-  */
   event.Skip();
 }
 
 void EventHandlers::OnCompilerFinished(CodeBlocksEvent &event) {
-  // DISABLED: Suspected deadlock source
-  /*
+  ANXIETY_PROBE(EDITOR_CALLBACK);
+  ANXIETY_TRACE("EventHandlers::OnCompilerFinished");
+
+  // Only note where the log is; reading and parsing wait for the drain
   if (m_collector && m_collector->IsRunning()) {
-      int errorCount = event.GetInt();
-      bool success = (errorCount == 0);
-      int warningCount = 0;
-      m_collector->OnCompileEnd(errorCount, warningCount, success);
+    PendingBuild build;
+    build.when = std::chrono::steady_clock::now();
+    build.errors = event.GetInt();
+    build.logPath = BuildLogPath(event);
+    build.logSaved = BuildLogSaved();
+    build.startedAt = m_compileStartedAt;
+    m_pendingBuilds.push_back(std::move(build));
   }
-  */
+  m_compileStartedAt = std::filesystem::file_time_type::min();
   event.Skip();
 }
 
 void EventHandlers::OnAppStartupDone(CodeBlocksEvent &event) { event.Skip(); }
 
 void EventHandlers::OnIdle(wxIdleEvent &event) {
-  // DISABLED: Suspected freeze source
-  /*
-  if (m_collector && m_collector->IsRunning()) {
-      m_collector->OnIdleTick();
+  ANXIETY_PROBE(EDITOR_CALLBACK);
+  ANXIETY_TRACE("EventHandlers::OnIdle");
+
+  if (m_collector && m_collector->IsRunning() &&
+      ActivityDue(m_lastIdleTick, std::chrono::steady_clock::now())) {
+    Enqueue(CollectorEventType::IDLE_TICK);
   }
-  */
   event.Skip();
 }
 
 void EventHandlers::OnEditorActivated(CodeBlocksEvent &event) {
+  ANXIETY_PROBE(EDITOR_CALLBACK);
+  ANXIETY_TRACE("EventHandlers::OnEditorActivated");
+
   if (m_collector) {
-    m_collector->OnEditorFocusChange(true);
+    Enqueue(CollectorEventType::FOCUS_CHANGE, true);
 
     // Track file change (tab switch)
     wxString currentFile = event.GetString(); // In CB SDK, this may vary
     if (!currentFile.IsEmpty() && currentFile != m_lastActiveFile) {
-      m_collector->OnTabChange();
-      m_collector->SetActiveFile(currentFile.ToStdString());
+      Enqueue(CollectorEventType::TAB_CHANGE);
+      EnqueueText(CollectorEventType::ACTIVE_FILE, currentFile.ToStdString());
       m_lastActiveFile = currentFile;
     }
   }
@@ -104,18 +238,25 @@ void EventHandlers::OnEditorActivated(CodeBlocksEvent &event) {
 }
 
 void EventHandlers::OnEditorDeactivated(CodeBlocksEvent &event) {
+  ANXIETY_PROBE(EDITOR_CALLBACK);
+  ANXIETY_TRACE("EventHandlers::OnEditorDeactivated");
+
   if (m_collector) {
-    m_collector->OnEditorFocusChange(false);
+    Enqueue(CollectorEventType::FOCUS_CHANGE, false);
   }
 
   event.Skip();
 }
 
 void EventHandlers::OnProjectActivated(CodeBlocksEvent &event) {
+  ANXIETY_PROBE(EDITOR_CALLBACK);
+  ANXIETY_TRACE("EventHandlers::OnProjectActivated");
+
   if (m_collector) {
     wxString projectName = event.GetString();
     if (!projectName.IsEmpty()) {
-      m_collector->SetActiveProject(projectName.ToStdString());
+      EnqueueText(CollectorEventType::ACTIVE_PROJECT,
+                  projectName.ToStdString());
     }
   }
 
@@ -123,6 +264,9 @@ void EventHandlers::OnProjectActivated(CodeBlocksEvent &event) {
 }
 
 void EventHandlers::OnKeyDown(wxKeyEvent &event) {
+  ANXIETY_PROBE(EDITOR_CALLBACK);
+  ANXIETY_TRACE("EventHandlers::OnKeyDown");
+
   if (m_collector && m_collector->IsRunning()) {
     int keyCode = event.GetKeyCode();
 
@@ -130,18 +274,75 @@ void EventHandlers::OnKeyDown(wxKeyEvent &event) {
     if (event.ControlDown() && keyCode == 'Z') {
       if (event.ShiftDown()) {
         // Ctrl+Shift+Z = Redo
-        m_collector->OnRedo();
+        Enqueue(CollectorEventType::REDO);
       } else {
-        m_collector->OnUndo();
+        Enqueue(CollectorEventType::UNDO);
       }
     }
     // Detect Redo (Ctrl+Y)
     else if (event.ControlDown() && keyCode == 'Y') {
-      m_collector->OnRedo();
+      Enqueue(CollectorEventType::REDO);
     }
   }
 
   event.Skip();
 }
 
+size_t EventHandlers::ProcessPendingEvents() {
+  ANXIETY_PROBE(EVENT_DRAIN);
+  ANXIETY_TRACE("EventHandlers::ProcessPendingEvents");
+  m_burstFilter.Flush(std::chrono::steady_clock::now());
+  CompletePendingBuilds();
+  return m_collector ? m_collector->ProcessEvents(m_queue) : 0;
+}
+
+void EventHandlers::CompletePendingBuilds() {
+  m_finishedBuilds.clear();
+  for (PendingBuild &build : m_pendingBuilds) {
+    // Without a build log only the event's integer is known
+    CollectorEvent end;
+    end.type = CollectorEventType::COMPILE_END;
+    end.when = build.when;
+    end.count = build.errors;
+    end.flag = (end.count == 0);
+
+    // Parsing is a single memchr-driven pass (milliseconds for multi-MB
+    // logs); the event keeps its callback timestamp. A log older than the
+    // build's start is left over from an earlier build and is skipped.
+    if (!build.logPath.empty() &&
+        WrittenSince(build.logPath, build.startedAt) &&
+        ReadWholeFile(build.logPath, m_buildLogHtml)) {
+      DiagnosticParser::HtmlToText(m_buildLogHtml, m_buildLogText);
+      m_diagnosticParser.Parse(m_buildLogText.data(), m_buildLogText.size());
+      const DiagnosticCounts &counts = m_diagnosticParser.GetCounts();
+      end.flag = end.flag && counts.errors == 0;
+      end.count = std::max(end.count, counts.errors);
+      end.count2 = counts.warnings;
+
+      // Kept errors travel as fingerprints; the collector compares them
+      // with earlier builds
+      auto diagnostics = std::make_shared<BuildDiagnostics>();
+      diagnostics->counts = counts;
+      const std::vector<Diagnostic> &errors = m_diagnosticParser.GetErrors();
+      diagnostics->errorFingerprints.reserve(errors.size());
+      for (const Diagnostic &error : errors) {
+        diagnostics->errorFingerprints.push_back(
+            ErrorFingerprintCache::Fingerprint(error));
+      }
+      end.diagnostics = std::move(diagnostics);
+    }
+
+    FinishedBuild finished;
+    finished.errors = end.count;
+    finished.warnings = end.count2;
+    if (!end.diagnostics && !build.logSaved && m_buildLogNoticeDue) {
+      finished.buildLogDisabled = true;
+      m_buildLogNoticeDue = false;
+    }
+    m_finishedBuilds.push_back(finished);
+    m_queue.TryPush(std::move(end));
+  }
+  m_pendingBuilds.clear();
+}
+
 } // namespace AnxietyMonitor
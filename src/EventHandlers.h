@@ -11,6 +11,15 @@
 #include <cbplugin.h>
 #endif
 
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "BurstFilter.h"
+#include "DiagnosticParser.h"
+#include "EventQueue.h"
+
 // Forward declarations for Code::Blocks SDK types
 // These are simplified - actual CB SDK has more complex headers
 class cbEditor;
@@ -30,13 +39,30 @@ class DataCollector;
  * - cbEVT_EDITOR_UPDATE_UI: Typing activity
  * - cbEVT_EDITOR_CHAR_ADDED: Keystroke capture
  * - cbEVT_COMPILER_START: Compile start
- * - cbEVT_COMPILER_FINISHED: Compile end + errors
+ * - cbEVT_COMPILER_FINISHED: Compile end + build log diagnostics (from the
+ *   HTML build log the compiler saves when "Save build log to HTML file
+ *   when finished" is enabled; otherwise only the event's error count)
  * - cbEVT_APP_STARTUP_DONE: App ready
  * - cbEVT_IDLE: Idle detection
  * - cbEVT_EDITOR_ACTIVATED: Focus changes
+ *
+ * Callbacks never take the collector lock: each one stamps the time and
+ * pushes a CollectorEvent onto a bounded lock-free queue. The plugin drains
+ * the queue from a timer via ProcessPendingEvents(). A finished build only
+ * records where its log is; the log is read, parsed and fingerprinted in
+ * ProcessPendingEvents().
  */
 class EventHandlers {
 public:
+  // Outcome of one build as applied to the collector
+  struct FinishedBuild {
+    int errors = 0;
+    int warnings = 0;
+    // Set on the first build without a log because the compiler does not
+    // save one, so the plugin can say how to turn diagnostics on
+    bool buildLogDisabled = false;
+  };
+
   EventHandlers(DataCollector *collector);
   ~EventHandlers() = default;
 
@@ -54,11 +80,70 @@ public:
   // Additional handlers for specific key detection
   void OnKeyDown(wxKeyEvent &event);
 
+  /**
+   * @brief Close idle input bursts and apply queued events to the collector.
+   * Called from the plugin's timers, never from an SDK callback.
+   * @return Number of events applied
+   */
+  size_t ProcessPendingEvents();
+
+  // Builds applied by the last ProcessPendingEvents() call, oldest first
+  const std::vector<FinishedBuild> &GetFinishedBuilds() const {
+    return m_finishedBuilds;
+  }
+
+  // Events rejected because the queue was full
+  unsigned long long GetDroppedEventCount() const { return m_queue.dropped(); }
+
+private:
+  void Enqueue(CollectorEventType type, bool flag = false, int count = 0,
+               int count2 = 0);
+  void EnqueueText(CollectorEventType type, const std::string &text);
+
+  // Parse the logs of finished builds and queue their COMPILE_END events
+  void CompletePendingBuilds();
+
+  // Rate-limit high-frequency activity notifications (UI updates, idle)
+  bool ActivityDue(std::chrono::steady_clock::time_point &last,
+                   std::chrono::steady_clock::time_point now);
+
 private:
   DataCollector *m_collector;
 
+  // SDK callbacks -> collector; declared before the filter that feeds it
+  CollectorEventQueue m_queue;
+
+  // Coalesces paste floods / held-down keys before they reach the collector
+  KeystrokeBurstFilter m_burstFilter;
+
+  // Build finished in a callback, log not read yet
+  struct PendingBuild {
+    std::chrono::steady_clock::time_point when;
+    int errors;          // From the event (exit status based)
+    std::string logPath; // Empty: no project to take it from
+    bool logSaved;       // Compiler option to save the log is on
+    std::filesystem::file_time_type startedAt; // min(): start not seen
+  };
+  std::vector<PendingBuild> m_pendingBuilds;
+
+  // When the running build started (file clock, whole seconds); a log
+  // written before it belongs to an earlier build
+  std::filesystem::file_time_type m_compileStartedAt =
+      std::filesystem::file_time_type::min();
+  std::vector<FinishedBuild> m_finishedBuilds;
+  bool m_buildLogNoticeDue = true;
+
+  // Build log -> per-kind diagnostic counts (buffers reused across builds)
+  DiagnosticParser m_diagnosticParser;
+  std::string m_buildLogHtml;
+  std::string m_buildLogText;
+
   // Track last file for change detection
   wxString m_lastActiveFile;
+
+  // Last enqueued UI-activity / idle notifications
+  std::chrono::steady_clock::time_point m_lastUiActivity;
+  std::chrono::steady_clock::time_point m_lastIdleTick;
 };
 
 } // namespace AnxietyMonitor
@@ -0,0 +1,175 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace AnxietyMonitor {
+
+struct BuildDiagnostics;
+
+// ============================================================================
+// Collector Event (one SDK callback, captured at enqueue time)
+// ============================================================================
+enum class CollectorEventType {
+    KEYSTROKE,          // flag = isBackspace, count = KeyClass
+    BULK_INSERT,        // count = characters in the burst
+    UNDO,
+    REDO,
+    COMPILE_START,
+    COMPILE_END,        // count = errors, count2 = warnings, flag = success,
+                        // diagnostics = parsed build log (optional)
+    FOCUS_CHANGE,       // flag = hasFocus
+    TAB_CHANGE,
+    IDLE_TICK,
+    ACTIVITY,           // Editor UI activity (cursor, selection)
+    ACTIVE_FILE,        // text = file path
+    ACTIVE_PROJECT      // text = project name
+};
+
+// Helper function to get event type label (trace files)
+inline const char* GetCollectorEventTypeLabel(CollectorEventType type) {
+    switch (type) {
+        case CollectorEventType::KEYSTROKE:      return "keystroke";
+        case CollectorEventType::BULK_INSERT:    return "bulk_insert";
+        case CollectorEventType::UNDO:           return "undo";
+        case CollectorEventType::REDO:           return "redo";
+        case CollectorEventType::COMPILE_START:  return "compile_start";
+        case CollectorEventType::COMPILE_END:    return "compile_end";
+        case CollectorEventType::FOCUS_CHANGE:   return "focus_change";
+        case CollectorEventType::TAB_CHANGE:     return "tab_change";
+        case CollectorEventType::IDLE_TICK:      return "idle_tick";
+        case CollectorEventType::ACTIVITY:       return "activity";
+        case CollectorEventType::ACTIVE_FILE:    return "active_file";
+        case CollectorEventType::ACTIVE_PROJECT: return "active_project";
+        default:                                 return "unknown";
+    }
+}
+
+struct CollectorEvent {
+    CollectorEventType type = CollectorEventType::ACTIVITY;
+    std::chrono::steady_clock::time_point when;
+    int count = 0;
+    int count2 = 0;
+    bool flag = false;
+    std::string text;   // Only used by context events (rare)
+    std::shared_ptr<const BuildDiagnostics> diagnostics;   // COMPILE_END only
+};
+
+/**
+ * @class BoundedEventQueue
+ * @brief Lock-free bounded multi-producer/multi-consumer queue.
+ *
+ * Based on Dmitry Vyukov's bounded MPMC ring: each cell carries a sequence
+ * number, so producers and consumers only CAS a position counter and never
+ * wait on each other. Storage is allocated once at construction; a full
+ * queue rejects the event (counted as dropped) instead of blocking the
+ * caller.
+ */
+template<typename T>
+class BoundedEventQueue {
+public:
+    explicit BoundedEventQueue(size_t capacity = 8192)
+        : m_capacity(RoundUpPow2(capacity))
+        , m_mask(m_capacity - 1)
+        , m_cells(new Cell[m_capacity])
+        , m_enqueuePos(0)
+        , m_dequeuePos(0)
+        , m_dropped(0)
+    {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedEventQueue(const BoundedEventQueue&) = delete;
+    BoundedEventQueue& operator=(const BoundedEventQueue&) = delete;
+
+    /**
+     * @brief Enqueue without blocking.
+     * @return false if the queue was full (event dropped)
+     */
+    bool TryPush(T&& value) {
+        Cell* cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue without blocking.
+     * @return false if the queue was empty
+     */
+    bool TryPop(T& out) {
+        Cell* cell;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->data);
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return m_capacity; }
+
+    // Events rejected because the queue was full
+    unsigned long long dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    static size_t RoundUpPow2(size_t n) {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    // Keep producer and consumer counters on separate cache lines
+    const size_t m_capacity;
+    const size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<size_t> m_enqueuePos;
+    alignas(64) std::atomic<size_t> m_dequeuePos;
+    alignas(64) std::atomic<unsigned long long> m_dropped;
+};
+
+using CollectorEventQueue = BoundedEventQueue<CollectorEvent>;
+
+} // namespace AnxietyMonitor
+
+#endif // EVENT_QUEUE_H
@@ -0,0 +1,123 @@
+#include "Instrumentation.h"
+#include <algorithm>
+#include <cmath>
+
+namespace AnxietyMonitor {
+
+LatencyHistogram Instrumentation::s_histograms[PROBE_SITE_COUNT];
+
+// ============================================================================
+// ProbeClock
+// ============================================================================
+
+namespace {
+
+// Calibration reference, taken when the plugin library is loaded
+const uint64_t g_calibrationTicks = ProbeClock::Now();
+const std::chrono::steady_clock::time_point g_calibrationTime =
+    std::chrono::steady_clock::now();
+
+} // namespace
+
+double ProbeClock::NsPerTick()
+{
+#ifdef ANXIETY_PROBE_USE_TSC
+    uint64_t ticks = Now() - g_calibrationTicks;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - g_calibrationTime).count();
+    
+    if (ticks == 0 || ns <= 0) return 1.0;
+    return static_cast<double>(ns) / static_cast<double>(ticks);
+#else
+    return 1.0;
+#endif
+}
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+double LatencyHistogram::BucketUpperBound(int bucket)
+{
+    if (bucket == 0) return 0.0;
+    return std::ldexp(1.0, bucket) - 1.0;
+}
+
+uint64_t LatencyHistogram::Percentile(double fraction) const
+{
+    uint64_t total = 0;
+    uint64_t counts[BUCKET_COUNT];
+    for (int b = 0; b < BUCKET_COUNT; ++b) {
+        counts[b] = m_buckets[b].load(std::memory_order_relaxed);
+        total += counts[b];
+    }
+    if (total == 0) return 0;
+    
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * total));
+    if (rank == 0) rank = 1;
+    
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKET_COUNT; ++b) {
+        seen += counts[b];
+        if (seen >= rank) {
+            // Report the bucket's upper bound, never above the observed max
+            double upper = BucketUpperBound(b);
+            uint64_t max = m_max.load(std::memory_order_relaxed);
+            return std::min(static_cast<uint64_t>(upper), max);
+        }
+    }
+    return m_max.load(std::memory_order_relaxed);
+}
+
+unsigned long long LatencyHistogram::GetCount() const
+{
+    unsigned long long total = 0;
+    for (const auto& bucket : m_buckets) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+OverheadStats LatencyHistogram::Summarize(double nsPerTick) const
+{
+    OverheadStats stats;
+    stats.count = GetCount();
+    stats.p50Ns = Percentile(0.50) * nsPerTick;
+    stats.p99Ns = Percentile(0.99) * nsPerTick;
+    stats.maxNs = m_max.load(std::memory_order_relaxed) * nsPerTick;
+    return stats;
+}
+
+void LatencyHistogram::Reset() noexcept
+{
+    for (auto& bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Instrumentation
+// ============================================================================
+
+OverheadStats Instrumentation::GetStats(ProbeSite site)
+{
+    return Histogram(site).Summarize(ProbeClock::NsPerTick());
+}
+
+void Instrumentation::GetAllStats(OverheadStats (&stats)[PROBE_SITE_COUNT])
+{
+    double nsPerTick = ProbeClock::NsPerTick();
+    for (size_t i = 0; i < PROBE_SITE_COUNT; ++i) {
+        stats[i] = s_histograms[i].Summarize(nsPerTick);
+    }
+}
+
+void Instrumentation::Reset()
+{
+    for (auto& histogram : s_histograms) {
+        histogram.Reset();
+    }
+}
+
+} // namespace AnxietyMonitor
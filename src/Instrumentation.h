@@ -0,0 +1,169 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "MetricsData.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define ANXIETY_PROBE_USE_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace AnxietyMonitor {
+
+/**
+ * @class ProbeClock
+ * @brief Cheapest available monotonic tick source.
+ *
+ * Reads the CPU timestamp counter on x86 (a few ns, no syscall) and
+ * steady_clock nanoseconds elsewhere. Ticks are converted to nanoseconds
+ * only when statistics are read, never on the hot path.
+ */
+class ProbeClock {
+public:
+    static uint64_t Now() noexcept {
+#ifdef ANXIETY_PROBE_USE_TSC
+        return static_cast<uint64_t>(__rdtsc());
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+    
+    /**
+     * @brief Nanoseconds per tick, calibrated against steady_clock over the
+     * time since the plugin was loaded.
+     */
+    static double NsPerTick();
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief Lock-free log2-bucketed latency histogram.
+ *
+ * Bucket b counts samples in [2^(b-1), 2^b) ticks, so percentiles are
+ * accurate to within a factor of two - plenty to show overhead is in the
+ * nanosecond, microsecond or millisecond range.
+ *
+ * Recording is one relaxed load/store increment plus a compare on the
+ * running maximum - no locked read-modify-write. Probe sites run on the UI
+ * thread; if two threads ever record into the same bucket at once a count
+ * may be lost, which is acceptable for overhead statistics.
+ */
+class LatencyHistogram {
+public:
+    static const int BUCKET_COUNT = 65;
+    
+    void Record(uint64_t ticks) noexcept {
+        std::atomic<uint64_t>& bucket = m_buckets[BucketFor(ticks)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        
+        if (ticks > m_max.load(std::memory_order_relaxed)) {
+            m_max.store(ticks, std::memory_order_relaxed);
+        }
+    }
+    
+    /**
+     * @brief Summarize as p50/p99/max in nanoseconds.
+     * @param nsPerTick Tick length (ProbeClock::NsPerTick(), or 1.0 for ns input)
+     */
+    OverheadStats Summarize(double nsPerTick) const;
+    
+    void Reset() noexcept;
+    
+    unsigned long long GetCount() const;
+
+private:
+    static int BucketFor(uint64_t ticks) noexcept {
+        if (ticks == 0) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+        return 64 - __builtin_clzll(ticks);
+#else
+        int bucket = 0;
+        while (ticks) { ticks >>= 1; ++bucket; }
+        return bucket;
+#endif
+    }
+    
+    // Upper bound (inclusive) of a bucket, in ticks
+    static double BucketUpperBound(int bucket);
+    
+    uint64_t Percentile(double fraction) const;
+
+private:
+    std::atomic<uint64_t> m_buckets[BUCKET_COUNT] = {};
+    std::atomic<uint64_t> m_max{0};
+};
+
+/**
+ * @class Instrumentation
+ * @brief Per-callsite overhead histograms for the whole plugin.
+ */
+class Instrumentation {
+public:
+    static LatencyHistogram& Histogram(ProbeSite site) {
+        return s_histograms[static_cast<size_t>(site)];
+    }
+    
+    static OverheadStats GetStats(ProbeSite site);
+    
+    // Fill all sites at once (e.g. into MetricsSnapshot::overhead)
+    static void GetAllStats(OverheadStats (&stats)[PROBE_SITE_COUNT]);
+    
+    static void Reset();
+    
+    // False when built with ANXIETY_NO_INSTRUMENTATION
+    static constexpr bool IsEnabled() {
+#ifdef ANXIETY_NO_INSTRUMENTATION
+        return false;
+#else
+        return true;
+#endif
+    }
+
+private:
+    static LatencyHistogram s_histograms[PROBE_SITE_COUNT];
+};
+
+/**
+ * @class ScopedProbe
+ * @brief Records the lifetime of a scope into a site's histogram.
+ * Use through ANXIETY_PROBE so it compiles away when disabled.
+ */
+class ScopedProbe {
+public:
+    explicit ScopedProbe(ProbeSite site) noexcept
+        : m_site(site), m_start(ProbeClock::Now()) {}
+    
+    ~ScopedProbe() {
+        Instrumentation::Histogram(m_site).Record(ProbeClock::Now() - m_start);
+    }
+    
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+
+private:
+    ProbeSite m_site;
+    uint64_t m_start;
+};
+
+} // namespace AnxietyMonitor
+
+// Define ANXIETY_NO_INSTRUMENTATION to compile every probe out
+#ifdef ANXIETY_NO_INSTRUMENTATION
+#define ANXIETY_PROBE(site) ((void)0)
+#else
+#define ANXIETY_PROBE_CONCAT_(a, b) a##b
+#define ANXIETY_PROBE_CONCAT(a, b) ANXIETY_PROBE_CONCAT_(a, b)
+#define ANXIETY_PROBE(site) \
+    ::AnxietyMonitor::ScopedProbe ANXIETY_PROBE_CONCAT(anxietyProbe_, __LINE__)( \
+        ::AnxietyMonitor::ProbeSite::site)
+#endif
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,325 @@
+#include "LiveMetricsSegment.h"
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ANXIETY_POSIX_SHM 1
+#endif
+
+namespace AnxietyMonitor {
+
+namespace {
+
+// Reader retries before giving up on a continuously busy writer
+const int MAX_READ_ATTEMPTS = 64;
+
+uint32_t CurrentPid()
+{
+#if defined(_WIN32)
+    return static_cast<uint32_t>(GetCurrentProcessId());
+#elif defined(ANXIETY_POSIX_SHM)
+    return static_cast<uint32_t>(getpid());
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+// ============================================================================
+// LiveMetricsSegment
+// ============================================================================
+
+LiveMetricsSegment::LiveMetricsSegment()
+    : m_layout(nullptr)
+    , m_updates(0)
+    , m_pid(CurrentPid())
+#ifdef _WIN32
+    , m_mapping(nullptr)
+    , m_writer(nullptr)
+#else
+    , m_fd(-1)
+#endif
+{
+}
+
+LiveMetricsSegment::~LiveMetricsSegment()
+{
+    Close();
+}
+
+std::string LiveMetricsSegment::DefaultName()
+{
+#if defined(_WIN32)
+    return "Local\\AnxietyMonitorLive";
+#elif defined(ANXIETY_POSIX_SHM)
+    return "/anxiety_monitor." + std::to_string(static_cast<unsigned long>(getuid()));
+#else
+    return "anxiety_monitor";
+#endif
+}
+
+bool LiveMetricsSegment::Create(const std::string& name)
+{
+    Close();
+    m_lastError.clear();
+
+    // Never share a segment with another live writer: use a name of our own
+    bool busy = false;
+    if (!Map(name, busy) && busy) {
+        std::string fallback = name + "." + std::to_string(static_cast<unsigned long>(m_pid));
+        busy = false;
+        if (!Map(fallback, busy) && busy) {
+            m_lastError = name + " and " + fallback + " are in use by other writers";
+        }
+    }
+    if (!m_layout) return false;
+
+    // A taken-over segment may hold a stale (possibly odd) sequence; hide it
+    // from readers until the header is rewritten
+    m_layout->magic.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_layout->version = LIVE_METRICS_VERSION;
+    m_layout->payloadBytes = static_cast<uint32_t>(sizeof(LiveMetrics));
+    m_layout->reserved = 0;
+    m_layout->sequence.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint64_t>& word : m_layout->payload) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    m_layout->magic.store(LIVE_METRICS_MAGIC, std::memory_order_release);
+
+    m_updates = 0;
+    return true;
+}
+
+bool LiveMetricsSegment::Map(const std::string& name, bool& busy)
+{
+#if defined(_WIN32)
+    // The mapping may outlive its writer (readers keep it open), so
+    // ownership is a separate mutex only writers create; it disappears
+    // with the writer process
+    HANDLE writer = CreateMutexA(nullptr, FALSE, (name + ".writer").c_str());
+    if (!writer) {
+        m_lastError = "CreateMutex failed for " + name;
+        return false;
+    }
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        CloseHandle(writer);
+        busy = true;
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
+                                        static_cast<DWORD>(sizeof(LiveSegmentLayout)), name.c_str());
+    if (!mapping) {
+        CloseHandle(writer);
+        m_lastError = "CreateFileMapping failed for " + name;
+        return false;
+    }
+    void* memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(LiveSegmentLayout));
+    if (!memory) {
+        CloseHandle(mapping);
+        CloseHandle(writer);
+        m_lastError = "MapViewOfFile failed for " + name;
+        return false;
+    }
+    m_mapping = mapping;
+    m_writer = writer;
+#elif defined(ANXIETY_POSIX_SHM)
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        m_lastError = "shm_open failed for " + name + ": " + std::strerror(errno);
+        return false;
+    }
+    // The lock is held for as long as the descriptor stays open and is
+    // released if the writer dies, so a crashed writer's segment is reused
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        busy = (errno == EWOULDBLOCK);
+        m_lastError = "flock failed for " + name + ": " + std::strerror(errno);
+        close(fd);
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(sizeof(LiveSegmentLayout))) != 0) {
+        m_lastError = "ftruncate failed for " + name + ": " + std::strerror(errno);
+        shm_unlink(name.c_str());
+        close(fd);
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(LiveSegmentLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        m_lastError = "mmap failed for " + name + ": " + std::strerror(errno);
+        shm_unlink(name.c_str());
+        close(fd);
+        return false;
+    }
+    m_fd = fd;
+#else
+    (void)busy;
+    m_lastError = "Shared memory is not supported on this platform";
+    return false;
+#endif
+
+#if defined(_WIN32) || defined(ANXIETY_POSIX_SHM)
+    m_layout = static_cast<LiveSegmentLayout*>(memory);
+    m_name = name;
+    m_lastError.clear();
+    return true;
+#endif
+}
+
+void LiveMetricsSegment::Close()
+{
+    if (!m_layout) return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(m_layout);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    CloseHandle(static_cast<HANDLE>(m_writer));
+    m_mapping = nullptr;
+    m_writer = nullptr;
+#elif defined(ANXIETY_POSIX_SHM)
+    // Remove the name only while it still refers to our object (it may have
+    // been unlinked and created again by someone else); the lock is still
+    // held here, so no other writer can be using it
+    int named = shm_open(m_name.c_str(), O_RDONLY, 0);
+    if (named >= 0) {
+        struct stat ours;
+        struct stat current;
+        if (fstat(m_fd, &ours) == 0 && fstat(named, &current) == 0 &&
+            ours.st_dev == current.st_dev && ours.st_ino == current.st_ino) {
+            shm_unlink(m_name.c_str());
+        }
+        close(named);
+    }
+    munmap(m_layout, sizeof(LiveSegmentLayout));
+    close(m_fd);
+    m_fd = -1;
+#endif
+    m_layout = nullptr;
+}
+
+void LiveMetricsSegment::Publish(const LiveMetrics& metrics)
+{
+    if (!m_layout) return;
+
+    LiveMetrics copy = metrics;
+    copy.updateCount = ++m_updates;
+    copy.writerPid = m_pid;
+    uint64_t words[LIVE_METRICS_WORDS];
+    std::memcpy(words, &copy, sizeof(copy));
+
+    // Seqlock write: odd sequence, payload, even sequence
+    uint64_t sequence = m_layout->sequence.load(std::memory_order_relaxed);
+    m_layout->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < LIVE_METRICS_WORDS; ++i) {
+        m_layout->payload[i].store(words[i], std::memory_order_relaxed);
+    }
+    m_layout->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+// ============================================================================
+// LiveMetricsReader
+// ============================================================================
+
+LiveMetricsReader::LiveMetricsReader()
+    : m_layout(nullptr)
+#ifdef _WIN32
+    , m_mapping(nullptr)
+#endif
+{
+}
+
+LiveMetricsReader::~LiveMetricsReader()
+{
+    Close();
+}
+
+bool LiveMetricsReader::Open(const std::string& name)
+{
+    Close();
+    const void* memory = nullptr;
+
+#if defined(_WIN32)
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+    if (!mapping) return false;
+    memory = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, sizeof(LiveSegmentLayout));
+    if (!memory) {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+#elif defined(ANXIETY_POSIX_SHM)
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(LiveSegmentLayout))) {
+        close(fd);
+        return false;
+    }
+    memory = mmap(nullptr, sizeof(LiveSegmentLayout), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) return false;
+#else
+    (void)name;
+    return false;
+#endif
+
+    m_layout = static_cast<const LiveSegmentLayout*>(memory);
+    return true;
+}
+
+void LiveMetricsReader::Close()
+{
+    if (!m_layout) return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(m_layout);
+    CloseHandle(static_cast<HANDLE>(m_mapping));
+    m_mapping = nullptr;
+#elif defined(ANXIETY_POSIX_SHM)
+    munmap(const_cast<LiveSegmentLayout*>(m_layout), sizeof(LiveSegmentLayout));
+#endif
+    m_layout = nullptr;
+}
+
+bool LiveMetricsReader::Read(LiveMetrics& out) const
+{
+    if (!m_layout) return false;
+    if (m_layout->magic.load(std::memory_order_acquire) != LIVE_METRICS_MAGIC ||
+        m_layout->version != LIVE_METRICS_VERSION ||
+        m_layout->payloadBytes != sizeof(LiveMetrics)) {
+        return false;
+    }
+
+    uint64_t words[LIVE_METRICS_WORDS];
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt) {
+        uint64_t before = m_layout->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < LIVE_METRICS_WORDS; ++i) {
+            words[i] = m_layout->payload[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_layout->sequence.load(std::memory_order_relaxed) != before) continue;
+
+        if (before == 0) return false;      // Nothing published yet
+        std::memcpy(&out, words, sizeof(out));
+        return true;
+    }
+    return false;
+}
+
+} // namespace AnxietyMonitor
@@ -0,0 +1,177 @@
+#ifndef LIVE_METRICS_SEGMENT_H
+#define LIVE_METRICS_SEGMENT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace AnxietyMonitor {
+
+// ============================================================================
+// Segment Layout (shared with external readers; bump the version on change)
+// ============================================================================
+
+const uint32_t LIVE_METRICS_MAGIC = 0x53584E41;     // "ANXS" little-endian
+const uint32_t LIVE_METRICS_VERSION = 1;
+
+/**
+ * @brief Numeric metrics published to the live segment.
+ *
+ * Fixed-width fields only, no pointers or strings, so a reader in any
+ * language can mirror the struct. Enums are stored as their values:
+ * sessionState 0 stopped / 1 running / 2 paused, riskLevel 0 low ..
+ * 3 critical.
+ */
+struct LiveMetrics {
+    uint64_t updateCount;           // Publications since the segment was created
+    int64_t updatedUnixMs;          // Wall clock of this publication
+    uint32_t writerPid;
+    uint32_t sessionState;
+    uint32_t riskLevel;
+    int32_t consecutiveErrors;
+    double anxietyScore;            // 0-100
+
+    // Scorer inputs, as in the session CSV
+    double typingSpeedWpm;
+    double latencyVarianceMs;
+    double errorFreqPerMin;
+    double pauseRatio;
+    double errorResolutionTime;
+    double backspaceRate;
+    double idleRatio;
+    double focusSwitches;
+    double compileSuccessRate;
+    double sessionFragmentation;
+
+    // Session totals
+    int64_t keystrokesTotal;
+    int32_t compileAttempts;
+    int32_t errorCountTotal;
+    int32_t undoRedoCount;
+    int32_t reserved;
+};
+
+const size_t LIVE_METRICS_WORDS = sizeof(LiveMetrics) / sizeof(uint64_t);
+static_assert(sizeof(LiveMetrics) % sizeof(uint64_t) == 0, "LiveMetrics must be whole 64-bit words");
+
+/**
+ * @brief Memory layout of the segment.
+ *
+ * sequence is a seqlock counter: odd while the writer is updating the
+ * payload, even otherwise. A reader copies the payload between two equal
+ * even reads of sequence. The payload is stored as atomic words so the
+ * copy is race-free; on mainstream CPUs those are plain 64-bit moves.
+ */
+struct LiveSegmentLayout {
+    std::atomic<uint32_t> magic;    // LIVE_METRICS_MAGIC once initialised
+    uint32_t version;               // LIVE_METRICS_VERSION
+    uint32_t payloadBytes;          // sizeof(LiveMetrics)
+    uint32_t reserved;
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> payload[LIVE_METRICS_WORDS];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+              std::atomic<uint32_t>::is_always_lock_free,
+              "Shared-memory atomics must be lock-free (address-free)");
+
+// ============================================================================
+// Writer / Reader
+// ============================================================================
+
+/**
+ * @class LiveMetricsSegment
+ * @brief Writer side of the live metrics segment.
+ *
+ * A named shared-memory object (POSIX shm_open on Linux / macOS, a named
+ * file mapping on Windows) holding one LiveSegmentLayout. Publish() is a
+ * seqlock write: wait-free, no system call, no allocation, so it can run
+ * on the keystroke path. Readers map the same name read-only and never
+ * block the writer.
+ *
+ * One writer per segment: the writer holds an exclusive lock (flock on
+ * POSIX, a named writer mutex on Windows) while it is open. If another
+ * live writer holds the name, Create() falls back to "<name>.<pid>"; a
+ * segment left by a crashed writer is taken over. The object is created
+ * user-private (0600) and unlinked on Close() if the name still refers to
+ * it.
+ */
+class LiveMetricsSegment {
+public:
+    LiveMetricsSegment();
+    ~LiveMetricsSegment();
+
+    LiveMetricsSegment(const LiveMetricsSegment&) = delete;
+    LiveMetricsSegment& operator=(const LiveMetricsSegment&) = delete;
+
+    // "/anxiety_monitor.<uid>" (POSIX) or "Local\AnxietyMonitorLive" (Windows)
+    static std::string DefaultName();
+
+    /**
+     * @brief Create (or take over a dead writer's) segment and map it.
+     * Uses "<name>.<pid>" if another writer holds `name`; see GetName().
+     * @return false on failure; see GetLastError()
+     */
+    bool Create(const std::string& name = DefaultName());
+
+    // Unmap and remove our name (readers keep their existing mapping)
+    void Close();
+
+    bool IsOpen() const { return m_layout != nullptr; }
+    const std::string& GetName() const { return m_name; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // Publish a new version; updateCount and writerPid are filled in
+    void Publish(const LiveMetrics& metrics);
+
+private:
+    // Lock and map `name`; busy is set if another writer holds it
+    bool Map(const std::string& name, bool& busy);
+
+    LiveSegmentLayout* m_layout;
+    std::string m_name;
+    std::string m_lastError;
+    uint64_t m_updates;
+    uint32_t m_pid;
+#ifdef _WIN32
+    void* m_mapping;    // HANDLE
+    void* m_writer;     // HANDLE of the writer mutex
+#else
+    int m_fd;           // Open while mapped: holds the writer lock
+#endif
+};
+
+/**
+ * @class LiveMetricsReader
+ * @brief Read-only view of a live metrics segment (external tools, tests).
+ */
+class LiveMetricsReader {
+public:
+    LiveMetricsReader();
+    ~LiveMetricsReader();
+
+    LiveMetricsReader(const LiveMetricsReader&) = delete;
+    LiveMetricsReader& operator=(const LiveMetricsReader&) = delete;
+
+    bool Open(const std::string& name = LiveMetricsSegment::DefaultName());
+    void Close();
+    bool IsOpen() const { return m_layout != nullptr; }
+
+    /**
+     * @brief Copy the latest consistent version.
+     * @return false if nothing was published yet, the layout version does
+     * not match, or the writer kept the payload busy for every retry
+     */
+    bool Read(LiveMetrics& out) const;
+
+private:
+    const LiveSegmentLayout* m_layout;
+#ifdef _WIN32
+    void* m_mapping;
+#endif
+};
+
+} // namespace AnxietyMonitor
+
+#endif // LIVE_METRICS_SEGMENT_H
@@ -1,10 +1,11 @@
 #ifndef METRICS_DATA_H
 #define METRICS_DATA_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <chrono>
-#include <deque>
+#include <algorithm>
 #include <cmath>
 
 namespace AnxietyMonitor {
@@ -30,6 +31,17 @@ inline const char* GetRiskLevelLabel(RiskLevel level) {
     }
 }
 
+// Inverse of GetRiskLevelLabel; false for unknown labels
+inline bool ParseRiskLevelLabel(const std::string& label, RiskLevel& level) {
+    for (int i = 0; i <= static_cast<int>(RiskLevel::CRITICAL); ++i) {
+        if (label == GetRiskLevelLabel(static_cast<RiskLevel>(i))) {
+            level = static_cast<RiskLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
 // Helper function to get risk level emoji
 inline const char* GetRiskLevelEmoji(RiskLevel level) {
     switch (level) {
@@ -44,6 +56,60 @@ inline const char* GetRiskLevelEmoji(RiskLevel level) {
 // ============================================================================
 // Keystroke Event Data
 // ============================================================================
+
+// Compact key alphabet for digraph timing (see DigraphMatrix); letters are
+// split by QWERTY hand since same-hand pairs are slower
+enum class KeyClass : uint8_t {
+    UNKNOWN = 0,        // Not classified (legacy / synthetic input)
+    LETTER_LEFT,        // qwert asdfg zxcvb
+    LETTER_RIGHT,       // yuiop hjkl nm
+    UPPER,              // Shifted letter
+    DIGIT,
+    SPACE,
+    ENTER,
+    TAB,
+    BACKSPACE,          // Backspace / delete
+    BRACKET,            // ( ) [ ] { }
+    PUNCTUATION,        // ; , . :
+    OPERATOR,           // + - * / = < > & | ! ^ % ~ ?
+    QUOTE,              // ' " `
+    SYMBOL,             // _ # @ $ \ and other ASCII
+    OTHER,              // Non-ASCII
+    COUNT
+};
+
+const size_t KEY_CLASS_COUNT = static_cast<size_t>(KeyClass::COUNT);
+
+inline const char* GetKeyClassLabel(KeyClass key) {
+    switch (key) {
+        case KeyClass::LETTER_LEFT:  return "letter_left";
+        case KeyClass::LETTER_RIGHT: return "letter_right";
+        case KeyClass::UPPER:        return "upper";
+        case KeyClass::DIGIT:        return "digit";
+        case KeyClass::SPACE:        return "space";
+        case KeyClass::ENTER:        return "enter";
+        case KeyClass::TAB:          return "tab";
+        case KeyClass::BACKSPACE:    return "backspace";
+        case KeyClass::BRACKET:      return "bracket";
+        case KeyClass::PUNCTUATION:  return "punctuation";
+        case KeyClass::OPERATOR:     return "operator";
+        case KeyClass::QUOTE:        return "quote";
+        case KeyClass::SYMBOL:       return "symbol";
+        case KeyClass::OTHER:        return "other";
+        default:                     return "unknown";
+    }
+}
+
+// Key-pair timing that drifted furthest from its session baseline
+struct DigraphDeviation {
+    KeyClass first = KeyClass::UNKNOWN;     // UNKNOWN: no digraph in this rank
+    KeyClass second = KeyClass::UNKNOWN;
+    double deltaMs = 0.0;                   // Recent mean minus session mean
+    double zScore = 0.0;                    // deltaMs / session std deviation
+};
+
+const size_t DIGRAPH_TOP_N = 3;
+
 struct KeystrokeEvent {
     std::chrono::steady_clock::time_point timestamp;
     bool isBackspace;
@@ -55,12 +121,141 @@ struct KeystrokeEvent {
 // ============================================================================
 // Compile Event Data
 // ============================================================================
+
+// Error categories of a build log (see DiagnosticParser)
+enum class DiagnosticKind {
+    SYNTAX = 0,         // expected ';', stray characters, unterminated literals
+    TYPE = 1,           // conversions, overload resolution, invalid operands
+    UNDECLARED = 2,     // unknown names / members / types, redefinitions
+    LINK = 3,           // undefined references, multiple definitions
+    PREPROCESSOR = 4,   // missing includes, #error
+    OTHER = 5,
+    COUNT
+};
+
+const size_t DIAGNOSTIC_KIND_COUNT = static_cast<size_t>(DiagnosticKind::COUNT);
+
+inline const char* GetDiagnosticKindLabel(DiagnosticKind kind) {
+    switch (kind) {
+        case DiagnosticKind::SYNTAX:       return "syntax";
+        case DiagnosticKind::TYPE:         return "type";
+        case DiagnosticKind::UNDECLARED:   return "undeclared";
+        case DiagnosticKind::LINK:         return "link";
+        case DiagnosticKind::PREPROCESSOR: return "preprocessor";
+        case DiagnosticKind::OTHER:        return "other";
+        default:                           return "unknown";
+    }
+}
+
+// Diagnostic counts of one build (or summed over a session)
+struct DiagnosticCounts {
+    int errors = 0;
+    int warnings = 0;
+    int notes = 0;
+    int errorsByKind[DIAGNOSTIC_KIND_COUNT] = {};
+    int filesWithErrors = 0;
+
+    DiagnosticCounts& operator+=(const DiagnosticCounts& other) {
+        errors += other.errors;
+        warnings += other.warnings;
+        notes += other.notes;
+        for (size_t i = 0; i < DIAGNOSTIC_KIND_COUNT; ++i) {
+            errorsByKind[i] += other.errorsByKind[i];
+        }
+        filesWithErrors += other.filesWithErrors;
+        return *this;
+    }
+};
+
+// Distinct errors of one build compared with earlier builds
+// (see ErrorFingerprintCache)
+struct ErrorRecurrence {
+    int newErrors = 0;          // Not seen in any remembered build
+    int repeatedErrors = 0;     // Seen in an earlier build
+    int resolvedErrors = 0;     // In the previous build, gone from this one
+
+    ErrorRecurrence& operator+=(const ErrorRecurrence& other) {
+        newErrors += other.newErrors;
+        repeatedErrors += other.repeatedErrors;
+        resolvedErrors += other.resolvedErrors;
+        return *this;
+    }
+};
+
+// Parsed build log as handed to the collector
+struct BuildDiagnostics {
+    DiagnosticCounts counts;
+    std::vector<uint64_t> errorFingerprints;    // One per kept error
+};
+
 struct CompileEvent {
     std::chrono::steady_clock::time_point startTime;
     std::chrono::steady_clock::time_point endTime;
     int errorCount;
     int warningCount;
     bool success;
+    DiagnosticCounts diagnostics;   // From the build log; zero if not parsed
+    ErrorRecurrence recurrence;     // Zero if the log was not parsed
+};
+
+// ============================================================================
+// Change-Point (Shift) Event Data
+// ============================================================================
+enum class ShiftMetric {
+    ANXIETY_SCORE = 0,
+    ERROR_RATE = 1,
+    BACKSPACE_RATE = 2
+};
+
+// Helper function to get shift metric label (CSV/panel friendly)
+inline const char* GetShiftMetricLabel(ShiftMetric metric) {
+    switch (metric) {
+        case ShiftMetric::ANXIETY_SCORE:  return "anxiety_score";
+        case ShiftMetric::ERROR_RATE:     return "error_rate";
+        case ShiftMetric::BACKSPACE_RATE: return "backspace_rate";
+        default:                          return "unknown";
+    }
+}
+
+struct ShiftEvent {
+    std::string timestamp;          // Timestamp of the triggering snapshot
+    ShiftMetric metric;             // Which metric shifted
+    int direction;                  // +1 = upward shift, -1 = downward shift
+    double value;                   // Value that triggered detection
+    double baseline;                // Mean of the previous regime
+};
+
+// ============================================================================
+// Plugin Self-Overhead (see Instrumentation.h)
+// ============================================================================
+enum class ProbeSite {
+    EDITOR_CALLBACK = 0,    // EventHandlers SDK callbacks
+    EVENT_DRAIN = 1,        // Applying queued events to the collector
+    TIMER_UPDATE = 2,       // Plugin sample tick
+    GET_SNAPSHOT = 3,       // DataCollector::GetCurrentSnapshot
+    WRITE_SNAPSHOT = 4,     // CSV row / batch write
+    COUNT
+};
+
+const size_t PROBE_SITE_COUNT = static_cast<size_t>(ProbeSite::COUNT);
+
+// Helper function to get probe site label (CSV/panel friendly)
+inline const char* GetProbeSiteLabel(ProbeSite site) {
+    switch (site) {
+        case ProbeSite::EDITOR_CALLBACK: return "editor_callback";
+        case ProbeSite::EVENT_DRAIN:     return "event_drain";
+        case ProbeSite::TIMER_UPDATE:    return "timer_update";
+        case ProbeSite::GET_SNAPSHOT:    return "get_snapshot";
+        case ProbeSite::WRITE_SNAPSHOT:  return "write_snapshot";
+        default:                         return "unknown";
+    }
+}
+
+struct OverheadStats {
+    unsigned long long count = 0;   // Calls recorded
+    double p50Ns = 0.0;             // Median latency
+    double p99Ns = 0.0;             // 99th percentile latency
+    double maxNs = 0.0;             // Worst case
 };
 
 // ============================================================================
@@ -98,62 +293,133 @@ struct MetricsSnapshot {
     
     // Additional Metadata
     std::string timestampBatch;     // Batch timestamp for grouping
-    double cpuUsage;                // System CPU usage
-    double memoryUsage;             // System memory usage
+    double cpuUsage;                // Machine-wide CPU usage (%)
+    double memoryUsage;             // IDE process resident memory (MB)
     bool windowFocused;             // Is Code::Blocks focused
     long keystrokesTotal;           // Total keystrokes in session
     int compileAttempts;            // Total compile attempts
     int errorCountTotal;            // Total errors in session
+    
+    // Input bursts (paste / auto-repeat), tracked apart from typing metrics
+    int bulkInserts;                // Coalesced bulk-insert events
+    long bulkInsertChars;           // Characters in those events
+    
+    // Plugin self-overhead per probe site (optional CSV columns)
+    OverheadStats overhead[PROBE_SITE_COUNT];
+    
+    // Largest digraph latency deviations, strongest first (optional CSV columns)
+    DigraphDeviation digraphs[DIGRAPH_TOP_N];
+};
+
+// ============================================================================
+// Snapshot Field Mask (see DataCollector::GetCurrentSnapshot(fields))
+// ============================================================================
+// Fields outside the mask are left zero / empty and cost nothing to build.
+enum SnapshotField : uint32_t {
+    SNAPSHOT_TIMESTAMP          = 1u << 0,  // timestamp, timestampBatch, sessionId
+    SNAPSHOT_CONTEXT            = 1u << 1,  // projectName, filePath, language
+    SNAPSHOT_TYPING_SPEED       = 1u << 2,
+    SNAPSHOT_LATENCY_VARIANCE   = 1u << 3,
+    SNAPSHOT_ERROR_FREQ         = 1u << 4,
+    SNAPSHOT_PAUSE_RATIO        = 1u << 5,
+    SNAPSHOT_ERROR_RESOLUTION   = 1u << 6,
+    SNAPSHOT_BACKSPACE_RATE     = 1u << 7,
+    SNAPSHOT_CONSECUTIVE_ERRORS = 1u << 8,
+    SNAPSHOT_UNDO_REDO          = 1u << 9,
+    SNAPSHOT_IDLE_RATIO         = 1u << 10,
+    SNAPSHOT_FOCUS_SWITCHES     = 1u << 11,
+    SNAPSHOT_COMPILE_SUCCESS    = 1u << 12,
+    SNAPSHOT_FRAGMENTATION      = 1u << 13,
+    SNAPSHOT_SCORE              = 1u << 14, // anxietyScore, riskLevel (last keystroke-path score)
+    SNAPSHOT_SYSTEM             = 1u << 15, // cpuUsage, memoryUsage
+    SNAPSHOT_COUNTERS           = 1u << 16, // windowFocused, session totals, bulk inserts
+    SNAPSHOT_DIGRAPHS           = 1u << 17, // digraphs (top-N latency deviations)
+    
+    // Everything AnxietyScorer::CalculateScore reads
+    SNAPSHOT_SCORER_INPUTS = SNAPSHOT_TYPING_SPEED | SNAPSHOT_LATENCY_VARIANCE |
+                             SNAPSHOT_ERROR_FREQ | SNAPSHOT_PAUSE_RATIO |
+                             SNAPSHOT_ERROR_RESOLUTION | SNAPSHOT_BACKSPACE_RATE |
+                             SNAPSHOT_CONSECUTIVE_ERRORS | SNAPSHOT_UNDO_REDO |
+                             SNAPSHOT_IDLE_RATIO | SNAPSHOT_FOCUS_SWITCHES |
+                             SNAPSHOT_COMPILE_SUCCESS | SNAPSHOT_FRAGMENTATION,
+    
+    // StatusBarManager::FormatStatusText
+    SNAPSHOT_STATUS_BAR = SNAPSHOT_SCORE | SNAPSHOT_ERROR_FREQ |
+                          SNAPSHOT_TYPING_SPEED | SNAPSHOT_PAUSE_RATIO,
+    
+    // AnxietyPanel::UpdateLiveMetrics
+    SNAPSHOT_PANEL = SNAPSHOT_STATUS_BAR | SNAPSHOT_BACKSPACE_RATE,
+    
+    SNAPSHOT_ALL = (1u << 18) - 1
 };
 
 // ============================================================================
 // Rolling Window Buffer for Metrics
 // ============================================================================
+/**
+ * Fixed-capacity ring: storage is allocated once at construction, so
+ * push() never touches the heap (it runs on every keystroke).
+ */
 template<typename T>
 class RollingBuffer {
 public:
-    explicit RollingBuffer(size_t maxSize = 300) : m_maxSize(maxSize) {}
+    explicit RollingBuffer(size_t maxSize = 300)
+        : m_data(maxSize > 0 ? maxSize : 1), m_head(0), m_size(0) {}
     
     void push(const T& value) {
-        if (m_data.size() >= m_maxSize) {
-            m_data.pop_front();
+        m_data[m_head] = value;
+        m_head = (m_head + 1) % m_data.size();
+        if (m_size < m_data.size()) {
+            ++m_size;
         }
-        m_data.push_back(value);
     }
     
-    void clear() { m_data.clear(); }
+    void clear() { m_head = 0; m_size = 0; }
     
-    size_t size() const { return m_data.size(); }
+    size_t size() const { return m_size; }
     
-    bool empty() const { return m_data.empty(); }
+    size_t capacity() const { return m_data.size(); }
     
-    const std::deque<T>& data() const { return m_data; }
+    bool empty() const { return m_size == 0; }
+    
+    // Element i in insertion order (0 = oldest retained)
+    const T& operator[](size_t i) const {
+        return m_data[(m_head + m_data.size() - m_size + i) % m_data.size()];
+    }
     
     // Calculate mean
     double mean() const {
-        if (m_data.empty()) return 0.0;
+        if (m_size == 0) return 0.0;
         double sum = 0.0;
-        for (const auto& v : m_data) {
-            sum += static_cast<double>(v);
-        }
-        return sum / m_data.size();
+        ForEach([&sum](const T& v) { sum += static_cast<double>(v); });
+        return sum / m_size;
     }
     
     // Calculate standard deviation
     double stddev() const {
-        if (m_data.size() < 2) return 0.0;
+        if (m_size < 2) return 0.0;
         double avg = mean();
         double sumSq = 0.0;
-        for (const auto& v : m_data) {
+        ForEach([avg, &sumSq](const T& v) {
             double diff = static_cast<double>(v) - avg;
             sumSq += diff * diff;
-        }
-        return std::sqrt(sumSq / (m_data.size() - 1));
+        });
+        return std::sqrt(sumSq / (m_size - 1));
     }
 
 private:
-    std::deque<T> m_data;
-    size_t m_maxSize;
+    // Visit retained elements as (at most) two contiguous spans
+    template<typename Fn>
+    void ForEach(Fn fn) const {
+        size_t start = (m_head + m_data.size() - m_size) % m_data.size();
+        size_t firstSpan = std::min(m_size, m_data.size() - start);
+        for (size_t i = start; i < start + firstSpan; ++i) fn(m_data[i]);
+        for (size_t i = 0; i < m_size - firstSpan; ++i) fn(m_data[i]);
+    }
+
+    std::vector<T> m_data;
+    size_t m_head;      // Next write position
+    size_t m_size;
 };
 
 // ============================================================================
@@ -169,9 +435,14 @@ enum class SessionState {
 // Configuration Settings (User-friendly defaults)
 // ============================================================================
 struct PluginSettings {
-    // Update intervals
-    int statusUpdateIntervalMs = 30000;     // 30 seconds
-    int csvWriteIntervalMs = 30000;         // 30 seconds
+    // Update intervals (independent: sampling can run at up to 4 Hz while
+    // the UI refreshes and the CSV is written less often)
+    int sampleIntervalMs = 30000;           // Snapshot capture (one CSV row per sample)
+    int statusUpdateIntervalMs = 30000;     // Status bar + panel refresh
+    int liveDisplayIntervalMs = 0;          // Live status/panel refresh between samples (0 = off)
+    int csvWriteIntervalMs = 30000;         // Batched CSV persistence
+    int eventDrainIntervalMs = 100;         // Apply queued editor events
+    int systemSampleIntervalMs = 1000;      // CPU / memory sampler thread
     
     // Rolling window duration (5 minutes)
     int rollingWindowSeconds = 300;
@@ -183,6 +454,13 @@ struct PluginSettings {
     double maxPauseRatio = 0.5;             // 50%
     double maxBackspaceRate = 20.0;         // per 100 keystrokes
     
+    // Burst coalescing (paste / held-down key)
+    int burstGapMs = 5;                     // Chars closer than this form a burst
+    int burstMinChars = 8;                  // Smaller bursts count as typing
+    int repeatMaxIntervalMs = 60;           // Auto-repeat interval upper bound
+    int repeatJitterMs = 3;                 // Allowed auto-repeat interval jitter
+    int repeatMinStreak = 4;                // Steady repeats before coalescing
+    
     // Pause detection
     int pauseThresholdMs = 2000;            // 2 seconds
     int breakThresholdMs = 30000;           // 30 seconds (fragmentation)
@@ -193,10 +471,35 @@ struct PluginSettings {
     bool showTrayNotifications = false;     // Disabled by default
     int warningCooldownMinutes = 10;        // Minimum time between warnings
     
+    // Change-point (Page-Hinkley) detection: delta = tolerated drift,
+    // threshold = cumulative evidence required to report a shift
+    double scoreShiftDelta = 2.0;           // Score points
+    double scoreShiftThreshold = 25.0;
+    double errorRateShiftDelta = 0.2;       // Errors/min
+    double errorRateShiftThreshold = 3.0;
+    double backspaceShiftDelta = 1.0;       // Per 100 keystrokes
+    double backspaceShiftThreshold = 15.0;
+    int shiftMinSamples = 4;                // Baseline samples before testing
+    
     // CSV settings
     std::string csvOutputDir;               // Will be set to ~/.codeblocks/anxiety_monitor/sessions/
     bool autoSaveOnExit = true;             // Auto-save when exiting
     bool autoSaveOnStop = true;             // Auto-save when stopping session
+    bool csvOverheadColumns = false;        // Append plugin overhead p50/p99/max
+    bool csvDigraphColumns = false;         // Append top digraph latency deviations
+    
+    // Live metrics in shared memory for external tools (see LiveMetricsSegment)
+    bool liveSegmentEnabled = false;
+    std::string liveSegmentName;            // Empty: LiveMetricsSegment::DefaultName()
+    
+    // Local HTTP endpoint: Prometheus /metrics and SSE /events (see MetricsEndpoint)
+    bool metricsEndpointEnabled = false;
+    int metricsEndpointPort = 9477;         // Bound to 127.0.0.1
+    std::string metricsEndpointSocket;      // Unix socket path instead of the port
+    
+    // Profiling: record spans from attach, dumped as Chrome trace JSON on
+    // release (can also be toggled from the menu)
+    bool traceEnabled = false;
 };
 
 } // namespace AnxietyMonitor
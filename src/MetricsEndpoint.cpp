@@ -0,0 +1,571 @@
+#include "MetricsEndpoint.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace AnxietyMonitor {
+
+namespace {
+
+#if defined(_WIN32)
+typedef SOCKET SocketHandle;
+typedef WSAPOLLFD PollEntry;
+const SocketHandle NO_SOCKET = INVALID_SOCKET;
+#else
+typedef int SocketHandle;
+typedef pollfd PollEntry;
+const SocketHandle NO_SOCKET = -1;
+#endif
+
+#if defined(MSG_NOSIGNAL)
+const int SEND_FLAGS = MSG_NOSIGNAL;    // A vanished scraper must not raise SIGPIPE
+#else
+const int SEND_FLAGS = 0;
+#endif
+
+const char SSE_HEADER[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/event-stream\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n";
+
+const char NO_SAMPLE_RESPONSE[] =
+    "HTTP/1.1 503 Service Unavailable\r\n"
+    "Content-Type: text/plain\r\n"
+    "Content-Length: 15\r\n"
+    "Connection: close\r\n"
+    "\r\n"
+    "No sample yet.\n";
+
+const char NOT_FOUND_RESPONSE[] =
+    "HTTP/1.1 404 Not Found\r\n"
+    "Content-Type: text/plain\r\n"
+    "Content-Length: 34\r\n"
+    "Connection: close\r\n"
+    "\r\n"
+    "Try GET /metrics or GET /events.\r\n";
+
+const char BAD_METHOD_RESPONSE[] =
+    "HTTP/1.1 405 Method Not Allowed\r\n"
+    "Allow: GET\r\n"
+    "Content-Length: 0\r\n"
+    "Connection: close\r\n"
+    "\r\n";
+
+void CloseSocket(SocketHandle socket)
+{
+#if defined(_WIN32)
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
+
+bool SetNonBlocking(SocketHandle socket)
+{
+#if defined(_WIN32)
+    u_long enabled = 1;
+    return ioctlsocket(socket, FIONBIO, &enabled) == 0;
+#else
+    int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+bool WouldBlock()
+{
+#if defined(_WIN32)
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
+
+int PollSockets(PollEntry* entries, size_t count, int timeoutMs)
+{
+#if defined(_WIN32)
+    return WSAPoll(entries, static_cast<ULONG>(count), timeoutMs);
+#else
+    return poll(entries, static_cast<nfds_t>(count), timeoutMs);
+#endif
+}
+
+std::string SocketErrorText()
+{
+#if defined(_WIN32)
+    return "WSA error " + std::to_string(WSAGetLastError());
+#else
+    return std::strerror(errno);
+#endif
+}
+
+// One exported value; Prometheus name and the session CSV column as JSON key
+struct MetricRow {
+    const char* name;
+    const char* key;
+    const char* type;
+    const char* help;
+    double value;
+};
+
+const size_t METRIC_ROW_COUNT = 21;
+
+double RiskLevelValue(const std::string& label)
+{
+    RiskLevel level = RiskLevel::LOW;
+    ParseRiskLevelLabel(label, level);
+    return static_cast<double>(level);
+}
+
+void FillMetricRows(const MetricsSnapshot& s, MetricRow* rows)
+{
+    const MetricRow table[METRIC_ROW_COUNT] = {
+        {"anxiety_score", "anxiety_score", "gauge", "Anxiety score (0-100).", s.anxietyScore},
+        {"anxiety_risk_level", "risk_level_value", "gauge",
+         "Risk level: 0 low, 1 moderate, 2 high, 3 critical.", RiskLevelValue(s.riskLevel)},
+        {"anxiety_typing_speed_wpm", "typing_speed_wpm", "gauge", "Typing speed (words per minute).", s.typingSpeedWpm},
+        {"anxiety_latency_variance_ms", "latency_variance_ms", "gauge", "Inter-key latency deviation (ms).", s.latencyVarianceMs},
+        {"anxiety_error_freq_permin", "error_freq_permin", "gauge", "Compiler errors per minute.", s.errorFreqPerMin},
+        {"anxiety_pause_ratio", "pause_ratio", "gauge", "Share of time in typing pauses.", s.pauseRatio},
+        {"anxiety_error_resolution_seconds", "error_resolution_time", "gauge",
+         "Mean time from a failed build to the next successful one.", s.errorResolutionTime},
+        {"anxiety_backspace_rate", "backspace_rate", "gauge", "Backspaces per 100 keystrokes.", s.backspaceRate},
+        {"anxiety_consecutive_errors", "consecutive_errors", "gauge",
+         "Compiler errors counted in the error window, which never decays (session total).",
+         static_cast<double>(s.consecutiveErrors)},
+        {"anxiety_undo_redo_count", "undo_redo_count", "gauge", "Undo + redo operations this session.",
+         static_cast<double>(s.undoRedoCount)},
+        {"anxiety_idle_ratio", "idle_ratio", "gauge", "Share of session time idle.", s.idleRatio},
+        {"anxiety_focus_switches", "focus_switches", "gauge", "Tab changes per minute.", s.focusSwitches},
+        {"anxiety_compile_success_rate", "compile_success_rate", "gauge", "Successful compiles (%).", s.compileSuccessRate},
+        {"anxiety_session_fragmentation", "session_fragmentation", "gauge", "Breaks (over 30 s) per minute.",
+         s.sessionFragmentation},
+        {"anxiety_cpu_usage_percent", "cpu_usage", "gauge", "Machine-wide CPU usage (%).", s.cpuUsage},
+        {"anxiety_memory_usage_mb", "memory_usage", "gauge", "IDE resident memory (MB).", s.memoryUsage},
+        {"anxiety_window_focused", "window_focused", "gauge", "1 while the IDE has focus.", s.windowFocused ? 1.0 : 0.0},
+        {"anxiety_keystrokes_total", "keystrokes_total", "counter", "Keystrokes this session.",
+         static_cast<double>(s.keystrokesTotal)},
+        {"anxiety_compile_attempts_total", "compile_attempts", "counter", "Compiles this session.",
+         static_cast<double>(s.compileAttempts)},
+        {"anxiety_errors_total", "error_count_total", "counter", "Compiler errors this session.",
+         static_cast<double>(s.errorCountTotal)},
+        {"anxiety_bulk_inserts_total", "bulk_inserts", "counter", "Pastes / auto-repeat bursts this session.",
+         static_cast<double>(s.bulkInserts)},
+    };
+    std::copy(table, table + METRIC_ROW_COUNT, rows);
+}
+
+void AppendNumber(std::string& out, double value)
+{
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+    out.append(buffer, static_cast<size_t>(std::max(0, length)));
+}
+
+} // namespace
+
+struct MetricsEndpoint::Connection {
+    SocketHandle socket = NO_SOCKET;
+    std::chrono::steady_clock::time_point accepted;
+    std::string request;
+    bool streaming = false;         // /events subscriber
+    bool closeWhenSent = false;
+    bool closed = false;
+
+    // Pending output; `hold` keeps a rendering alive while it is sent
+    std::shared_ptr<const Rendered> hold;
+    const char* data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+    uint64_t sentGeneration = 0;
+
+    void Queue(std::shared_ptr<const Rendered> owner, const char* bytes, size_t length) {
+        hold = std::move(owner);
+        data = bytes;
+        size = length;
+        offset = 0;
+    }
+
+    void Flush() {
+        while (data && offset < size) {
+            int sent = static_cast<int>(send(socket, data + offset, static_cast<int>(size - offset), SEND_FLAGS));
+            if (sent < 0) {
+                if (!WouldBlock()) closed = true;
+                return;
+            }
+            offset += static_cast<size_t>(sent);
+        }
+        data = nullptr;
+        hold.reset();
+        if (closeWhenSent) closed = true;
+    }
+};
+
+MetricsEndpoint::MetricsEndpoint(int requestTimeoutMs)
+    : m_generation(0)
+    , m_listener(-1)
+    , m_port(0)
+    , m_requestTimeoutMs(requestTimeoutMs)
+    , m_requests(0)
+    , m_stopRequested(false)
+{
+}
+
+MetricsEndpoint::~MetricsEndpoint()
+{
+    Stop();
+}
+
+// ============================================================================
+// Thread control
+// ============================================================================
+
+bool MetricsEndpoint::StartTcp(int port)
+{
+    Stop();
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return Listen(AF_INET, &address, sizeof(address));
+}
+
+bool MetricsEndpoint::StartUnix(const std::string& path)
+{
+    Stop();
+#if defined(_WIN32)
+    (void)path;
+    m_lastError = "Unix domain sockets are not supported on this platform";
+    return false;
+#else
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        m_lastError = "Invalid socket path: " + path;
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // Replace only a stale socket left by a crashed instance: never a
+    // regular file, and never a socket someone is still listening on
+    struct stat info;
+    if (lstat(path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            m_lastError = "Not a socket, not replacing: " + path;
+            return false;
+        }
+        SocketHandle probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        bool live = probe != NO_SOCKET &&
+                    connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+        if (probe != NO_SOCKET) close(probe);
+        if (live) {
+            m_lastError = "Socket in use by another listener: " + path;
+            return false;
+        }
+        unlink(path.c_str());
+    }
+    m_socketPath = path;
+    return Listen(AF_UNIX, &address, sizeof(address));
+#endif
+}
+
+bool MetricsEndpoint::Listen(int family, const void* address, size_t addressLength)
+{
+    m_lastError.clear();
+#if defined(_WIN32)
+    WSADATA data;
+    if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+        m_lastError = "WSAStartup failed";
+        return false;
+    }
+#endif
+
+    SocketHandle listener = socket(family, SOCK_STREAM, 0);
+    bool ok = listener != NO_SOCKET;
+#if !defined(_WIN32)
+    if (ok && family == AF_INET) {
+        int reuse = 1;      // Restart right after Stop (TIME_WAIT)
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+#endif
+    ok = ok && bind(listener, static_cast<const sockaddr*>(address), static_cast<socklen_t>(addressLength)) == 0;
+#if !defined(_WIN32)
+    // Owner only, before anyone can connect
+    ok = ok && (family != AF_UNIX || chmod(m_socketPath.c_str(), S_IRUSR | S_IWUSR) == 0);
+#endif
+    ok = ok && listen(listener, 16) == 0 && SetNonBlocking(listener);
+
+    if (!ok) {
+        m_lastError = "Cannot listen: " + SocketErrorText();
+        if (listener != NO_SOCKET) CloseSocket(listener);
+#if defined(_WIN32)
+        WSACleanup();
+#else
+        if (!m_socketPath.empty()) unlink(m_socketPath.c_str());
+#endif
+        m_socketPath.clear();
+        return false;
+    }
+
+    m_port = 0;
+    if (family == AF_INET) {
+        sockaddr_in bound;
+        socklen_t length = sizeof(bound);
+        if (getsockname(listener, reinterpret_cast<sockaddr*>(&bound), &length) == 0) {
+            m_port = ntohs(bound.sin_port);
+        }
+    }
+
+    m_listener = static_cast<std::intptr_t>(listener);
+    m_requests = 0;
+    m_stopRequested = false;
+    m_thread = std::thread(&MetricsEndpoint::Run, this);
+    return true;
+}
+
+void MetricsEndpoint::Stop()
+{
+    if (!m_thread.joinable()) return;
+
+    m_stopRequested = true;
+    m_thread.join();
+
+    CloseSocket(static_cast<SocketHandle>(m_listener));
+    m_listener = -1;
+#if defined(_WIN32)
+    WSACleanup();
+#else
+    if (!m_socketPath.empty()) unlink(m_socketPath.c_str());
+#endif
+    m_socketPath.clear();
+}
+
+// ============================================================================
+// Rendering (plugin thread)
+// ============================================================================
+
+void MetricsEndpoint::Publish(const MetricsSnapshot& snapshot)
+{
+    auto rendered = std::make_shared<Rendered>();
+    rendered->generation = ++m_generation;
+
+    std::string body = RenderPrometheus(snapshot);
+    char header[160];
+    int headerLength = std::snprintf(header, sizeof(header),
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+        "Content-Length: %zu\r\n"
+        "Connection: close\r\n"
+        "\r\n", body.size());
+    rendered->metricsResponse.reserve(static_cast<size_t>(headerLength) + body.size());
+    rendered->metricsResponse.append(header, static_cast<size_t>(headerLength));
+    rendered->metricsResponse += body;
+
+    rendered->event = "id: " + std::to_string(rendered->generation) + "\nevent: metrics\ndata: ";
+    rendered->event += RenderJson(snapshot);
+    rendered->event += "\n\n";
+
+    std::atomic_store(&m_rendered, std::shared_ptr<const Rendered>(std::move(rendered)));
+}
+
+std::string MetricsEndpoint::RenderPrometheus(const MetricsSnapshot& snapshot)
+{
+    MetricRow rows[METRIC_ROW_COUNT];
+    FillMetricRows(snapshot, rows);
+
+    std::string out;
+    out.reserve(3072);
+    for (const MetricRow& row : rows) {
+        out += "# HELP ";
+        out += row.name;
+        out += ' ';
+        out += row.help;
+        out += "\n# TYPE ";
+        out += row.name;
+        out += ' ';
+        out += row.type;
+        out += '\n';
+        out += row.name;
+        out += ' ';
+        AppendNumber(out, row.value);
+        out += '\n';
+    }
+    return out;
+}
+
+std::string MetricsEndpoint::RenderJson(const MetricsSnapshot& snapshot)
+{
+    MetricRow rows[METRIC_ROW_COUNT];
+    FillMetricRows(snapshot, rows);
+
+    // Timestamp and risk label are generated by the plugin: no escaping needed
+    std::string out;
+    out.reserve(768);
+    out += "{\"timestamp\":\"";
+    out += snapshot.timestamp;
+    out += "\",\"risk_level\":\"";
+    out += snapshot.riskLevel;
+    out += '"';
+    for (const MetricRow& row : rows) {
+        out += ",\"";
+        out += row.key;
+        out += "\":";
+        AppendNumber(out, row.value);
+    }
+    out += '}';
+    return out;
+}
+
+// ============================================================================
+// Server thread
+// ============================================================================
+
+void MetricsEndpoint::Run()
+{
+    SocketHandle listener = static_cast<SocketHandle>(m_listener);
+    std::vector<Connection> connections;
+    std::vector<PollEntry> entries;
+
+    while (!m_stopRequested.load(std::memory_order_relaxed)) {
+        // Idle subscribers get the newest event; stale ones are skipped
+        std::shared_ptr<const Rendered> current = std::atomic_load(&m_rendered);
+        for (Connection& connection : connections) {
+            if (connection.streaming && !connection.data && current &&
+                current->generation != connection.sentGeneration) {
+                connection.sentGeneration = current->generation;
+                connection.Queue(current, current->event.data(), current->event.size());
+                connection.Flush();
+            }
+        }
+
+        entries.clear();
+        entries.push_back(PollEntry{listener, POLLIN, 0});
+        for (const Connection& connection : connections) {
+            short events = connection.data ? POLLOUT : POLLIN;
+            entries.push_back(PollEntry{connection.socket, events, 0});
+        }
+        if (PollSockets(entries.data(), entries.size(), POLL_INTERVAL_MS) < 0) continue;
+
+        // A connection that has not sent its full request in time is closed,
+        // so idle connects cannot hold every MAX_CLIENTS slot
+        auto now = std::chrono::steady_clock::now();
+        for (Connection& connection : connections) {
+            if (!connection.streaming && !connection.data &&
+                now - connection.accepted >= std::chrono::milliseconds(m_requestTimeoutMs)) {
+                connection.closed = true;
+            }
+        }
+
+        for (size_t i = 0; i < connections.size(); ++i) {
+            Connection& connection = connections[i];
+            short revents = entries[i + 1].revents;
+            if (connection.closed) {
+                continue;
+            } else if (revents & (POLLERR | POLLNVAL)) {
+                connection.closed = true;
+            } else if (revents & POLLOUT) {
+                connection.Flush();
+            } else if (revents & (POLLIN | POLLHUP)) {
+                char buffer[1024];
+                int received = static_cast<int>(recv(connection.socket, buffer, sizeof(buffer), 0));
+                if (received == 0 || (received < 0 && !WouldBlock())) {
+                    connection.closed = true;
+                } else if (received > 0 && !connection.streaming) {
+                    connection.request.append(buffer, static_cast<size_t>(received));
+                    if (connection.request.find("\r\n\r\n") != std::string::npos) {
+                        HandleRequest(connection);
+                        connection.Flush();
+                    } else if (connection.request.size() > MAX_REQUEST_BYTES) {
+                        connection.closed = true;
+                    }
+                }
+            }
+        }
+
+        if (entries[0].revents & POLLIN) {
+            for (;;) {
+                SocketHandle client = accept(listener, nullptr, nullptr);
+                if (client == NO_SOCKET) break;
+                if (connections.size() >= MAX_CLIENTS || !SetNonBlocking(client)) {
+                    CloseSocket(client);
+                    continue;
+                }
+#if defined(SO_NOSIGPIPE)
+                int noSigPipe = 1;
+                setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+                Connection connection;
+                connection.socket = client;
+                connection.accepted = std::chrono::steady_clock::now();
+                connections.push_back(std::move(connection));
+            }
+        }
+
+        auto closed = std::remove_if(connections.begin(), connections.end(), [](const Connection& connection) {
+            if (connection.closed) CloseSocket(connection.socket);
+            return connection.closed;
+        });
+        connections.erase(closed, connections.end());
+    }
+
+    for (const Connection& connection : connections) {
+        CloseSocket(connection.socket);
+    }
+}
+
+void MetricsEndpoint::HandleRequest(Connection& connection)
+{
+    m_requests.fetch_add(1, std::memory_order_relaxed);
+
+    // Request line: METHOD SP PATH[?query] SP VERSION
+    const std::string& request = connection.request;
+    size_t methodEnd = request.find(' ');
+    size_t pathEnd = methodEnd == std::string::npos ? std::string::npos : request.find_first_of(" ?\r", methodEnd + 1);
+    std::string method = request.substr(0, methodEnd);
+    std::string path = pathEnd == std::string::npos ? std::string() : request.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+    connection.request.clear();
+    connection.closeWhenSent = true;
+
+    if (method != "GET") {
+        connection.Queue(nullptr, BAD_METHOD_RESPONSE, sizeof(BAD_METHOD_RESPONSE) - 1);
+    } else if (path == "/metrics") {
+        std::shared_ptr<const Rendered> current = std::atomic_load(&m_rendered);
+        if (current) {
+            connection.Queue(current, current->metricsResponse.data(), current->metricsResponse.size());
+        } else {
+            connection.Queue(nullptr, NO_SAMPLE_RESPONSE, sizeof(NO_SAMPLE_RESPONSE) - 1);
+        }
+    } else if (path == "/events") {
+        // Events follow from the loop once the header is out
+        connection.streaming = true;
+        connection.closeWhenSent = false;
+        connection.Queue(nullptr, SSE_HEADER, sizeof(SSE_HEADER) - 1);
+    } else {
+        connection.Queue(nullptr, NOT_FOUND_RESPONSE, sizeof(NOT_FOUND_RESPONSE) - 1);
+    }
+}
+
+} // namespace AnxietyMonitor
@@ -0,0 +1,113 @@
+#ifndef METRICS_ENDPOINT_H
+#define METRICS_ENDPOINT_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include "MetricsData.h"
+
+namespace AnxietyMonitor {
+
+/**
+ * @class MetricsEndpoint
+ * @brief Local HTTP listener exposing the latest snapshot to scrapers.
+ *
+ * Serves two paths from its own thread:
+ * - GET /metrics: Prometheus text exposition format (version 0.0.4)
+ * - GET /events:  Server-Sent Events, one "metrics" event (JSON) per update
+ *
+ * Publish() renders the complete /metrics response and the SSE event once
+ * and swaps them in through an atomic shared_ptr. Requests only copy bytes
+ * out of the current rendering, so the scrape rate never reaches the
+ * plugin's thread; an SSE client that falls behind skips to the newest
+ * event instead of queueing.
+ *
+ * The listener binds to 127.0.0.1 or to a Unix domain socket (POSIX,
+ * mode 0600); it is never reachable from other machines. Snapshot
+ * identifiers (project, file) are not exported.
+ */
+class MetricsEndpoint {
+public:
+    static const int DEFAULT_PORT = 9477;
+    static const int POLL_INTERVAL_MS = 100;    // Stop / SSE push latency
+    static const size_t MAX_CLIENTS = 64;       // Further connections are closed
+    static const size_t MAX_REQUEST_BYTES = 4096;
+    static const int REQUEST_TIMEOUT_MS = 5000; // Idle connections are closed
+
+    /**
+     * @param requestTimeoutMs Time a connection may take to send its full
+     * request; idle connections would otherwise use up MAX_CLIENTS
+     */
+    explicit MetricsEndpoint(int requestTimeoutMs = REQUEST_TIMEOUT_MS);
+    ~MetricsEndpoint();
+
+    MetricsEndpoint(const MetricsEndpoint&) = delete;
+    MetricsEndpoint& operator=(const MetricsEndpoint&) = delete;
+
+    /**
+     * @brief Listen on 127.0.0.1:port and start the server thread.
+     * @param port TCP port; 0 picks a free one (see GetPort())
+     * @return false on failure; see GetLastError()
+     */
+    bool StartTcp(int port = DEFAULT_PORT);
+
+    /**
+     * @brief Listen on a Unix domain socket (POSIX only). A stale socket
+     * at `path` is replaced; any other file there, or a socket with a live
+     * listener, makes this fail.
+     */
+    bool StartUnix(const std::string& path);
+
+    // Stop and join the server thread, close every connection
+    void Stop();
+
+    bool IsRunning() const { return m_thread.joinable(); }
+    int GetPort() const { return m_port; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+    // Requests answered since Start (any path)
+    uint64_t GetRequestCount() const { return m_requests.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Render `snapshot` for both paths and make it current.
+     * Called from the plugin's thread, once per sample.
+     */
+    void Publish(const MetricsSnapshot& snapshot);
+
+    // Response bodies (exposed for tests)
+    static std::string RenderPrometheus(const MetricsSnapshot& snapshot);
+    static std::string RenderJson(const MetricsSnapshot& snapshot);
+
+private:
+    // One pre-rendered update, shared read-only with the server thread
+    struct Rendered {
+        uint64_t generation;
+        std::string metricsResponse;    // Full HTTP response for /metrics
+        std::string event;              // SSE event for /events
+    };
+
+    struct Connection;
+
+    bool Listen(int family, const void* address, size_t addressLength);
+    void Run();
+    void HandleRequest(Connection& connection);
+
+    std::shared_ptr<const Rendered> m_rendered;     // std::atomic_load / atomic_store
+    uint64_t m_generation;                          // Publisher side only
+
+    std::intptr_t m_listener;       // Socket handle; -1 when closed
+    int m_port;
+    std::string m_socketPath;       // Unix socket to remove on Stop
+    std::string m_lastError;
+    int m_requestTimeoutMs;
+    std::atomic<uint64_t> m_requests;
+
+    std::thread m_thread;
+    std::atomic<bool> m_stopRequested;
+};
+
+} // namespace AnxietyMonitor
+
+#endif // METRICS_ENDPOINT_H
@@ -0,0 +1,106 @@
+#include "SessionClock.h"
+#include <algorithm>
+
+namespace AnxietyMonitor {
+
+SessionClock::SessionClock(long long idleThresholdMs)
+    : m_state(SessionState::STOPPED)
+    , m_pausedTotal(Duration::zero())
+    , m_idleTotal(Duration::zero())
+    , m_idleThreshold(std::chrono::milliseconds(std::max(0LL, idleThresholdMs)))
+{
+}
+
+void SessionClock::SetIdleThreshold(long long idleThresholdMs)
+{
+    // Applies to the open idle span too; closed spans keep their length
+    m_idleThreshold = std::chrono::milliseconds(std::max(0LL, idleThresholdMs));
+}
+
+void SessionClock::Start(TimePoint start)
+{
+    m_state = SessionState::RUNNING;
+    m_start = start;
+    m_stop = start;
+    m_pauseStart = start;
+    m_lastActivity = start;
+    m_pausedTotal = Duration::zero();
+    m_idleTotal = Duration::zero();
+}
+
+void SessionClock::Pause(TimePoint when)
+{
+    if (m_state != SessionState::RUNNING) return;
+
+    when = std::max(when, m_start);
+    m_idleTotal += OpenIdle(when);
+    m_pauseStart = when;
+    m_state = SessionState::PAUSED;
+}
+
+SessionClock::Duration SessionClock::Resume(TimePoint when)
+{
+    if (m_state != SessionState::PAUSED) return Duration::zero();
+
+    when = std::max(when, m_pauseStart);
+    Duration paused = when - m_pauseStart;
+    m_pausedTotal += paused;
+    m_lastActivity = when;
+    m_state = SessionState::RUNNING;
+    return paused;
+}
+
+void SessionClock::Stop(TimePoint when)
+{
+    if (m_state == SessionState::STOPPED) return;
+
+    if (m_state == SessionState::PAUSED) {
+        when = std::max(when, m_pauseStart);
+        m_pausedTotal += when - m_pauseStart;
+    } else {
+        when = std::max(when, m_start);
+        m_idleTotal += OpenIdle(when);
+    }
+    m_stop = when;
+    m_state = SessionState::STOPPED;
+}
+
+void SessionClock::MarkActivity(TimePoint when)
+{
+    if (m_state != SessionState::RUNNING || when <= m_lastActivity) return;
+
+    m_idleTotal += OpenIdle(when);
+    m_lastActivity = when;
+}
+
+SessionClock::Duration SessionClock::OpenIdle(TimePoint when) const
+{
+    TimePoint idleStart = m_lastActivity + m_idleThreshold;
+    return when > idleStart ? when - idleStart : Duration::zero();
+}
+
+long long SessionClock::ElapsedMs(TimePoint now) const
+{
+    TimePoint end = m_state == SessionState::STOPPED ? m_stop : now;
+    return end > m_start ? ToMs(end - m_start) : 0;
+}
+
+long long SessionClock::PausedMs(TimePoint now) const
+{
+    Duration paused = m_pausedTotal;
+    if (m_state == SessionState::PAUSED && now > m_pauseStart) {
+        paused += now - m_pauseStart;
+    }
+    return ToMs(paused);
+}
+
+long long SessionClock::IdleMs(TimePoint now) const
+{
+    Duration idle = m_idleTotal;
+    if (m_state == SessionState::RUNNING) {
+        idle += OpenIdle(now);
+    }
+    return ToMs(idle);
+}
+
+} // namespace AnxietyMonitor
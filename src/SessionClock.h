@@ -0,0 +1,78 @@
+#ifndef SESSION_CLOCK_H
+#define SESSION_CLOCK_H
+
+#include <chrono>
+#include "MetricsData.h"
+
+namespace AnxietyMonitor {
+
+/**
+ * @class SessionClock
+ * @brief Splits session time into running, paused and idle spans.
+ *
+ * Each kind of span keeps a closed total plus at most one open span
+ * (the current pause, or the idle time since the last activity), so every
+ * query is O(1) and nothing has to be rescanned:
+ *
+ *   elapsed = running + paused        (start .. now, or .. Stop())
+ *   running = active + idle
+ *
+ * Idle time starts once no activity has been marked for the idle
+ * threshold and ends at the next activity, pause or stop. Time points must
+ * come from one monotonic timeline (live steady clock or a replay).
+ */
+class SessionClock {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+    using Duration = std::chrono::steady_clock::duration;
+
+    explicit SessionClock(long long idleThresholdMs = 2000);
+
+    void SetIdleThreshold(long long idleThresholdMs);
+
+    void Start(TimePoint start);
+    void Pause(TimePoint when);
+
+    /**
+     * @brief Resume a paused session; the resume counts as activity.
+     * @return Length of the pause that just ended (zero if not paused)
+     */
+    Duration Resume(TimePoint when);
+
+    void Stop(TimePoint when);
+
+    // User activity (ends an idle span); ignored unless running
+    void MarkActivity(TimePoint when);
+
+    SessionState GetState() const { return m_state; }
+    TimePoint GetStartTime() const { return m_start; }
+
+    // Span totals as of `now` (all 0 before Start)
+    long long ElapsedMs(TimePoint now) const;
+    long long PausedMs(TimePoint now) const;
+    long long RunningMs(TimePoint now) const { return ElapsedMs(now) - PausedMs(now); }
+    long long IdleMs(TimePoint now) const;
+    long long ActiveMs(TimePoint now) const { return RunningMs(now) - IdleMs(now); }
+
+private:
+    // Idle part of the open span at `when` (caller checks the state)
+    Duration OpenIdle(TimePoint when) const;
+
+    static long long ToMs(Duration d) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+    }
+
+private:
+    SessionState m_state;
+    TimePoint m_start;
+    TimePoint m_stop;
+    TimePoint m_pauseStart;
+    TimePoint m_lastActivity;
+    Duration m_pausedTotal;         // Closed pauses
+    Duration m_idleTotal;           // Closed idle spans
+    Duration m_idleThreshold;
+};
+
+} // namespace AnxietyMonitor
+
+#endif // SESSION_CLOCK_H
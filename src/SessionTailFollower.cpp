@@ -0,0 +1,303 @@
+#include "SessionTailFollower.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <thread>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ANXIETY_TAIL_PREAD 1
+#endif
+
+namespace AnxietyMonitor {
+
+namespace {
+
+bool IsCsvName(const std::string& name)
+{
+    return name.size() > 4 && name.compare(name.size() - 4, 4, ".csv") == 0;
+}
+
+// Size and identity of `path`; false if it is gone. Without inodes
+// (Windows) a replacement is only noticed when the file shrinks.
+bool StatFile(const std::string& path, uint64_t& size, uint64_t& inode)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) return false;
+    size = static_cast<uint64_t>(info.st_size);
+    inode = static_cast<uint64_t>(info.st_ino);
+    return true;
+#else
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error)) return false;
+    size = static_cast<uint64_t>(std::filesystem::file_size(path, error));
+    inode = 0;
+    return !error;
+#endif
+}
+
+} // namespace
+
+SessionTailFollower::SessionTailFollower()
+    : m_notifyFd(-1)
+    , m_bytesRead(0)
+{
+}
+
+SessionTailFollower::~SessionTailFollower()
+{
+    Close();
+}
+
+// ============================================================================
+// Watch control
+// ============================================================================
+
+bool SessionTailFollower::Watch(const std::string& directory)
+{
+    Close();
+    m_files.clear();
+    m_sessions.clear();
+    m_bytesRead = 0;
+    m_lastError.clear();
+
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        m_lastError = "Not a directory: " + directory;
+        return false;
+    }
+
+#if defined(__linux__)
+    // Watch before the first scan so no append falls in between
+    m_notifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    const uint32_t mask = IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE |
+                          IN_MOVED_FROM | IN_MOVED_TO;
+    if (m_notifyFd < 0 || inotify_add_watch(m_notifyFd, directory.c_str(), mask) < 0) {
+        m_lastError = "inotify failed for " + directory + ": " + std::strerror(errno);
+        Close();
+        return false;
+    }
+#endif
+
+    m_directory = directory;
+    ScanDirectory();
+    return true;
+}
+
+void SessionTailFollower::Close()
+{
+#if defined(__linux__)
+    if (m_notifyFd >= 0) close(m_notifyFd);
+#endif
+    m_notifyFd = -1;
+    m_directory.clear();
+}
+
+size_t SessionTailFollower::Poll(int timeoutMs)
+{
+    if (m_directory.empty()) return 0;
+
+#if defined(__linux__)
+    pollfd entry = {m_notifyFd, POLLIN, 0};
+    if (poll(&entry, 1, timeoutMs) <= 0) return 0;
+
+    // Coalesce: a writer flushing row by row raises one event per row
+    std::set<std::string> changed;
+    bool overflow = false;
+    alignas(inotify_event) char events[16384];
+    for (;;) {
+        ssize_t length = read(m_notifyFd, events, sizeof(events));
+        if (length <= 0) break;
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(events + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            if (event->mask & IN_Q_OVERFLOW) overflow = true;
+            if (event->len > 0 && IsCsvName(event->name)) changed.insert(event->name);
+        }
+    }
+    if (overflow) return ScanDirectory();
+
+    size_t rows = 0;
+    for (const std::string& name : changed) {
+        rows += Ingest(name);
+    }
+    return rows;
+#else
+    if (timeoutMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+    return ScanDirectory();
+#endif
+}
+
+size_t SessionTailFollower::ScanDirectory()
+{
+    std::set<std::string> present;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error)) {
+        std::string name = it->path().filename().string();
+        if (IsCsvName(name)) present.insert(name);
+    }
+
+    std::vector<std::string> gone;
+    for (const auto& file : m_files) {
+        if (!present.count(file.first)) gone.push_back(file.first);
+    }
+    for (const std::string& name : gone) {
+        Forget(name);
+    }
+
+    size_t rows = 0;
+    for (const std::string& name : present) {
+        rows += Ingest(name);
+    }
+    return rows;
+}
+
+void SessionTailFollower::Forget(const std::string& name)
+{
+    m_files.erase(name);
+    m_sessions.erase(name);
+}
+
+// ============================================================================
+// Ingestion
+// ============================================================================
+
+size_t SessionTailFollower::Ingest(const std::string& name)
+{
+    std::string path = (std::filesystem::path(m_directory) / name).string();
+    uint64_t size = 0;
+    uint64_t inode = 0;
+    if (!StatFile(path, size, inode)) {
+        Forget(name);
+        return 0;
+    }
+
+    FileState& file = m_files[name];
+    if (inode != file.inode || size < file.offset) {
+        // Truncated or replaced (rotation): start over
+        bool seen = file.headerRead;
+        file = FileState();
+        file.inode = inode;
+        auto stats = m_sessions.find(name);
+        if (seen && stats != m_sessions.end()) {
+            int resets = stats->second.resets + 1;
+            stats->second = TailSessionStats();
+            stats->second.fileName = name;
+            stats->second.resets = resets;
+        }
+    }
+    if (file.ignored) {
+        file.offset = size;
+        return 0;
+    }
+    if (size == file.offset) return 0;
+
+#if defined(ANXIETY_TAIL_PREAD)
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+#else
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in.is_open()) return 0;
+    in.seekg(static_cast<std::streamoff>(file.offset));
+#endif
+
+    // Bytes past the last complete record wait at the front of the buffer;
+    // at the end they are dropped and read again with the next change
+    size_t rows = 0;
+    size_t pending = 0;
+    uint64_t position = file.offset;
+    while (!file.ignored) {
+        if (m_buffer.size() < pending + READ_CHUNK_BYTES) m_buffer.resize(pending + READ_CHUNK_BYTES);
+#if defined(ANXIETY_TAIL_PREAD)
+        ssize_t result = pread(fd, m_buffer.data() + pending, READ_CHUNK_BYTES, static_cast<off_t>(position));
+        size_t got = result > 0 ? static_cast<size_t>(result) : 0;
+#else
+        in.read(m_buffer.data() + pending, static_cast<std::streamsize>(READ_CHUNK_BYTES));
+        size_t got = static_cast<size_t>(in.gcount());
+#endif
+        if (got == 0) break;
+
+        // A partial record read last time is read again; count it once
+        position += got;
+        if (position > file.readEnd) {
+            m_bytesRead += position - std::max(file.readEnd, position - got);
+            file.readEnd = position;
+        }
+
+        size_t length = pending + got;
+        size_t consumed = ParseRecords(name, file, length, rows);
+        file.offset += consumed;
+        pending = length - consumed;
+        std::memmove(m_buffer.data(), m_buffer.data() + consumed, pending);
+    }
+#if defined(ANXIETY_TAIL_PREAD)
+    close(fd);
+#endif
+    if (file.ignored) file.offset = size;
+    return rows;
+}
+
+size_t SessionTailFollower::ParseRecords(const std::string& name, FileState& file, size_t length, size_t& rows)
+{
+    TailSessionStats* stats = nullptr;
+    if (file.headerRead) stats = &m_sessions[name];
+
+    MetricsSnapshot row;
+    size_t consumed = 0;
+    while (consumed < length) {
+        size_t used = CSVReader::ParseRecord(m_buffer.data() + consumed, length - consumed, m_fields);
+        if (used == 0) break;
+        consumed += used;
+
+        if (!file.headerRead) {
+            file.headerRead = true;
+            if (!file.columns.SetHeader(m_fields)) {
+                file.ignored = true;
+                return consumed;
+            }
+            stats = &m_sessions[name];
+            stats->fileName = name;
+            continue;
+        }
+        if (!file.columns.ParseRow(m_fields, row)) continue;
+
+        ++stats->rows;
+        stats->scoreSum += row.anxietyScore;
+        stats->scoreMax = std::max(stats->scoreMax, row.anxietyScore);
+        RiskLevel level;
+        if (ParseRiskLevelLabel(row.riskLevel, level)) ++stats->rowsByRisk[static_cast<int>(level)];
+        stats->sessionId = row.sessionId;
+        stats->latest = std::move(row);
+        ++rows;
+    }
+    return consumed;
+}
+
+TailTotals SessionTailFollower::GetTotals() const
+{
+    TailTotals totals;
+    for (const auto& session : m_sessions) {
+        const TailSessionStats& stats = session.second;
+        ++totals.sessions;
+        totals.rows += stats.rows;
+        totals.scoreSum += stats.scoreSum;
+        totals.scoreMax = std::max(totals.scoreMax, stats.scoreMax);
+        for (int level = 0; level < 4; ++level) {
+            totals.rowsByRisk[level] += stats.rowsByRisk[level];
+        }
+    }
+    return totals;
+}
+
+} // namespace AnxietyMonitor
@@ -0,0 +1,125 @@
+#ifndef SESSION_TAIL_FOLLOWER_H
+#define SESSION_TAIL_FOLLOWER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "CSVReader.h"
+#include "MetricsData.h"
+
+namespace AnxietyMonitor {
+
+/**
+ * @brief Running totals for one followed session file.
+ */
+struct TailSessionStats {
+    std::string fileName;
+    std::string sessionId;          // From the latest row
+    size_t rows = 0;
+    double scoreSum = 0.0;
+    double scoreMax = 0.0;
+    size_t rowsByRisk[4] = {0, 0, 0, 0};    // Indexed by RiskLevel
+    MetricsSnapshot latest = MetricsSnapshot();
+    int resets = 0;                 // Truncations / replacements seen
+
+    double MeanScore() const { return rows > 0 ? scoreSum / rows : 0.0; }
+};
+
+/**
+ * @brief Totals over every followed session file.
+ */
+struct TailTotals {
+    size_t sessions = 0;
+    size_t rows = 0;
+    double scoreSum = 0.0;
+    double scoreMax = 0.0;
+    size_t rowsByRisk[4] = {0, 0, 0, 0};
+
+    double MeanScore() const { return rows > 0 ? scoreSum / rows : 0.0; }
+};
+
+/**
+ * @class SessionTailFollower
+ * @brief Follows a directory of session CSVs and ingests appended rows.
+ *
+ * Each file keeps its byte offset up to the last complete record, so a
+ * change costs an open() and one pread() per 64 KB of new bytes (a stream
+ * read off POSIX), never a re-read of the file. A partial trailing record
+ * (the writer mid-line, or a quoted field spanning lines) stays unconsumed
+ * and is read again once its newline arrives. A file that
+ * shrinks or is replaced under the same name (different inode) is read
+ * again from the start and its totals restart.
+ *
+ * - Linux: inotify on the directory; Poll() wakes only for changed files.
+ * - Elsewhere: Poll() compares file sizes in a directory scan.
+ *
+ * CSVs without an anxiety_score column (e.g. anxiety_events_*.csv) are
+ * skipped after their header. Not thread-safe: call from one thread.
+ */
+class SessionTailFollower {
+public:
+    static const size_t READ_CHUNK_BYTES = 64 * 1024;
+
+    SessionTailFollower();
+    ~SessionTailFollower();
+
+    SessionTailFollower(const SessionTailFollower&) = delete;
+    SessionTailFollower& operator=(const SessionTailFollower&) = delete;
+
+    /**
+     * @brief Start following `directory` and ingest its existing files.
+     * @return false if the directory cannot be watched; see GetLastError()
+     */
+    bool Watch(const std::string& directory);
+
+    void Close();
+
+    /**
+     * @brief Wait up to timeoutMs for changes and ingest them.
+     * @return Rows ingested
+     */
+    size_t Poll(int timeoutMs = 0);
+
+    // Descriptor that becomes readable on changes (inotify), or -1
+    int GetNotifyFd() const { return m_notifyFd; }
+
+    // Per file, keyed by file name
+    const std::map<std::string, TailSessionStats>& GetSessions() const { return m_sessions; }
+    TailTotals GetTotals() const;
+
+    // Distinct file bytes read since Watch(): tracks appended data only (a
+    // re-read partial record counts once)
+    uint64_t GetBytesRead() const { return m_bytesRead; }
+    const std::string& GetLastError() const { return m_lastError; }
+
+private:
+    struct FileState {
+        uint64_t offset = 0;        // End of the last complete record
+        uint64_t readEnd = 0;       // Furthest byte read (counted in m_bytesRead)
+        uint64_t inode = 0;
+        bool headerRead = false;
+        bool ignored = false;       // Not a session CSV
+        CSVReader columns;          // Header mapping only (no file open)
+    };
+
+    // Read whatever was appended to `name` since its offset
+    size_t Ingest(const std::string& name);
+    size_t ParseRecords(const std::string& name, FileState& file, size_t length, size_t& rows);
+    size_t ScanDirectory();
+    void Forget(const std::string& name);
+
+    std::string m_directory;
+    int m_notifyFd;
+    std::map<std::string, FileState> m_files;
+    std::map<std::string, TailSessionStats> m_sessions;
+    std::vector<char> m_buffer;
+    std::vector<std::string> m_fields;
+    uint64_t m_bytesRead;
+    std::string m_lastError;
+};
+
+} // namespace AnxietyMonitor
+
+#endif // SESSION_TAIL_FOLLOWER_H
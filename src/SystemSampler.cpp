@@ -0,0 +1,240 @@
+#include "SystemSampler.h"
+#include <chrono>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+namespace AnxietyMonitor {
+
+namespace {
+
+// Skip spaces/tabs; returns new position
+size_t SkipBlanks(const char* buffer, size_t length, size_t pos)
+{
+    while (pos < length && (buffer[pos] == ' ' || buffer[pos] == '\t')) ++pos;
+    return pos;
+}
+
+// Parse an unsigned decimal at pos; false if none present
+bool ParseUnsigned(const char* buffer, size_t length, size_t& pos, unsigned long long& value)
+{
+    pos = SkipBlanks(buffer, length, pos);
+    if (pos >= length || buffer[pos] < '0' || buffer[pos] > '9') return false;
+    
+    value = 0;
+    while (pos < length && buffer[pos] >= '0' && buffer[pos] <= '9') {
+        value = value * 10 + static_cast<unsigned long long>(buffer[pos] - '0');
+        ++pos;
+    }
+    return true;
+}
+
+#ifdef _WIN32
+unsigned long long FileTimeToTicks(const FILETIME& ft)
+{
+    return (static_cast<unsigned long long>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+}
+#endif
+
+} // namespace
+
+SystemSampler::SystemSampler()
+    : m_cpuUsage(0.0)
+    , m_memoryUsageMb(0.0)
+    , m_hasPreviousCpu(false)
+    , m_procStatFd(-1)
+    , m_statmFd(-1)
+    , m_pageSize(4096)
+    , m_stopRequested(false)
+{
+#if defined(__linux__)
+    m_procStatFd = ::open("/proc/stat", O_RDONLY | O_CLOEXEC);
+    m_statmFd = ::open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    long pageSize = ::sysconf(_SC_PAGESIZE);
+    if (pageSize > 0) m_pageSize = pageSize;
+#endif
+}
+
+SystemSampler::~SystemSampler()
+{
+    Stop();
+#if defined(__linux__)
+    if (m_procStatFd >= 0) ::close(m_procStatFd);
+    if (m_statmFd >= 0) ::close(m_statmFd);
+#endif
+}
+
+// ============================================================================
+// Thread control
+// ============================================================================
+
+void SystemSampler::Start(int intervalMs)
+{
+    if (m_thread.joinable()) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_stopRequested = false;
+    }
+    m_hasPreviousCpu = false;
+    m_thread = std::thread(&SystemSampler::Run, this, intervalMs > 0 ? intervalMs : 1000);
+}
+
+void SystemSampler::Stop()
+{
+    if (!m_thread.joinable()) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_stopRequested = true;
+    }
+    m_stopCondition.notify_all();
+    m_thread.join();
+}
+
+void SystemSampler::Run(int intervalMs)
+{
+    // Baseline immediately so the first interval already yields CPU usage
+    SampleOnce();
+    
+    std::unique_lock<std::mutex> lock(m_stopMutex);
+    while (!m_stopCondition.wait_for(lock, std::chrono::milliseconds(intervalMs),
+                                     [this] { return m_stopRequested; })) {
+        lock.unlock();
+        SampleOnce();
+        lock.lock();
+    }
+}
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+void SystemSampler::SampleOnce()
+{
+    CpuTimes current;
+    if (ReadCpuTimes(current)) {
+        if (m_hasPreviousCpu) {
+            m_cpuUsage.store(CpuUsageBetween(m_previousCpu, current),
+                             std::memory_order_relaxed);
+        }
+        m_previousCpu = current;
+        m_hasPreviousCpu = true;
+    }
+    
+    unsigned long long residentBytes = 0;
+    if (ReadResidentBytes(residentBytes)) {
+        m_memoryUsageMb.store(residentBytes / (1024.0 * 1024.0),
+                              std::memory_order_relaxed);
+    }
+}
+
+bool SystemSampler::ReadCpuTimes(CpuTimes& times)
+{
+#if defined(__linux__)
+    if (m_procStatFd < 0) return false;
+    
+    // The aggregate line comes first; 512 bytes covers it on any machine
+    char buffer[512];
+    ssize_t n = ::pread(m_procStatFd, buffer, sizeof(buffer), 0);
+    if (n <= 0) return false;
+    return ParseProcStat(buffer, static_cast<size_t>(n), times);
+#elif defined(_WIN32)
+    FILETIME idle, kernel, user;
+    if (!GetSystemTimes(&idle, &kernel, &user)) return false;
+    
+    // Kernel time includes idle time
+    unsigned long long idleTicks = FileTimeToTicks(idle);
+    times.total = FileTimeToTicks(kernel) + FileTimeToTicks(user);
+    times.busy = times.total - idleTicks;
+    return true;
+#else
+    (void)times;
+    return false;
+#endif
+}
+
+bool SystemSampler::ReadResidentBytes(unsigned long long& bytes)
+{
+#if defined(__linux__)
+    if (m_statmFd < 0) return false;
+    
+    char buffer[128];
+    ssize_t n = ::pread(m_statmFd, buffer, sizeof(buffer), 0);
+    if (n <= 0) return false;
+    
+    unsigned long long residentPages = 0;
+    if (!ParseStatmResident(buffer, static_cast<size_t>(n), residentPages)) return false;
+    bytes = residentPages * static_cast<unsigned long long>(m_pageSize);
+    return true;
+#elif defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return false;
+    bytes = counters.WorkingSetSize;
+    return true;
+#else
+    (void)bytes;
+    return false;
+#endif
+}
+
+// ============================================================================
+// Parsing
+// ============================================================================
+
+bool SystemSampler::ParseProcStat(const char* buffer, size_t length, CpuTimes& times)
+{
+    // "cpu  user nice system idle iowait irq softirq steal guest guest_nice"
+    if (length < 4 || buffer[0] != 'c' || buffer[1] != 'p' || buffer[2] != 'u' ||
+        (buffer[3] != ' ' && buffer[3] != '\t')) {
+        return false;
+    }
+    
+    unsigned long long fields[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    size_t pos = 3;
+    int parsed = 0;
+    
+    // guest/guest_nice are already included in user/nice, so stop at steal
+    while (parsed < 8 && ParseUnsigned(buffer, length, pos, fields[parsed])) {
+        ++parsed;
+    }
+    if (parsed < 4) return false;
+    
+    unsigned long long idle = fields[3] + fields[4];   // idle + iowait
+    times.total = 0;
+    for (int i = 0; i < parsed; ++i) {
+        times.total += fields[i];
+    }
+    times.busy = times.total - idle;
+    return true;
+}
+
+bool SystemSampler::ParseStatmResident(const char* buffer, size_t length,
+                                       unsigned long long& residentPages)
+{
+    // "size resident shared text lib data dt" (pages)
+    size_t pos = 0;
+    unsigned long long size = 0;
+    if (!ParseUnsigned(buffer, length, pos, size)) return false;
+    return ParseUnsigned(buffer, length, pos, residentPages);
+}
+
+double SystemSampler::CpuUsageBetween(const CpuTimes& previous, const CpuTimes& current)
+{
+    if (current.total <= previous.total || current.busy < previous.busy) return 0.0;
+    
+    double totalDelta = static_cast<double>(current.total - previous.total);
+    double busyDelta = static_cast<double>(current.busy - previous.busy);
+    double usage = 100.0 * busyDelta / totalDelta;
+    return usage > 100.0 ? 100.0 : usage;
+}
+
+} // namespace AnxietyMonitor
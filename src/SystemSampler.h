@@ -0,0 +1,109 @@
+#ifndef SYSTEM_SAMPLER_H
+#define SYSTEM_SAMPLER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+namespace AnxietyMonitor {
+
+/**
+ * @class SystemSampler
+ * @brief Background sampler for machine CPU load and IDE memory use.
+ *
+ * Runs on its own thread at a fixed cadence and publishes the latest values
+ * through atomics, so snapshot code reads them without locks or syscalls.
+ *
+ * - Linux: /proc/stat (system CPU) and /proc/self/statm (process RSS), each
+ *   opened once and re-read with pread() into a stack buffer; the fields
+ *   are parsed by hand (no streams, no allocation).
+ * - Windows: GetSystemTimes() and GetProcessMemoryInfo().
+ * - Elsewhere: values stay 0.
+ *
+ * CPU usage is machine-wide, so a background build shows up as load
+ * without being mistaken for user behaviour.
+ */
+class SystemSampler {
+public:
+    // Cumulative CPU time counters (platform ticks)
+    struct CpuTimes {
+        unsigned long long busy = 0;
+        unsigned long long total = 0;
+    };
+    
+    SystemSampler();
+    ~SystemSampler();
+    
+    SystemSampler(const SystemSampler&) = delete;
+    SystemSampler& operator=(const SystemSampler&) = delete;
+    
+    /**
+     * @brief Start the sampling thread (no-op if already running).
+     * @param intervalMs Sampling cadence
+     */
+    void Start(int intervalMs);
+    
+    /**
+     * @brief Stop and join the sampling thread.
+     */
+    void Stop();
+    
+    bool IsRunning() const { return m_thread.joinable(); }
+    
+    /**
+     * @brief Take one sample on the calling thread.
+     * CPU usage needs two samples; the first only sets the baseline.
+     */
+    void SampleOnce();
+    
+    // Machine-wide CPU usage over the last interval (0-100%)
+    double GetCpuUsage() const { return m_cpuUsage.load(std::memory_order_relaxed); }
+    
+    // IDE process resident memory (MB)
+    double GetMemoryUsageMb() const { return m_memoryUsageMb.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Parse the aggregate "cpu" line of /proc/stat.
+     * @return false if the buffer does not start with a cpu line
+     */
+    static bool ParseProcStat(const char* buffer, size_t length, CpuTimes& times);
+    
+    /**
+     * @brief Parse the resident-pages field of /proc/self/statm.
+     */
+    static bool ParseStatmResident(const char* buffer, size_t length,
+                                   unsigned long long& residentPages);
+    
+    /**
+     * @brief CPU usage (0-100%) between two counter readings.
+     */
+    static double CpuUsageBetween(const CpuTimes& previous, const CpuTimes& current);
+
+private:
+    void Run(int intervalMs);
+    bool ReadCpuTimes(CpuTimes& times);
+    bool ReadResidentBytes(unsigned long long& bytes);
+
+private:
+    std::atomic<double> m_cpuUsage;
+    std::atomic<double> m_memoryUsageMb;
+    
+    CpuTimes m_previousCpu;
+    bool m_hasPreviousCpu;
+    
+    // Reused descriptors (Linux); -1 when unavailable
+    int m_procStatFd;
+    int m_statmFd;
+    long m_pageSize;
+    
+    std::thread m_thread;
+    std::mutex m_stopMutex;
+    std::condition_variable m_stopCondition;
+    bool m_stopRequested;
+};
+
+} // namespace AnxietyMonitor
+
+#endif // SYSTEM_SAMPLER_H
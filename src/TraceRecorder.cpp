@@ -0,0 +1,199 @@
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace AnxietyMonitor {
+
+std::atomic<bool> TraceRecorder::s_enabled{false};
+
+namespace {
+
+// ============================================================================
+// Per-Thread Ring
+// ============================================================================
+
+/**
+ * Single-writer ring. The owning thread is the only writer; a slot's
+ * sequence is odd while it is being written and 2 * (index + 1) once the
+ * span at that index is complete, so readers can validate what they copy.
+ */
+class ThreadRing {
+public:
+    explicit ThreadRing(int tid) : m_tid(tid), m_head(0) {}
+
+    void Append(const char* name, uint64_t start, uint64_t end) noexcept {
+        uint64_t n = m_head.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[n & MASK];
+
+        slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        slot.sequence.store(2 * n + 2, std::memory_order_release);
+
+        m_head.store(n + 1, std::memory_order_release);
+    }
+
+    struct Span {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+        int tid;
+    };
+
+    // Copy out complete spans that started at or after minStart
+    void Collect(uint64_t minStart, std::vector<Span>& out) const {
+        uint64_t head = m_head.load(std::memory_order_acquire);
+        uint64_t first = head > TraceRecorder::RING_CAPACITY
+                             ? head - TraceRecorder::RING_CAPACITY : 0;
+
+        for (uint64_t n = first; n < head; ++n) {
+            const Slot& slot = m_slots[n & MASK];
+            uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * n + 2) continue;   // Overwritten since
+
+            Span span;
+            span.name = slot.name.load(std::memory_order_relaxed);
+            span.start = slot.start.load(std::memory_order_relaxed);
+            span.end = slot.end.load(std::memory_order_relaxed);
+            span.tid = m_tid;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+            if (span.name && span.start >= minStart) {
+                out.push_back(span);
+            }
+        }
+    }
+
+private:
+    static const uint64_t MASK = TraceRecorder::RING_CAPACITY - 1;
+
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> start{0};
+        std::atomic<uint64_t> end{0};
+    };
+
+    const int m_tid;
+    alignas(64) std::atomic<uint64_t> m_head;
+    Slot m_slots[TraceRecorder::RING_CAPACITY];
+};
+
+static_assert((TraceRecorder::RING_CAPACITY & (TraceRecorder::RING_CAPACITY - 1)) == 0,
+              "RING_CAPACITY must be a power of two");
+
+// Rings outlive their threads so spans from finished threads still dump
+struct RingRegistry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+};
+
+RingRegistry& GetRegistry()
+{
+    static RingRegistry registry;
+    return registry;
+}
+
+// Taken only once per thread, on its first recorded span
+ThreadRing* RegisterThread()
+{
+    RingRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    int tid = static_cast<int>(registry.rings.size()) + 1;
+    registry.rings.push_back(std::make_unique<ThreadRing>(tid));
+    return registry.rings.back().get();
+}
+
+thread_local ThreadRing* t_ring = nullptr;
+
+std::atomic<uint64_t> g_clearTicks{0};
+
+void WriteJsonString(std::ostream& out, const char* text)
+{
+    out << '"';
+    for (const char* p = text; *p; ++p) {
+        if (*p == '"' || *p == '\\') out << '\\';
+        out << *p;
+    }
+    out << '"';
+}
+
+} // namespace
+
+// ============================================================================
+// TraceRecorder
+// ============================================================================
+
+void TraceRecorder::Record(const char* name, uint64_t startTicks, uint64_t endTicks)
+{
+    if (!t_ring) {
+        t_ring = RegisterThread();
+    }
+    t_ring->Append(name, startTicks, endTicks);
+}
+
+void TraceRecorder::Clear() noexcept
+{
+    g_clearTicks.store(ProbeClock::Now(), std::memory_order_relaxed);
+}
+
+size_t TraceRecorder::WriteChromeTrace(std::ostream& out)
+{
+    std::vector<ThreadRing::Span> spans;
+    uint64_t minStart = g_clearTicks.load(std::memory_order_relaxed);
+    {
+        RingRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto& ring : registry.rings) {
+            ring->Collect(minStart, spans);
+        }
+    }
+
+    std::sort(spans.begin(), spans.end(),
+              [](const ThreadRing::Span& a, const ThreadRing::Span& b) {
+                  return a.start < b.start;
+              });
+
+    // Timestamps in microseconds, relative to the first retained span
+    double usPerTick = ProbeClock::NsPerTick() / 1000.0;
+    uint64_t base = spans.empty() ? 0 : spans.front().start;
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+           "\"args\":{\"name\":\"AnxietyMonitor\"}}";
+
+    out << std::fixed << std::setprecision(3);
+    for (const auto& span : spans) {
+        uint64_t duration = span.end > span.start ? span.end - span.start : 0;
+        out << ",\n{\"name\":";
+        WriteJsonString(out, span.name);
+        out << ",\"cat\":\"anxiety\",\"ph\":\"X\""
+            << ",\"ts\":" << static_cast<double>(span.start - base) * usPerTick
+            << ",\"dur\":" << static_cast<double>(duration) * usPerTick
+            << ",\"pid\":1,\"tid\":" << span.tid << "}";
+    }
+    out << "\n]}\n";
+
+    return spans.size();
+}
+
+bool TraceRecorder::WriteChromeTraceFile(const std::string& path)
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    WriteChromeTrace(file);
+    file.flush();
+    return file.good();
+}
+
+} // namespace AnxietyMonitor
@@ -0,0 +1,107 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "Instrumentation.h"
+
+namespace AnxietyMonitor {
+
+/**
+ * @class TraceRecorder
+ * @brief Opt-in span recorder with Chrome trace_event JSON export.
+ *
+ * Each thread that records a span gets its own fixed ring (allocated on its
+ * first span while tracing is enabled), so recording never locks and never
+ * contends with other threads. A full ring overwrites its oldest spans.
+ * Slots carry a sequence number, so a dump running concurrently with the
+ * writer skips slots that are mid-overwrite instead of emitting torn spans.
+ *
+ * The dump opens in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ */
+class TraceRecorder {
+public:
+    // Spans retained per thread (power of two)
+    static constexpr size_t RING_CAPACITY = 16384;
+
+    static bool IsEnabled() noexcept {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    static void SetEnabled(bool enabled) noexcept {
+        s_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Append a completed span to the calling thread's ring.
+     * @param name Static string (string literal); stored by pointer
+     * @param startTicks / endTicks ProbeClock ticks
+     */
+    static void Record(const char* name, uint64_t startTicks, uint64_t endTicks);
+
+    /**
+     * @brief Forget spans recorded so far (lock-free: later dumps skip
+     * anything that started before this call).
+     */
+    static void Clear() noexcept;
+
+    /**
+     * @brief Write retained spans as Chrome trace_event JSON.
+     * @return Number of spans written
+     */
+    static size_t WriteChromeTrace(std::ostream& out);
+
+    /**
+     * @brief Write retained spans to a JSON file.
+     * @return false if the file could not be written
+     */
+    static bool WriteChromeTraceFile(const std::string& path);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @class TraceSpan
+ * @brief Records the lifetime of a scope as a trace span.
+ *
+ * When tracing is off the cost is one relaxed load and a not-taken branch
+ * on entry (exit re-tests a local). Use through ANXIETY_TRACE.
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) noexcept : m_name(nullptr), m_start(0) {
+        if (TraceRecorder::IsEnabled()) {
+            m_name = name;
+            m_start = ProbeClock::Now();
+        }
+    }
+
+    ~TraceSpan() {
+        if (m_name) {
+            TraceRecorder::Record(m_name, m_start, ProbeClock::Now());
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_start;
+};
+
+} // namespace AnxietyMonitor
+
+// Compiled out together with the overhead probes
+#ifdef ANXIETY_NO_INSTRUMENTATION
+#define ANXIETY_TRACE(name) ((void)0)
+#else
+#define ANXIETY_TRACE(name) \
+    ::AnxietyMonitor::TraceSpan ANXIETY_PROBE_CONCAT(anxietyTrace_, __LINE__)(name)
+#endif
+
+#endif // TRACE_RECORDER_H
@@ -0,0 +1,63 @@
+#include "TrendRing.h"
+#include <algorithm>
+
+namespace AnxietyMonitor {
+
+TrendRing::TrendRing(size_t columns, long long columnMs)
+    : m_columns(columns > 0 ? columns : 1)
+    , m_head(0)
+    , m_size(0)
+    , m_columnMs(columnMs > 0 ? columnMs : 1)
+{
+}
+
+void TrendRing::Clear()
+{
+    m_head = 0;
+    m_size = 0;
+}
+
+void TrendRing::OpenColumn()
+{
+    if (m_size > 0) {
+        m_head = (m_head + 1) % m_columns.size();
+    }
+    m_size = std::min(m_size + 1, m_columns.size());
+    m_columns[m_head] = Column{0.0f, 0.0f, 0.0f, 0};
+}
+
+size_t TrendRing::Add(double score, std::chrono::steady_clock::time_point when)
+{
+    size_t closed = 0;
+    
+    if (m_size == 0) {
+        m_columnStart = when;
+        OpenColumn();
+    } else if (when >= m_columnStart + std::chrono::milliseconds(m_columnMs)) {
+        long long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            when - m_columnStart).count() / m_columnMs;
+        m_columnStart += std::chrono::milliseconds(elapsed * m_columnMs);
+        
+        // Beyond one full ring everything is a gap anyway
+        closed = static_cast<size_t>(std::min<long long>(elapsed, static_cast<long long>(m_columns.size())));
+        for (size_t i = 0; i < closed; ++i) {
+            OpenColumn();
+        }
+    }
+    
+    // Samples from before the open column (clock skew) count toward it
+    Column& column = m_columns[m_head];
+    float value = static_cast<float>(score);
+    if (column.count == 0) {
+        column.minScore = column.maxScore = value;
+    } else {
+        column.minScore = std::min(column.minScore, value);
+        column.maxScore = std::max(column.maxScore, value);
+    }
+    column.lastScore = value;
+    ++column.count;
+    
+    return closed;
+}
+
+} // namespace AnxietyMonitor
@@ -0,0 +1,65 @@
+#ifndef TREND_RING_H
+#define TREND_RING_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AnxietyMonitor {
+
+/**
+ * @class TrendRing
+ * @brief Fixed ring of time columns of anxiety scores (sparkline data).
+ *
+ * Each column covers a fixed span of time (e.g. 1 s for a 5-minute view of
+ * 300 columns, 12 s for a 1-hour view) and keeps the min / max / last score
+ * that fell into it. The newest column is open and still accumulating;
+ * older ones are closed. Storage is allocated once at construction.
+ *
+ * Add() reports how many columns closed, so a renderer can scroll its
+ * cached image by that many pixels and draw only the new columns.
+ */
+class TrendRing {
+public:
+    struct Column {
+        float minScore;
+        float maxScore;
+        float lastScore;
+        uint32_t count;         // Scores in the column (0 = gap)
+    };
+    
+    TrendRing(size_t columns, long long columnMs);
+    
+    /**
+     * @brief Add a score at a point in time.
+     * Time without scores (e.g. a paused session) becomes empty columns.
+     * @return Columns closed by this sample, at most Capacity()
+     */
+    size_t Add(double score, std::chrono::steady_clock::time_point when);
+    
+    void Clear();
+    
+    // Retained columns including the open one (0 before the first Add)
+    size_t Size() const { return m_size; }
+    size_t Capacity() const { return m_columns.size(); }
+    long long GetColumnMs() const { return m_columnMs; }
+    
+    // Column i in time order: 0 = oldest retained, Size() - 1 = open column
+    const Column& operator[](size_t i) const {
+        return m_columns[(m_head + m_columns.size() + 1 - m_size + i) % m_columns.size()];
+    }
+
+private:
+    void OpenColumn();
+
+    std::vector<Column> m_columns;
+    size_t m_head;              // Open column
+    size_t m_size;
+    long long m_columnMs;
+    std::chrono::steady_clock::time_point m_columnStart;
+};
+
+} // namespace AnxietyMonitor
+
+#endif // TREND_RING_H
@@ -1,7 +1,11 @@
 #include "UIComponents.h"
 #ifndef STANDALONE_BUILD
 #include <wx/datetime.h>
+#include <wx/dcclient.h>
+#include <wx/dcmemory.h>
 #endif
+#include <algorithm>
+#include <cstdio>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
@@ -9,13 +13,267 @@
 
 namespace AnxietyMonitor {
 
+namespace {
+
+wxColour RiskColour(RiskLevel level)
+{
+    switch (level) {
+        case RiskLevel::LOW:      return wxColour(76, 175, 80);   // Green
+        case RiskLevel::MODERATE: return wxColour(255, 193, 7);   // Yellow/Amber
+        case RiskLevel::HIGH:     return wxColour(255, 152, 0);   // Orange
+        case RiskLevel::CRITICAL: return wxColour(244, 67, 54);   // Red
+        default:                  return wxColour(180, 180, 180);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// TrendSparkline Implementation
+// ============================================================================
+
+namespace {
+
+const wxColour SPARKLINE_BACKGROUND(35, 35, 38);
+const wxColour SPARKLINE_GUIDE(60, 60, 64);     // Risk thresholds 30 / 60 / 80
+const wxColour SPARKLINE_HELD(90, 90, 95);      // No samples: previous score held
+
+int ScoreY(double score, int height)
+{
+    double clamped = std::max(0.0, std::min(100.0, score));
+    return (height - 1) - static_cast<int>(clamped * (height - 1) / 100.0 + 0.5);
+}
+
+} // namespace
+
+TrendSparkline::TrendSparkline(wxWindow* parent, wxWindowID id)
+    : wxWindow(parent, id, wxDefaultPosition, wxSize(-1, 40))
+    , m_minuteRing(COLUMNS, 1000)
+    , m_hourRing(COLUMNS, 12000)
+    , m_showHour(false)
+    , m_bitmapValid(false)
+{
+    // We paint every pixel from the cached bitmap; no background erase
+    SetBackgroundStyle(wxBG_STYLE_PAINT);
+    SetMinSize(wxSize(-1, 40));
+    SetToolTip("Click to switch between the last 5 minutes and the last hour");
+    
+    Bind(wxEVT_PAINT, &TrendSparkline::OnPaint, this);
+    Bind(wxEVT_SIZE, &TrendSparkline::OnSize, this);
+}
+
+void TrendSparkline::AddScore(double score, std::chrono::steady_clock::time_point when)
+{
+    size_t closedMinute = m_minuteRing.Add(score, when);
+    size_t closedHour = m_hourRing.Add(score, when);
+    
+    if (!m_bitmapValid) {
+        Refresh();      // OnPaint renders everything
+        return;
+    }
+    
+    const TrendRing& ring = ActiveRing();
+    size_t closed = m_showHour ? closedHour : closedMinute;
+    int width = m_bitmap.GetWidth();
+    int height = m_bitmap.GetHeight();
+    
+    if (closed >= static_cast<size_t>(width)) {
+        RenderAll();
+        Refresh();
+        return;
+    }
+    
+    {
+        wxMemoryDC dc(m_bitmap);
+        int shift = static_cast<int>(closed);
+        if (shift > 0) {
+            dc.Blit(0, 0, width - shift, height, &dc, shift, 0);
+        }
+        
+        // New columns only: the gaps that just closed plus the open column
+        size_t redraw = std::min(ring.Size(), std::max<size_t>(closed, 1));
+        DrawColumns(dc, ring.Size() - redraw);
+    }
+    
+    RefreshRect(closed > 0 ? wxRect(0, 0, width, height) : wxRect(width - 1, 0, 1, height));
+}
+
+void TrendSparkline::Clear()
+{
+    m_minuteRing.Clear();
+    m_hourRing.Clear();
+    m_bitmapValid = false;
+    Refresh();
+}
+
+void TrendSparkline::SetShowHour(bool showHour)
+{
+    if (showHour == m_showHour) return;
+    m_showHour = showHour;
+    m_bitmapValid = false;
+    Refresh();
+}
+
+const TrendRing& TrendSparkline::ActiveRing() const
+{
+    return m_showHour ? m_hourRing : m_minuteRing;
+}
+
+int TrendSparkline::ColumnX(size_t index) const
+{
+    // Newest (open) column at the right edge
+    return m_bitmap.GetWidth() - static_cast<int>(ActiveRing().Size()) + static_cast<int>(index);
+}
+
+void TrendSparkline::RenderAll()
+{
+    wxSize size = GetClientSize();
+    if (size.GetWidth() <= 0 || size.GetHeight() <= 0) {
+        m_bitmapValid = false;
+        return;
+    }
+    
+    if (!m_bitmap.IsOk() || m_bitmap.GetWidth() != size.GetWidth() ||
+        m_bitmap.GetHeight() != size.GetHeight()) {
+        m_bitmap = wxBitmap(size.GetWidth(), size.GetHeight());
+    }
+    
+    wxMemoryDC dc(m_bitmap);
+    dc.SetPen(wxPen(SPARKLINE_BACKGROUND));
+    dc.SetBrush(wxBrush(SPARKLINE_BACKGROUND));
+    dc.DrawRectangle(0, 0, size.GetWidth(), size.GetHeight());
+    
+    const TrendRing& ring = ActiveRing();
+    size_t visible = std::min(ring.Size(), static_cast<size_t>(size.GetWidth()));
+    DrawColumns(dc, ring.Size() - visible);
+    
+    m_bitmapValid = true;
+}
+
+void TrendSparkline::DrawColumns(wxDC& dc, size_t first)
+{
+    const TrendRing& ring = ActiveRing();
+    int height = m_bitmap.GetHeight();
+    
+    // Score held through empty columns: last one before the redrawn range
+    bool haveHeld = false;
+    float held = 0.0f;
+    for (size_t i = first; i-- > 0;) {
+        if (ring[i].count > 0) {
+            held = ring[i].lastScore;
+            haveHeld = true;
+            break;
+        }
+    }
+    
+    for (size_t i = first; i < ring.Size(); ++i) {
+        int x = ColumnX(i);
+        const TrendRing::Column& column = ring[i];
+        
+        dc.SetPen(wxPen(SPARKLINE_BACKGROUND));
+        dc.DrawLine(x, 0, x, height);
+        dc.SetPen(wxPen(SPARKLINE_GUIDE));
+        dc.DrawPoint(x, ScoreY(30, height));
+        dc.DrawPoint(x, ScoreY(60, height));
+        dc.DrawPoint(x, ScoreY(80, height));
+        
+        if (column.count > 0) {
+            dc.SetPen(wxPen(RiskColour(AnxietyScorer::GetRiskLevel(column.lastScore))));
+            dc.DrawLine(x, ScoreY(column.maxScore, height), x, ScoreY(column.minScore, height) + 1);
+            held = column.lastScore;
+            haveHeld = true;
+        } else if (haveHeld) {
+            dc.SetPen(wxPen(SPARKLINE_HELD));
+            dc.DrawPoint(x, ScoreY(held, height));
+        }
+    }
+}
+
+void TrendSparkline::OnPaint(wxPaintEvent& event)
+{
+    (void)event;
+    wxPaintDC dc(this);
+    if (!m_bitmapValid) {
+        RenderAll();
+    }
+    if (m_bitmapValid) {
+        dc.DrawBitmap(m_bitmap, 0, 0);
+    }
+}
+
+void TrendSparkline::OnSize(wxSizeEvent& event)
+{
+    m_bitmapValid = false;
+    Refresh();
+    event.Skip();
+}
+
+// ============================================================================
+// EventLogList Implementation
+// ============================================================================
+
+EventLogList::EventLogList(wxWindow* parent, wxWindowID id, const wxSize& size)
+    : wxListCtrl(parent, id, wxDefaultPosition, size,
+                 wxLC_REPORT | wxLC_VIRTUAL | wxLC_NO_HEADER | wxLC_SINGLE_SEL | wxBORDER_NONE)
+    , m_events(MAX_EVENTS)
+{
+    InsertColumn(0, "");
+    SetItemCount(0);
+    
+    Bind(wxEVT_SIZE, &EventLogList::OnSize, this);
+}
+
+void EventLogList::AddEvent(const std::string& text)
+{
+    m_events.push(text);
+    SetItemCount(static_cast<long>(m_events.size()));
+    
+    // Newest is row 0, so every visible row moved down by one
+    long top = GetTopItem();
+    long last = std::min(top + GetCountPerPage(), static_cast<long>(m_events.size()) - 1);
+    if (last >= top) {
+        RefreshItems(top, last);
+    }
+}
+
+void EventLogList::Clear()
+{
+    m_events.clear();
+    SetItemCount(0);
+    Refresh();
+}
+
+wxString EventLogList::OnGetItemText(long item, long column) const
+{
+    (void)column;
+    if (item < 0 || static_cast<size_t>(item) >= m_events.size()) {
+        return wxString();
+    }
+    return wxString(m_events[m_events.size() - 1 - static_cast<size_t>(item)]);
+}
+
+void EventLogList::OnSize(wxSizeEvent& event)
+{
+    // Single column spanning the control
+    SetColumnWidth(0, GetClientSize().GetWidth());
+    event.Skip();
+}
+
 // ============================================================================
 // AnxietyPanel Implementation
 // ============================================================================
 
 AnxietyPanel::AnxietyPanel(wxWindow* parent, wxWindowID id)
     : wxPanel(parent, id, wxDefaultPosition, wxSize(300, 400))
+    , m_gaugeValue(0)
+    , m_overheadLines(1)
+    , m_lastTrendScore(0.0)
+    , m_prevTrendScore(0.0)
+    , m_trendSamples(0)
+    , m_recommendationShown(false)
     , m_sessionState(SessionState::STOPPED)
+    , m_batchFrozen(false)
+    , m_layoutNeeded(false)
 {
     SetBackgroundColour(wxColour(45, 45, 48));  // Dark theme
     CreateControls();
@@ -48,15 +306,21 @@ void AnxietyPanel::CreateControls()
     m_scoreLabel->SetForegroundColour(wxColour(180, 180, 180));
     scoreSizer->Add(m_scoreLabel, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
     
-    m_scoreValue = new wxStaticText(this, wxID_ANY, "0");
+    // Value labels are sized for their widest text and never auto-resize,
+    // so updates never need a relayout
+    m_scoreValue = new wxStaticText(this, wxID_ANY, "0", wxDefaultPosition,
+        wxDefaultSize, wxST_NO_AUTORESIZE);
     wxFont scoreFont = m_scoreValue->GetFont();
     scoreFont.SetPointSize(24);
     scoreFont.SetWeight(wxFONTWEIGHT_BOLD);
     m_scoreValue->SetFont(scoreFont);
+    m_scoreValue->SetMinSize(m_scoreValue->GetTextExtent("100"));
     m_scoreValue->SetForegroundColour(wxColour(76, 175, 80));  // Green
     scoreSizer->Add(m_scoreValue, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 10);
     
-    m_riskLabel = new wxStaticText(this, wxID_ANY, "LOW");
+    m_riskLabel = new wxStaticText(this, wxID_ANY, "LOW", wxDefaultPosition,
+        wxDefaultSize, wxST_NO_AUTORESIZE);
+    m_riskLabel->SetMinSize(m_riskLabel->GetTextExtent("MODERATE"));
     m_riskLabel->SetForegroundColour(wxColour(76, 175, 80));
     scoreSizer->Add(m_riskLabel, 0, wxALIGN_CENTER_VERTICAL);
     
@@ -69,9 +333,13 @@ void AnxietyPanel::CreateControls()
     mainSizer->Add(m_scoreGauge, 0, wxEXPAND | wxLEFT | wxRIGHT, 15);
     
     // Trend display
-    m_trendLabel = new wxStaticText(this, wxID_ANY, "Trend: --");
+    m_trendLabel = new wxStaticText(this, wxID_ANY, "Trend (5 min): --");
     m_trendLabel->SetForegroundColour(wxColour(150, 150, 150));
-    mainSizer->Add(m_trendLabel, 0, wxALL, 10);
+    mainSizer->Add(m_trendLabel, 0, wxLEFT | wxRIGHT | wxTOP, 10);
+    
+    m_trendSparkline = new TrendSparkline(this);
+    m_trendSparkline->Bind(wxEVT_LEFT_DOWN, &AnxietyPanel::OnTrendClick, this);
+    mainSizer->Add(m_trendSparkline, 0, wxEXPAND | wxLEFT | wxRIGHT | wxTOP, 10);
     
     mainSizer->AddSpacer(10);
     
@@ -84,19 +352,27 @@ void AnxietyPanel::CreateControls()
     wxFlexGridSizer* metricsSizer = new wxFlexGridSizer(2, 5, 5);
     metricsSizer->AddGrowableCol(1, 1);
     
-    m_errorsLabel = new wxStaticText(this, wxID_ANY, "Errors/min:    0.0");
+    m_errorsLabel = new wxStaticText(this, wxID_ANY, "Errors/min:    0.0", wxDefaultPosition,
+        wxDefaultSize, wxST_NO_AUTORESIZE);
+    m_errorsLabel->SetMinSize(m_errorsLabel->GetTextExtent("Errors/min:    000.0"));
     m_errorsLabel->SetForegroundColour(wxColour(180, 180, 180));
     metricsSizer->Add(m_errorsLabel, 0, wxEXPAND);
     
-    m_typingLabel = new wxStaticText(this, wxID_ANY, "Typing speed:  0 WPM");
+    m_typingLabel = new wxStaticText(this, wxID_ANY, "Typing speed:  0 WPM", wxDefaultPosition,
+        wxDefaultSize, wxST_NO_AUTORESIZE);
+    m_typingLabel->SetMinSize(m_typingLabel->GetTextExtent("Typing speed:  000 WPM"));
     m_typingLabel->SetForegroundColour(wxColour(180, 180, 180));
     metricsSizer->Add(m_typingLabel, 0, wxEXPAND);
     
-    m_pauseLabel = new wxStaticText(this, wxID_ANY, "Pause ratio:   0%");
+    m_pauseLabel = new wxStaticText(this, wxID_ANY, "Pause ratio:   0%", wxDefaultPosition,
+        wxDefaultSize, wxST_NO_AUTORESIZE);
+    m_pauseLabel->SetMinSize(m_pauseLabel->GetTextExtent("Pause ratio:   100%"));
     m_pauseLabel->SetForegroundColour(wxColour(180, 180, 180));
     metricsSizer->Add(m_pauseLabel, 0, wxEXPAND);
     
-    m_backspaceLabel = new wxStaticText(this, wxID_ANY, "Backspaces:    0%");
+    m_backspaceLabel = new wxStaticText(this, wxID_ANY, "Backspaces:    0%", wxDefaultPosition,
+        wxDefaultSize, wxST_NO_AUTORESIZE);
+    m_backspaceLabel->SetMinSize(m_backspaceLabel->GetTextExtent("Backspaces:    100.0%"));
     m_backspaceLabel->SetForegroundColour(wxColour(180, 180, 180));
     metricsSizer->Add(m_backspaceLabel, 0, wxEXPAND);
     
@@ -104,13 +380,23 @@ void AnxietyPanel::CreateControls()
     
     mainSizer->AddSpacer(15);
     
+    // Plugin overhead section
+    wxStaticText* overheadTitle = new wxStaticText(this, wxID_ANY, "PLUGIN OVERHEAD (p50 / p99 / max)");
+    overheadTitle->SetForegroundColour(wxColour(120, 180, 255));
+    mainSizer->Add(overheadTitle, 0, wxLEFT | wxRIGHT, 10);
+    
+    m_overheadLabel = new wxStaticText(this, wxID_ANY, "--");
+    m_overheadLabel->SetForegroundColour(wxColour(150, 150, 150));
+    mainSizer->Add(m_overheadLabel, 0, wxEXPAND | wxLEFT | wxRIGHT, 15);
+    
+    mainSizer->AddSpacer(15);
+    
     // Recent Events section
     wxStaticText* eventsTitle = new wxStaticText(this, wxID_ANY, "RECENT EVENTS");
     eventsTitle->SetForegroundColour(wxColour(120, 180, 255));
     mainSizer->Add(eventsTitle, 0, wxLEFT | wxRIGHT, 10);
     
-    m_eventsList = new wxListBox(this, wxID_ANY, wxDefaultPosition, 
-        wxSize(-1, 120), 0, nullptr, wxLB_SINGLE | wxBORDER_NONE);
+    m_eventsList = new EventLogList(this, wxID_ANY, wxSize(-1, 120));
     m_eventsList->SetBackgroundColour(wxColour(35, 35, 38));
     m_eventsList->SetForegroundColour(wxColour(180, 180, 180));
     mainSizer->Add(m_eventsList, 1, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 10);
@@ -127,38 +413,101 @@ void AnxietyPanel::CreateControls()
 
 void AnxietyPanel::UpdateMetrics(const MetricsSnapshot& snapshot)
 {
-    RiskLevel level = RiskLevel::LOW;
-    if (snapshot.anxietyScore <= 30) level = RiskLevel::LOW;
-    else if (snapshot.anxietyScore <= 60) level = RiskLevel::MODERATE;
-    else if (snapshot.anxietyScore <= 80) level = RiskLevel::HIGH;
-    else level = RiskLevel::CRITICAL;
-    
-    UpdateScoreDisplay(snapshot.anxietyScore, level);
+    UpdateScoreDisplay(snapshot.anxietyScore, AnxietyScorer::GetRiskLevel(snapshot.anxietyScore));
     UpdateMetricsDisplay(snapshot);
+    UpdateOverheadDisplay(snapshot);
     UpdateTrend(snapshot.anxietyScore);
+    EndBatch();
+}
+
+void AnxietyPanel::UpdateLiveMetrics(const MetricsSnapshot& snapshot)
+{
+    UpdateScoreDisplay(snapshot.anxietyScore, AnxietyScorer::GetRiskLevel(snapshot.anxietyScore));
+    UpdateMetricsDisplay(snapshot);
+    EndBatch();
+}
+
+// ----------------------------------------------------------------------------
+// Batched updates: widgets are touched only when their text or colour
+// changes; the first change freezes the panel, EndBatch() thaws it once and
+// relays out only if a widget was shown, hidden or changed height.
+// ----------------------------------------------------------------------------
+
+void AnxietyPanel::BeginChange()
+{
+    if (!m_batchFrozen) {
+        Freeze();
+        m_batchFrozen = true;
+    }
+}
+
+void AnxietyPanel::EndBatch()
+{
+    if (m_layoutNeeded) {
+        Layout();
+        m_layoutNeeded = false;
+    }
+    if (m_batchFrozen) {
+        Thaw();
+        m_batchFrozen = false;
+    }
+}
+
+bool AnxietyPanel::SetLabelCached(wxStaticText* label, LabelCache& cache, const char* text)
+{
+    if (cache.text == text) {
+        return false;
+    }
+    BeginChange();
+    cache.text = text;
+    label->SetLabel(text);
+    return true;
+}
+
+void AnxietyPanel::SetColourCached(wxStaticText* label, LabelCache& cache, const wxColour& colour)
+{
+    if (cache.hasColour && cache.colour == colour) {
+        return;
+    }
+    BeginChange();
+    cache.colour = colour;
+    cache.hasColour = true;
+    label->SetForegroundColour(colour);
+    label->Refresh();
 }
 
 void AnxietyPanel::UpdateScoreDisplay(double score, RiskLevel level)
 {
-    m_scoreValue->SetLabel(wxString::Format("%.0f", score));
-    m_scoreGauge->SetValue(static_cast<int>(score));
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.0f", score);
+    SetLabelCached(m_scoreValue, m_scoreValueCache, text);
+    
+    int gaugeValue = std::max(0, std::min(100, static_cast<int>(score)));
+    if (gaugeValue != m_gaugeValue) {
+        BeginChange();
+        m_gaugeValue = gaugeValue;
+        m_scoreGauge->SetValue(gaugeValue);
+    }
     
     wxColour color = GetRiskColor(level);
-    m_scoreValue->SetForegroundColour(color);
-    m_riskLabel->SetForegroundColour(color);
-    m_riskLabel->SetLabel(GetRiskLevelLabel(level));
+    SetColourCached(m_scoreValue, m_scoreValueCache, color);
+    SetColourCached(m_riskLabel, m_riskCache, color);
+    SetLabelCached(m_riskLabel, m_riskCache, GetRiskLevelLabel(level));
     
     // Show/hide recommendations based on level
-    if (level >= RiskLevel::HIGH) {
-        AnxietyScorer scorer;
-        m_recommendationLabel->SetLabel(scorer.GetRecommendation(level));
-        m_recommendationLabel->Show();
-    } else {
-        m_recommendationLabel->Hide();
+    bool showRecommendation = level >= RiskLevel::HIGH;
+    if (showRecommendation &&
+        SetLabelCached(m_recommendationLabel, m_recommendationCache,
+                       AnxietyScorer::GetRecommendationText(level))) {
+        m_recommendationLabel->Wrap(280);
+        m_layoutNeeded = true;      // Line count may differ
+    }
+    if (showRecommendation != m_recommendationShown) {
+        BeginChange();
+        m_recommendationLabel->Show(showRecommendation);
+        m_recommendationShown = showRecommendation;
+        m_layoutNeeded = true;
     }
-    
-    Layout();
-    Refresh();
 }
 
 void AnxietyPanel::UpdateMetricsDisplay(const MetricsSnapshot& snapshot)
@@ -166,79 +515,109 @@ void AnxietyPanel::UpdateMetricsDisplay(const MetricsSnapshot& snapshot)
     wxColour normalColor(180, 180, 180);
     wxColour warningColor(255, 193, 7);
     wxColour alertColor(244, 67, 54);
+    char text[64];
     
     // Errors per minute
     wxColour errColor = normalColor;
     if (snapshot.errorFreqPerMin > 5) errColor = alertColor;
     else if (snapshot.errorFreqPerMin > 2) errColor = warningColor;
-    m_errorsLabel->SetLabel(wxString::Format("Errors/min:    %.1f", snapshot.errorFreqPerMin));
-    m_errorsLabel->SetForegroundColour(errColor);
+    std::snprintf(text, sizeof(text), "Errors/min:    %.1f", snapshot.errorFreqPerMin);
+    SetLabelCached(m_errorsLabel, m_errorsCache, text);
+    SetColourCached(m_errorsLabel, m_errorsCache, errColor);
     
     // Typing speed
-    m_typingLabel->SetLabel(wxString::Format("Typing speed:  %.0f WPM", snapshot.typingSpeedWpm));
+    std::snprintf(text, sizeof(text), "Typing speed:  %.0f WPM", snapshot.typingSpeedWpm);
+    SetLabelCached(m_typingLabel, m_typingCache, text);
     
     // Pause ratio
     wxColour pauseColor = normalColor;
     if (snapshot.pauseRatio > 0.4) pauseColor = warningColor;
-    m_pauseLabel->SetLabel(wxString::Format("Pause ratio:   %.0f%%", snapshot.pauseRatio * 100));
-    m_pauseLabel->SetForegroundColour(pauseColor);
+    std::snprintf(text, sizeof(text), "Pause ratio:   %.0f%%", snapshot.pauseRatio * 100);
+    SetLabelCached(m_pauseLabel, m_pauseCache, text);
+    SetColourCached(m_pauseLabel, m_pauseCache, pauseColor);
     
     // Backspace rate
     wxColour bsColor = normalColor;
     if (snapshot.backspaceRate > 15) bsColor = warningColor;
-    m_backspaceLabel->SetLabel(wxString::Format("Backspaces:    %.1f%%", snapshot.backspaceRate));
-    m_backspaceLabel->SetForegroundColour(bsColor);
+    std::snprintf(text, sizeof(text), "Backspaces:    %.1f%%", snapshot.backspaceRate);
+    SetLabelCached(m_backspaceLabel, m_backspaceCache, text);
+    SetColourCached(m_backspaceLabel, m_backspaceCache, bsColor);
 }
 
-void AnxietyPanel::UpdateTrend(double score)
+void AnxietyPanel::UpdateOverheadDisplay(const MetricsSnapshot& snapshot)
 {
-    m_trendData.push_back(score);
-    if (m_trendData.size() > MAX_TREND_POINTS) {
-        m_trendData.erase(m_trendData.begin());
+    // Human units: ns below 10us, us below 10ms, ms above
+    auto formatNs = [](double ns) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(0);
+        if (ns < 10000.0) oss << ns << "ns";
+        else if (ns < 10000000.0) oss << ns / 1000.0 << "us";
+        else oss << ns / 1000000.0 << "ms";
+        return oss.str();
+    };
+    
+    std::ostringstream text;
+    for (size_t i = 0; i < PROBE_SITE_COUNT; ++i) {
+        const OverheadStats& stats = snapshot.overhead[i];
+        if (stats.count == 0) continue;
+        
+        if (text.tellp() > 0) text << "\n";
+        text << std::left << std::setw(16) << GetProbeSiteLabel(static_cast<ProbeSite>(i))
+             << formatNs(stats.p50Ns) << " / " << formatNs(stats.p99Ns)
+             << " / " << formatNs(stats.maxNs);
+    }
+    
+    std::string overhead = text.tellp() > 0 ? text.str() : std::string("--");
+    size_t lines = std::count(overhead.begin(), overhead.end(), '\n') + 1;
+    if (SetLabelCached(m_overheadLabel, m_overheadCache, overhead.c_str()) &&
+        lines != m_overheadLines) {
+        m_overheadLines = lines;
+        m_layoutNeeded = true;      // Label height changed
     }
+}
+
+void AnxietyPanel::UpdateTrend(double score)
+{
+    m_prevTrendScore = m_lastTrendScore;
+    m_lastTrendScore = score;
+    ++m_trendSamples;
     
+    m_trendSparkline->AddScore(score, std::chrono::steady_clock::now());
     UpdateTrendDisplay();
+    EndBatch();
 }
 
 void AnxietyPanel::UpdateTrendDisplay()
 {
-    if (m_trendData.empty()) {
-        m_trendLabel->SetLabel("Trend: --");
-        return;
-    }
-    
-    // Build simple ASCII trend sparkline
-    std::string trend = "Trend: ";
-    for (size_t i = 0; i < m_trendData.size(); ++i) {
-        double score = m_trendData[i];
-        if (score < 20) trend += "_";
-        else if (score < 40) trend += ".";
-        else if (score < 60) trend += "-";
-        else if (score < 80) trend += "^";
-        else trend += "!";
-    }
-    
-    // Add direction indicator
-    if (m_trendData.size() >= 2) {
-        double last = m_trendData.back();
-        double prev = m_trendData[m_trendData.size() - 2];
-        if (last > prev + 5) trend += " [UP]";
-        else if (last < prev - 5) trend += " [DOWN]";
-        else trend += " [STABLE]";
+    std::string trend = m_trendSparkline->IsShowingHour() ? "Trend (1 hour): " : "Trend (5 min): ";
+    
+    // Direction indicator
+    if (m_trendSamples == 0) {
+        trend += "--";
+    } else if (m_trendSamples == 1) {
+        trend += "[STABLE]";
+    } else if (m_lastTrendScore > m_prevTrendScore + 5) {
+        trend += "[UP]";
+    } else if (m_lastTrendScore < m_prevTrendScore - 5) {
+        trend += "[DOWN]";
+    } else {
+        trend += "[STABLE]";
     }
     
-    m_trendLabel->SetLabel(trend);
+    SetLabelCached(m_trendLabel, m_trendCache, trend.c_str());
+}
+
+void AnxietyPanel::OnTrendClick(wxMouseEvent& event)
+{
+    (void)event;
+    m_trendSparkline->SetShowHour(!m_trendSparkline->IsShowingHour());
+    UpdateTrendDisplay();
+    EndBatch();
 }
 
 wxColour AnxietyPanel::GetRiskColor(RiskLevel level) const
 {
-    switch (level) {
-        case RiskLevel::LOW:      return wxColour(76, 175, 80);   // Green
-        case RiskLevel::MODERATE: return wxColour(255, 193, 7);   // Yellow/Amber
-        case RiskLevel::HIGH:     return wxColour(255, 152, 0);   // Orange
-        case RiskLevel::CRITICAL: return wxColour(244, 67, 54);   // Red
-        default:                  return wxColour(180, 180, 180);
-    }
+    return RiskColour(level);
 }
 
 void AnxietyPanel::AddEvent(const std::string& event)
@@ -246,12 +625,7 @@ void AnxietyPanel::AddEvent(const std::string& event)
     std::string timeStr = GetTimeString();
     std::string fullEvent = timeStr + " " + event;
     
-    m_eventsList->Insert(fullEvent, 0);
-    
-    // Keep list manageable
-    while (m_eventsList->GetCount() > MAX_EVENTS) {
-        m_eventsList->Delete(m_eventsList->GetCount() - 1);
-    }
+    m_eventsList->AddEvent(fullEvent);
 }
 
 void AnxietyPanel::ClearEvents()
@@ -264,16 +638,20 @@ void AnxietyPanel::SetSessionState(SessionState state)
     m_sessionState = state;
     
     if (state == SessionState::STOPPED) {
-        m_scoreValue->SetLabel("--");
-        m_riskLabel->SetLabel("STOPPED");
-        m_riskLabel->SetForegroundColour(wxColour(128, 128, 128));
-        m_scoreGauge->SetValue(0);
+        SetLabelCached(m_scoreValue, m_scoreValueCache, "--");
+        SetLabelCached(m_riskLabel, m_riskCache, "STOPPED");
+        SetColourCached(m_riskLabel, m_riskCache, wxColour(128, 128, 128));
+        if (m_gaugeValue != 0) {
+            BeginChange();
+            m_gaugeValue = 0;
+            m_scoreGauge->SetValue(0);
+        }
     } else if (state == SessionState::PAUSED) {
-        m_riskLabel->SetLabel("PAUSED");
-        m_riskLabel->SetForegroundColour(wxColour(100, 149, 237));  // Cornflower blue
+        SetLabelCached(m_riskLabel, m_riskCache, "PAUSED");
+        SetColourCached(m_riskLabel, m_riskCache, wxColour(100, 149, 237));  // Cornflower blue
     }
     
-    Refresh();
+    EndBatch();
 }
 
 std::string AnxietyPanel::GetTimeString() const
@@ -5,7 +5,7 @@
 #include "wx_stubs.h"
 #else
 #include <wx/gauge.h>
-#include <wx/listbox.h>
+#include <wx/listctrl.h>
 #include <wx/panel.h>
 #include <wx/sizer.h>
 #include <wx/statline.h>
@@ -16,6 +16,8 @@
 #endif
 
 #include "MetricsData.h"
+#include "TrendRing.h"
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -25,6 +27,77 @@ namespace AnxietyMonitor {
 // Forward declarations
 class DataCollector;
 
+/**
+ * @class TrendSparkline
+ * @brief Score sparkline over the last 5 minutes or the last hour.
+ *
+ * Both views are kept in fixed rings (1 s and 12 s columns) and rendered
+ * into a cached bitmap, one pixel per column. An update scrolls the bitmap
+ * by the number of columns that closed and draws only the new columns,
+ * then repaints just this control, so the cost per update is constant and
+ * the panel is never relaid out. A full render happens only on resize or
+ * when the view changes.
+ */
+class TrendSparkline : public wxWindow {
+public:
+  TrendSparkline(wxWindow *parent, wxWindowID id = wxID_ANY);
+
+  void AddScore(double score, std::chrono::steady_clock::time_point when);
+  void Clear();
+
+  // false = last 5 minutes, true = last hour
+  void SetShowHour(bool showHour);
+  bool IsShowingHour() const { return m_showHour; }
+
+private:
+  const TrendRing &ActiveRing() const;
+  void RenderAll();
+  void DrawColumns(wxDC &dc, size_t first);
+  int ColumnX(size_t index) const;
+  void OnPaint(wxPaintEvent &event);
+  void OnSize(wxSizeEvent &event);
+
+private:
+  static const size_t COLUMNS = 300;
+
+  TrendRing m_minuteRing; // 5 minutes at 1 s per column
+  TrendRing m_hourRing;   // 1 hour at 12 s per column
+  bool m_showHour;
+
+  wxBitmap m_bitmap;
+  bool m_bitmapValid;
+};
+
+/**
+ * @class EventLogList
+ * @brief Recent events log (newest first) over a fixed ring of entries.
+ *
+ * A virtual list control: rows are not stored in the widget, which asks
+ * OnGetItemText for the rows it actually draws. Adding an event is a ring
+ * push plus an item count update, and only the visible rows are repainted,
+ * so the cost does not depend on the history length.
+ */
+class EventLogList : public wxListCtrl {
+public:
+  static const size_t MAX_EVENTS = 5000;
+
+  EventLogList(wxWindow *parent, wxWindowID id = wxID_ANY,
+               const wxSize &size = wxDefaultSize);
+
+  void AddEvent(const std::string &text);
+  void Clear();
+  size_t GetEventCount() const { return m_events.size(); }
+
+protected:
+  wxString OnGetItemText(long item, long column) const override;
+
+private:
+  void OnSize(wxSizeEvent &event);
+
+private:
+  RollingBuffer<std::string> m_events; // Oldest first
+};
+
 /**
  * @class AnxietyPanel
  * @brief Dockable panel showing real-time anxiety metrics and trends.
@@ -33,6 +106,7 @@ class DataCollector;
  * - Live anxiety score with color indicator
  * - 5-minute trend sparkline
  * - Current metrics display
+ * - Plugin self-overhead (p50/p99/max per instrumented callsite)
  * - Recent events log
  * - Recommendations (non-intrusive, only for HIGH/CRITICAL)
  */
@@ -46,6 +120,13 @@ public:
    */
   void UpdateMetrics(const MetricsSnapshot &snapshot);
 
+  /**
+   * @brief Refresh score and metric labels between samples (no overhead,
+   * no trend point: the trend is fed once per sample by UpdateMetrics).
+   * Needs the SNAPSHOT_PANEL fields.
+   */
+  void UpdateLiveMetrics(const MetricsSnapshot &snapshot);
+
   /**
    * @brief Add an event to the recent events log.
    */
@@ -62,15 +143,29 @@ public:
   void SetSessionState(SessionState state);
 
   /**
-   * @brief Update the trend data (5-minute rolling).
+   * @brief Add a score to the trend sparkline (5-minute / 1-hour).
    */
   void UpdateTrend(double score);
 
 private:
+  // Last text / colour set on a label (widgets are touched only on change)
+  struct LabelCache {
+    std::string text;
+    wxColour colour;
+    bool hasColour = false;
+  };
+
   void CreateControls();
+  void BeginChange();
+  void EndBatch();
+  bool SetLabelCached(wxStaticText *label, LabelCache &cache, const char *text);
+  void SetColourCached(wxStaticText *label, LabelCache &cache,
+                       const wxColour &colour);
   void UpdateScoreDisplay(double score, RiskLevel level);
   void UpdateMetricsDisplay(const MetricsSnapshot &snapshot);
   void UpdateTrendDisplay();
+  void OnTrendClick(wxMouseEvent &event);
+  void UpdateOverheadDisplay(const MetricsSnapshot &snapshot);
   wxColour GetRiskColor(RiskLevel level) const;
   std::string GetTimeString() const;
 
@@ -81,26 +176,47 @@ private:
   wxStaticText *m_riskLabel;
   wxGauge *m_scoreGauge;
 
+  LabelCache m_scoreValueCache;
+  LabelCache m_riskCache;
+  int m_gaugeValue;
+
   // Metrics display
   wxStaticText *m_errorsLabel;
   wxStaticText *m_typingLabel;
   wxStaticText *m_pauseLabel;
   wxStaticText *m_backspaceLabel;
+  LabelCache m_errorsCache;
+  LabelCache m_typingCache;
+  LabelCache m_pauseCache;
+  LabelCache m_backspaceCache;
 
-  // Trend display (simplified as numbers)
+  // Plugin self-overhead (p50/p99/max per probe site)
+  wxStaticText *m_overheadLabel;
+  LabelCache m_overheadCache;
+  size_t m_overheadLines;
+
+  // Trend display (caption with direction + sparkline; click toggles view)
   wxStaticText *m_trendLabel;
-  std::vector<double> m_trendData;
-  static const size_t MAX_TREND_POINTS = 10;
+  TrendSparkline *m_trendSparkline;
+  LabelCache m_trendCache;
+  double m_lastTrendScore;
+  double m_prevTrendScore;
+  size_t m_trendSamples;
 
   // Events log
-  wxListBox *m_eventsList;
-  static const int MAX_EVENTS = 15;
+  EventLogList *m_eventsList;
 
   // Recommendations
   wxStaticText *m_recommendationLabel;
+  LabelCache m_recommendationCache;
+  bool m_recommendationShown;
 
   // Session state
   SessionState m_sessionState;
+
+  // Update batch state (see EndBatch)
+  bool m_batchFrozen;
+  bool m_layoutNeeded;
 };
 
 /**
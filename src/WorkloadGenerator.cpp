@@ -0,0 +1,292 @@
+#include "WorkloadGenerator.h"
+#include "AnxietyScorer.h"
+#include "DataCollector.h"
+#include "DigraphMatrix.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace AnxietyMonitor {
+
+namespace {
+
+// Files a participant switches between (tab changes)
+const char* const FILES[] = {
+    "src/main.cpp", "src/parser.cpp", "src/parser.h", "src/lexer.cpp",
+    "src/utils.cpp", "src/utils.h", "tests/test_parser.cpp", "src/config.h",
+};
+const size_t FILE_COUNT = sizeof(FILES) / sizeof(FILES[0]);
+
+// Typed keys cycle through this text so replays carry realistic key classes
+// (digraph timing) without extra random draws
+const char TYPED_TEXT[] =
+    "for (size_t i = 0; i < tokens.size(); ++i) {\n"
+    "    if (tokens[i].Kind == TokenKind::Identifier && !seen.count(tokens[i].text)) {\n"
+    "        result.push_back(Parse(tokens, i, \"expr\"));\n"
+    "    }\n"
+    "}\n";
+const size_t TYPED_TEXT_LENGTH = sizeof(TYPED_TEXT) - 1;
+
+// Stay below the collector's pause threshold inside a burst
+const double MIN_KEY_INTERVAL_MS = 20.0;
+const double MAX_KEY_INTERVAL_MS = 1900.0;
+
+const long long IDLE_TICK_MS = 1000;
+const long long BREAK_MIN_MS = 30000;
+
+uint64_t MixSeed(uint64_t seed, uint32_t participant)
+{
+    WorkloadRandom mixer(seed ^ (0xD1B54A32D192ED03ULL * (static_cast<uint64_t>(participant) + 1)));
+    return mixer.NextU64();
+}
+
+double Lerp(double a, double b, double t)
+{
+    return a + (b - a) * t;
+}
+
+} // namespace
+
+// ============================================================================
+// WorkloadRandom / WorkloadProfile
+// ============================================================================
+
+double WorkloadRandom::LogNormal(double mean, double cv)
+{
+    // Box-Muller standard normal
+    double u1 = 1.0 - NextDouble();
+    double u2 = NextDouble();
+    double normal = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+
+    double sigma2 = std::log(1.0 + cv * cv);
+    double mu = std::log(mean) - sigma2 / 2.0;
+    return std::exp(mu + std::sqrt(sigma2) * normal);
+}
+
+WorkloadProfile WorkloadProfile::Calm()
+{
+    return {180.0, 0.35, 0.05, 40.0, 3000.0, 0.02, 0.03, 0.03, 0.05, 0.08, 0.20, 1.5};
+}
+
+WorkloadProfile WorkloadProfile::Moderate()
+{
+    return {210.0, 0.60, 0.10, 30.0, 4500.0, 0.05, 0.05, 0.08, 0.12, 0.12, 0.40, 3.0};
+}
+
+WorkloadProfile WorkloadProfile::Stressed()
+{
+    return {260.0, 1.00, 0.20, 18.0, 7000.0, 0.10, 0.08, 0.15, 0.25, 0.20, 0.65, 6.0};
+}
+
+WorkloadProfile WorkloadProfile::Blend(const WorkloadProfile& from, const WorkloadProfile& to, double t)
+{
+    t = std::max(0.0, std::min(1.0, t));
+    WorkloadProfile p;
+    p.keyIntervalMs = Lerp(from.keyIntervalMs, to.keyIntervalMs, t);
+    p.keyIntervalCv = Lerp(from.keyIntervalCv, to.keyIntervalCv, t);
+    p.backspaceProb = Lerp(from.backspaceProb, to.backspaceProb, t);
+    p.burstKeys = Lerp(from.burstKeys, to.burstKeys, t);
+    p.thinkPauseMs = Lerp(from.thinkPauseMs, to.thinkPauseMs, t);
+    p.breakProb = Lerp(from.breakProb, to.breakProb, t);
+    p.pasteProb = Lerp(from.pasteProb, to.pasteProb, t);
+    p.undoProb = Lerp(from.undoProb, to.undoProb, t);
+    p.tabSwitchProb = Lerp(from.tabSwitchProb, to.tabSwitchProb, t);
+    p.compileProb = Lerp(from.compileProb, to.compileProb, t);
+    p.compileFailProb = Lerp(from.compileFailProb, to.compileFailProb, t);
+    p.errorsPerFailure = Lerp(from.errorsPerFailure, to.errorsPerFailure, t);
+    return p;
+}
+
+// ============================================================================
+// WorkloadGenerator
+// ============================================================================
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadConfig& config)
+    : m_config(config)
+    , m_random(MixSeed(config.seed, config.participant))
+    , m_nowMs(0)
+    , m_endMs(static_cast<long long>(config.durationMinutes * 60000.0))
+    , m_pendingIndex(0)
+    , m_eventCount(0)
+    , m_started(false)
+    , m_textPos(0)
+{
+    m_pending.reserve(256);
+}
+
+bool WorkloadGenerator::Next(CollectorEvent& event)
+{
+    while (m_pendingIndex >= m_pending.size()) {
+        if (m_nowMs >= m_endMs) {
+            return false;
+        }
+        m_pending.clear();
+        m_pendingIndex = 0;
+        PlanBurst();
+    }
+
+    event = std::move(m_pending[m_pendingIndex++]);
+    ++m_eventCount;
+    return true;
+}
+
+void WorkloadGenerator::Emit(CollectorEventType type, long long atMs, int count, int count2,
+                             bool flag, const std::string& text)
+{
+    if (atMs > m_endMs) return;
+
+    CollectorEvent event;
+    event.type = type;
+    event.when = Origin() + std::chrono::milliseconds(atMs);
+    event.count = count;
+    event.count2 = count2;
+    event.flag = flag;
+    event.text = text;
+    m_pending.push_back(std::move(event));
+}
+
+void WorkloadGenerator::PlanBurst()
+{
+    if (!m_started) {
+        m_started = true;
+        char project[32];
+        std::snprintf(project, sizeof(project), "Project%u", m_config.participant % 50);
+        Emit(CollectorEventType::ACTIVE_PROJECT, 0, 0, 0, false, project);
+        Emit(CollectorEventType::ACTIVE_FILE, 0, 0, 0, false, FILES[0]);
+    }
+
+    double progress = m_endMs > 0 ? static_cast<double>(m_nowMs) / m_endMs : 0.0;
+    WorkloadProfile p = WorkloadProfile::Blend(m_config.startProfile, m_config.endProfile, progress);
+
+    // Think pause or break before the burst, with the idle ticks the IDE
+    // would deliver while nothing happens
+    long long pauseMs = static_cast<long long>(m_random.Exponential(p.thinkPauseMs));
+    if (m_random.Chance(p.breakProb)) {
+        pauseMs = BREAK_MIN_MS + static_cast<long long>(m_random.Exponential(90000.0));
+    }
+    for (long long tick = IDLE_TICK_MS; tick < pauseMs; tick += IDLE_TICK_MS) {
+        Emit(CollectorEventType::IDLE_TICK, m_nowMs + tick);
+    }
+    m_nowMs += pauseMs;
+
+    if (m_random.Chance(p.tabSwitchProb)) {
+        Emit(CollectorEventType::TAB_CHANGE, m_nowMs);
+        Emit(CollectorEventType::ACTIVE_FILE, m_nowMs, 0, 0, false,
+             FILES[m_random.NextU64() % FILE_COUNT]);
+    }
+
+    if (m_random.Chance(p.pasteProb)) {
+        int chars = 20 + static_cast<int>(m_random.Exponential(200.0));
+        Emit(CollectorEventType::BULK_INSERT, m_nowMs, chars);
+    } else {
+        long long keys = 1 + static_cast<long long>(m_random.Exponential(p.burstKeys));
+        for (long long i = 0; i < keys; ++i) {
+            double gap = m_random.LogNormal(p.keyIntervalMs, p.keyIntervalCv);
+            m_nowMs += static_cast<long long>(std::max(MIN_KEY_INTERVAL_MS, std::min(MAX_KEY_INTERVAL_MS, gap)));
+            bool backspace = m_random.Chance(p.backspaceProb);
+            KeyClass key = backspace ? KeyClass::BACKSPACE
+                                     : DigraphMatrix::Classify(TYPED_TEXT[m_textPos++ % TYPED_TEXT_LENGTH]);
+            Emit(CollectorEventType::KEYSTROKE, m_nowMs, static_cast<int>(key), 0, backspace);
+        }
+    }
+
+    if (m_random.Chance(p.undoProb)) {
+        m_nowMs += 300;
+        Emit(CollectorEventType::UNDO, m_nowMs);
+        if (m_random.Chance(0.3)) {
+            m_nowMs += 400;
+            Emit(CollectorEventType::REDO, m_nowMs);
+        }
+    }
+
+    if (m_random.Chance(p.compileProb)) {
+        m_nowMs += 500;
+        Emit(CollectorEventType::COMPILE_START, m_nowMs);
+        m_nowMs += 1500 + static_cast<long long>(m_random.Exponential(3000.0));
+
+        bool failed = m_random.Chance(p.compileFailProb);
+        int errors = failed ? 1 + static_cast<int>(m_random.Exponential(std::max(0.0, p.errorsPerFailure - 1.0))) : 0;
+        int warnings = static_cast<int>(m_random.Exponential(1.0));
+        Emit(CollectorEventType::COMPILE_END, m_nowMs, errors, warnings, !failed);
+    }
+}
+
+size_t WorkloadGenerator::Replay(DataCollector& collector, int sampleIntervalMs,
+                                 const std::function<void(const MetricsSnapshot&)>& onSample)
+{
+    CollectorEventQueue queue(1024);
+    AnxietyScorer scorer;
+    char sessionId[64];
+    std::snprintf(sessionId, sizeof(sessionId), "synthetic_s%llu_p%u",
+                  static_cast<unsigned long long>(m_config.seed), m_config.participant);
+
+    long long intervalMs = std::max(1, sampleIntervalMs);
+    long long nextSampleMs = intervalMs;
+    size_t samples = 0;
+
+    auto takeSample = [&](long long atMs) {
+        collector.ProcessEvents(queue);
+        MetricsSnapshot snapshot = collector.GetSnapshotAt(Origin() + std::chrono::milliseconds(atMs));
+
+        snapshot.timestamp = FormatTimestamp(m_config.wallClockStart + atMs / 1000,
+                                             static_cast<int>(atMs % 1000), intervalMs < 1000);
+        snapshot.timestampBatch = snapshot.timestamp;
+        snapshot.sessionId = sessionId;
+        snapshot.anxietyScore = scorer.CalculateScore(snapshot);
+        snapshot.riskLevel = GetRiskLevelLabel(scorer.GetRiskLevel(snapshot.anxietyScore));
+
+        onSample(snapshot);
+        ++samples;
+    };
+
+    collector.StartSession(Origin());
+
+    CollectorEvent event;
+    while (Next(event)) {
+        long long atMs = ElapsedMs(event);
+        while (nextSampleMs <= atMs) {
+            takeSample(nextSampleMs);
+            nextSampleMs += intervalMs;
+        }
+        if (!queue.TryPush(std::move(event))) {
+            collector.ProcessEvents(queue);
+            queue.TryPush(std::move(event));
+        }
+    }
+    while (nextSampleMs <= m_endMs) {
+        takeSample(nextSampleMs);
+        nextSampleMs += intervalMs;
+    }
+
+    collector.EndSession(Origin() + std::chrono::milliseconds(m_endMs));
+    return samples;
+}
+
+std::string WorkloadGenerator::FormatTimestamp(int64_t unixSeconds, int millis, bool withMillis)
+{
+    // Civil date from days since 1970-01-01 (proleptic Gregorian)
+    int64_t days = unixSeconds / 86400;
+    int64_t secs = unixSeconds % 86400;
+    if (secs < 0) { secs += 86400; --days; }
+
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t day = doy - (153 * mp + 2) / 5 + 1;
+    int64_t month = mp < 10 ? mp + 3 : mp - 9;
+    int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+    char buffer[40];
+    int len = std::snprintf(buffer, sizeof(buffer), "%04lld-%02lld-%02lldT%02lld:%02lld:%02lld",
+                            static_cast<long long>(year), static_cast<long long>(month),
+                            static_cast<long long>(day), static_cast<long long>(secs / 3600),
+                            static_cast<long long>(secs / 60 % 60), static_cast<long long>(secs % 60));
+    if (withMillis && len > 0) {
+        std::snprintf(buffer + len, sizeof(buffer) - len, ".%03d", millis);
+    }
+    return buffer;
+}
+
+} // namespace AnxietyMonitor
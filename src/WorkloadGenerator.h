@@ -0,0 +1,155 @@
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "EventQueue.h"
+#include "MetricsData.h"
+
+namespace AnxietyMonitor {
+
+class DataCollector;
+
+/**
+ * @class WorkloadRandom
+ * @brief Small deterministic PRNG (SplitMix64).
+ *
+ * The std:: distributions are implementation-defined, so the same seed can
+ * give different streams on different standard libraries. Everything here
+ * is derived from raw 64-bit draws instead.
+ */
+class WorkloadRandom {
+public:
+    explicit WorkloadRandom(uint64_t seed) : m_state(seed) {}
+
+    uint64_t NextU64() {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, 1)
+    double NextDouble() { return static_cast<double>(NextU64() >> 11) * (1.0 / 9007199254740992.0); }
+
+    bool Chance(double probability) { return NextDouble() < probability; }
+
+    double Exponential(double mean) { return -mean * std::log(1.0 - NextDouble()); }
+
+    // Positive, right-skewed (keystroke intervals); cv = stddev / mean
+    double LogNormal(double mean, double cv);
+
+private:
+    uint64_t m_state;
+};
+
+/**
+ * @brief Behaviour parameters for one anxiety level.
+ * Per-burst probabilities apply once per typing burst.
+ */
+struct WorkloadProfile {
+    double keyIntervalMs;       // Mean gap between keys inside a burst
+    double keyIntervalCv;       // Rhythm irregularity (stddev / mean)
+    double backspaceProb;       // Per keystroke
+    double burstKeys;           // Mean keys per typing burst
+    double thinkPauseMs;        // Mean pause between bursts
+    double breakProb;           // Chance a pause is a >30 s break
+    double pasteProb;           // Per burst: paste a block instead of typing
+    double undoProb;            // Per burst
+    double tabSwitchProb;       // Per burst
+    double compileProb;         // Per burst: build after the burst
+    double compileFailProb;     // Chance a build fails
+    double errorsPerFailure;    // Mean errors of a failed build
+
+    static WorkloadProfile Calm();
+    static WorkloadProfile Moderate();
+    static WorkloadProfile Stressed();
+
+    // Linear interpolation, t in [0, 1]
+    static WorkloadProfile Blend(const WorkloadProfile& from, const WorkloadProfile& to, double t);
+};
+
+struct WorkloadConfig {
+    uint64_t seed = 1;
+    uint32_t participant = 0;               // Streams are independent per participant
+    double durationMinutes = 60.0;
+    WorkloadProfile startProfile = WorkloadProfile::Calm();
+    WorkloadProfile endProfile = WorkloadProfile::Calm();   // Blended over the session
+    int64_t wallClockStart = 1767603600;    // Unix seconds of t = 0 (2026-01-05T09:00:00Z)
+};
+
+/**
+ * @class WorkloadGenerator
+ * @brief Deterministic synthetic editor event stream for one participant.
+ *
+ * Produces the same CollectorEvents the SDK callbacks enqueue: typing
+ * bursts with backspaces, think pauses and breaks (with idle ticks), pastes,
+ * undo/redo, tab switches and compile/error cycles, in time order. The
+ * stream depends only on (seed, participant, config), so any participant can
+ * be regenerated alone, e.g. by a different shard of a large run.
+ */
+class WorkloadGenerator {
+public:
+    explicit WorkloadGenerator(const WorkloadConfig& config);
+
+    /**
+     * @brief Next event in time order.
+     * @return false once the configured duration is reached
+     */
+    bool Next(CollectorEvent& event);
+
+    /**
+     * @brief Replay the whole stream through a collector at simulated time,
+     * sampling every sampleIntervalMs like the plugin's timer.
+     *
+     * Each sample is scored by AnxietyScorer and gets synthetic wall-clock
+     * timestamps and a "synthetic_s<seed>_p<participant>" session id.
+     * @return Number of samples produced
+     */
+    size_t Replay(DataCollector& collector, int sampleIntervalMs,
+                  const std::function<void(const MetricsSnapshot&)>& onSample);
+
+    // Time zero of every generated timeline
+    static std::chrono::steady_clock::time_point Origin() {
+        return std::chrono::steady_clock::time_point();
+    }
+
+    // Milliseconds since Origin() of an event
+    static long long ElapsedMs(const CollectorEvent& event) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(event.when - Origin()).count();
+    }
+
+    uint64_t GetEventCount() const { return m_eventCount; }
+
+    const WorkloadConfig& GetConfig() const { return m_config; }
+
+    /**
+     * @brief Format Unix seconds (+ milliseconds) as ISO 8601 UTC.
+     * Locale- and timezone-independent, so output is reproducible.
+     */
+    static std::string FormatTimestamp(int64_t unixSeconds, int millis, bool withMillis);
+
+private:
+    void PlanBurst();
+    void Emit(CollectorEventType type, long long atMs, int count = 0, int count2 = 0,
+              bool flag = false, const std::string& text = std::string());
+
+private:
+    WorkloadConfig m_config;
+    WorkloadRandom m_random;
+    long long m_nowMs;
+    long long m_endMs;
+    std::vector<CollectorEvent> m_pending;     // Events of the current burst
+    size_t m_pendingIndex;
+    uint64_t m_eventCount;
+    bool m_started;
+    size_t m_textPos;                          // Next character of the typed text
+};
+
+} // namespace AnxietyMonitor
+
+#endif // WORKLOAD_GENERATOR_H
@@ -64,6 +64,14 @@ struct wxPoint {
 struct wxSize {
     int width, height;
     wxSize(int w = -1, int h = -1) : width(w), height(h) {}
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+};
+
+// wxRect stub
+struct wxRect {
+    int x, y, width, height;
+    wxRect(int _x = 0, int _y = 0, int w = 0, int h = 0) : x(_x), y(_y), width(w), height(h) {}
 };
 
 // wxColour stub
@@ -71,6 +79,8 @@ class wxColour {
 public:
     wxColour(unsigned char r = 0, unsigned char g = 0, unsigned char b = 0) 
         : m_r(r), m_g(g), m_b(b) {}
+    bool operator==(const wxColour& o) const { return m_r == o.m_r && m_g == o.m_g && m_b == o.m_b; }
+    bool operator!=(const wxColour& o) const { return !(*this == o); }
 private:
     unsigned char m_r, m_g, m_b;
 };
@@ -115,12 +125,22 @@ public:
     bool ShiftDown() const { return false; }
 };
 
+// Paint / size / mouse event stubs
+class wxPaintEvent : public wxEvent {};
+class wxSizeEvent : public wxEvent {};
+class wxMouseEvent : public wxEvent {};
+
+#define wxEVT_PAINT 0
+#define wxEVT_SIZE 0
+#define wxEVT_LEFT_DOWN 0
+#define wxBG_STYLE_PAINT 0
+
 // wxEvtHandler stub
 class wxEvtHandler {
 public:
     virtual ~wxEvtHandler() {}
-    template<typename T>
-    void Bind(wxEventType, T, wxEvtHandler*, int) {}
+    template<typename T, typename H>
+    void Bind(wxEventType, T, H*, int = wxID_ANY) {}
 };
 
 // wxWindow stub
@@ -128,13 +148,23 @@ class wxWindow : public wxEvtHandler {
 public:
     wxWindow(wxWindow* parent = nullptr, wxWindowID id = wxID_ANY) 
         : m_parent(parent), m_id(id) {}
+    wxWindow(wxWindow* parent, wxWindowID id, const wxPoint&, const wxSize&, long = 0)
+        : m_parent(parent), m_id(id) {}
     virtual ~wxWindow() {}
     
     void SetBackgroundColour(const wxColour&) {}
     void SetForegroundColour(const wxColour&) {}
+    void SetBackgroundStyle(int) {}
+    void SetMinSize(const wxSize&) {}
+    void SetToolTip(const wxString&) {}
+    wxSize GetClientSize() const { return wxSize(0, 0); }
     void Show(bool show = true) { (void)show; }
     void Hide() {}
     void Refresh() {}
+    void RefreshRect(const wxRect&) {}
+    void Freeze() {}
+    void Thaw() {}
+    wxSize GetTextExtent(const wxString&) const { return wxSize(0, 0); }
     void Layout() {}
     void SetSizer(wxSizer*) {}
     
@@ -197,8 +227,9 @@ public:
 template<typename T1, typename T2>
 inline int wxMessageBox(const T1&, const T2&, long = 0, wxWindow* = nullptr) { return 0; }
 
-// wxLogMessage/wxLogError stubs
+// wxLogMessage/wxLogWarning/wxLogError stubs
 inline void wxLogMessage(const char*, ...) {}
+inline void wxLogWarning(const char*, ...) {}
 inline void wxLogError(const char*, ...) {}
 
 // wxCopyFile stub
@@ -265,11 +296,13 @@ public:
 };
 
 #define wxFONTWEIGHT_BOLD 0
+#define wxST_NO_AUTORESIZE 0
 
 // Static controls
 class wxStaticText : public wxWindow {
 public:
-    wxStaticText(wxWindow*, wxWindowID, const char*) {}
+    wxStaticText(wxWindow*, wxWindowID, const char*, const wxPoint& = wxDefaultPosition,
+                 const wxSize& = wxDefaultSize, long = 0) {}
     void SetLabel(const wxString&) {}
     wxFont GetFont() const { return wxFont(); }
     void SetFont(const wxFont&) {}
@@ -292,6 +325,26 @@ public:
     size_t GetCount() const { return 0; }
 };
 
+#define wxLC_REPORT 0
+#define wxLC_VIRTUAL 0
+#define wxLC_NO_HEADER 0
+#define wxLC_SINGLE_SEL 0
+
+class wxListCtrl : public wxWindow {
+public:
+    wxListCtrl(wxWindow* parent, wxWindowID id, const wxPoint& = wxDefaultPosition,
+               const wxSize& = wxDefaultSize, long = 0)
+        : wxWindow(parent, id) {}
+    long InsertColumn(long, const wxString&) { return 0; }
+    bool SetColumnWidth(int, int) { return true; }
+    void SetItemCount(long) {}
+    long GetTopItem() const { return 0; }
+    int GetCountPerPage() const { return 0; }
+    void RefreshItems(long, long) {}
+protected:
+    virtual wxString OnGetItemText(long, long) const { return wxString(); }
+};
+
 class wxGauge : public wxWindow {
 public:
     wxGauge(wxWindow*, wxWindowID, int, const wxPoint& = wxDefaultPosition,
@@ -304,6 +357,51 @@ public:
 #define wxLB_SINGLE 0
 #define wxBORDER_NONE 0
 
+// Drawing
+class wxPen {
+public:
+    wxPen(const wxColour& = wxColour(), int = 1) {}
+};
+
+class wxBrush {
+public:
+    wxBrush(const wxColour& = wxColour()) {}
+};
+
+class wxBitmap {
+public:
+    wxBitmap() {}
+    wxBitmap(int w, int h) : m_width(w), m_height(h) {}
+    bool IsOk() const { return m_width > 0 && m_height > 0; }
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+private:
+    int m_width = 0;
+    int m_height = 0;
+};
+
+class wxDC {
+public:
+    virtual ~wxDC() {}
+    void SetPen(const wxPen&) {}
+    void SetBrush(const wxBrush&) {}
+    void DrawLine(int, int, int, int) {}
+    void DrawPoint(int, int) {}
+    void DrawRectangle(int, int, int, int) {}
+    void DrawBitmap(const wxBitmap&, int, int) {}
+    bool Blit(int, int, int, int, wxDC*, int, int) { return true; }
+};
+
+class wxMemoryDC : public wxDC {
+public:
+    explicit wxMemoryDC(wxBitmap&) {}
+};
+
+class wxPaintDC : public wxDC {
+public:
+    explicit wxPaintDC(wxWindow*) {}
+};
+
 // DateTime
 class wxDateTime {
 public:
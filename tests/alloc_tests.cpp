@@ -0,0 +1,230 @@
+/**
+ * @file alloc_tests.cpp
+ * @brief Zero-allocation checks for the keystroke path.
+ *
+ * Replaces the global operator new with a counting version and replays
+ * scripted editor event sequences against a running DataCollector. After
+ * warm-up, steady-state processing must not touch the heap.
+ *
+ * Build: the alloc_tests target links the anxiety_core library
+ * (cmake -S . -B build && cmake --build build && ctest --test-dir build).
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "../src/MetricsData.h"
+#include "../src/BurstFilter.h"
+#include "../src/DataCollector.h"
+#include "../src/EventQueue.h"
+
+using namespace AnxietyMonitor;
+
+// ============================================================================
+// Allocation Counting
+// ============================================================================
+
+static std::atomic<unsigned long long> g_allocCount(0);
+
+void* operator new(std::size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Counts heap allocations made while in scope
+class AllocationScope {
+public:
+    AllocationScope() : m_start(g_allocCount.load(std::memory_order_relaxed)) {}
+    unsigned long long count() const {
+        return g_allocCount.load(std::memory_order_relaxed) - m_start;
+    }
+private:
+    unsigned long long m_start;
+};
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+int testsRun = 0;
+int testsPassed = 0;
+
+#define TEST(name) void name()
+#define RUN_TEST(name) do { \
+    std::cout << "Running " << #name << "... "; \
+    testsRun++; \
+    try { \
+        name(); \
+        testsPassed++; \
+        std::cout << "PASSED" << std::endl; \
+    } catch (const std::exception& e) { \
+        std::cout << "FAILED: " << e.what() << std::endl; \
+    } \
+} while(0)
+
+#define ASSERT_NO_ALLOCATIONS(scope) do { \
+    if ((scope).count() != 0) { \
+        throw std::runtime_error("heap allocations on hot path: " + \
+                                 std::to_string((scope).count())); \
+    } \
+} while(0)
+
+#define ASSERT_TRUE(condition) do { \
+    if (!(condition)) { \
+        throw std::runtime_error("Assertion failed: condition is false"); \
+    } \
+} while(0)
+
+static std::chrono::steady_clock::time_point AtMs(
+    std::chrono::steady_clock::time_point base, long long ms)
+{
+    return base + std::chrono::milliseconds(ms);
+}
+
+// Session with context set and the rolling windows already full
+static void WarmUp(DataCollector& collector, std::chrono::steady_clock::time_point base)
+{
+    collector.StartSession();
+    collector.SetActiveProject("AllocProject");
+    collector.SetActiveFile("src/some_fairly_long_file_name_main.cpp");
+    for (int i = 0; i < 1000; ++i) {
+        collector.OnKeystroke(i % 7 == 0, AtMs(base, 120LL * i));
+    }
+    collector.OnUndo();
+    collector.OnRedo();
+    collector.OnTabChange();
+    collector.OnCompileStart();
+    collector.OnCompileEnd(1, 0, false);
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+TEST(test_keystroke_path_no_allocations)
+{
+    DataCollector collector;
+    auto base = std::chrono::steady_clock::now();
+    WarmUp(collector, base);
+
+    AllocationScope scope;
+    for (int i = 0; i < 10000; ++i) {
+        // Mix of normal gaps, pauses (>2s) and breaks (>30s)
+        long long gap = (i % 97 == 0) ? 35000 : (i % 31 == 0) ? 2500 : 110;
+        base += std::chrono::milliseconds(gap);
+        collector.OnKeystroke(i % 9 == 0, AtMs(base, 120000));
+    }
+    ASSERT_NO_ALLOCATIONS(scope);
+}
+
+TEST(test_undo_and_tab_change_no_allocations)
+{
+    DataCollector collector;
+    auto base = std::chrono::steady_clock::now();
+    WarmUp(collector, base);
+
+    AllocationScope scope;
+    for (int i = 0; i < 2000; ++i) {
+        collector.OnKeystroke(false, AtMs(base, 120000 + 150LL * i));
+        if (i % 5 == 0) collector.OnUndo();
+        if (i % 11 == 0) collector.OnRedo();
+        if (i % 13 == 0) collector.OnTabChange();
+        if (i % 17 == 0) collector.OnIdleTick();
+    }
+    ASSERT_NO_ALLOCATIONS(scope);
+}
+
+TEST(test_queued_event_path_no_allocations)
+{
+    DataCollector collector;
+    auto base = std::chrono::steady_clock::now();
+    WarmUp(collector, base);
+
+    // Queue storage is allocated once, up front
+    CollectorEventQueue queue(1024);
+    KeystrokeBurstFilter filter(&queue);
+
+    AllocationScope scope;
+    for (int round = 0; round < 100; ++round) {
+        long long t = 200000 + round * 10000LL;
+
+        // Typing, a short paste burst, undo and a tab change per round
+        for (int i = 0; i < 40; ++i) {
+            filter.OnChar('a' + i % 26, i % 10 == 0, AtMs(base, t + 130LL * i));
+        }
+        for (int i = 0; i < 30; ++i) {
+            filter.OnChar('p', false, AtMs(base, t + 6000) + std::chrono::microseconds(100 * i));
+        }
+        filter.Flush(AtMs(base, t + 7000));
+
+        CollectorEvent undo;
+        undo.type = CollectorEventType::UNDO;
+        undo.when = AtMs(base, t + 7100);
+        queue.TryPush(std::move(undo));
+
+        CollectorEvent tab;
+        tab.type = CollectorEventType::TAB_CHANGE;
+        tab.when = AtMs(base, t + 7200);
+        queue.TryPush(std::move(tab));
+
+        collector.ProcessEvents(queue);
+    }
+    ASSERT_NO_ALLOCATIONS(scope);
+    ASSERT_TRUE(queue.dropped() == 0);
+}
+
+TEST(test_rolling_buffer_push_no_allocations)
+{
+    RollingBuffer<long> buffer(300);
+
+    AllocationScope scope;
+    for (long i = 0; i < 100000; ++i) {
+        buffer.push(i);
+    }
+    double stddev = buffer.stddev();
+    ASSERT_NO_ALLOCATIONS(scope);
+    ASSERT_TRUE(buffer.size() == 300 && stddev > 0.0);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main()
+{
+    std::cout << "==================================" << std::endl;
+    std::cout << " Anxiety Monitor Allocation Tests" << std::endl;
+    std::cout << "==================================" << std::endl;
+
+    RUN_TEST(test_keystroke_path_no_allocations);
+    RUN_TEST(test_undo_and_tab_change_no_allocations);
+    RUN_TEST(test_queued_event_path_no_allocations);
+    RUN_TEST(test_rolling_buffer_push_no_allocations);
+
+    std::cout << std::endl;
+    std::cout << "==================================" << std::endl;
+    std::cout << " Results: " << testsPassed << "/" << testsRun << " passed" << std::endl;
+    std::cout << "==================================" << std::endl;
+
+    return (testsPassed == testsRun) ? 0 : 1;
+}
@@ -0,0 +1,593 @@
+/**
+ * @file benchmarks.cpp
+ * @brief Micro-benchmarks for the plugin's hot paths.
+ *
+ * Build: the benchmarks target links the anxiety_core library, so no
+ * wxWidgets / Code::Blocks SDK is needed (cmake -S . -B build &&
+ * cmake --build build). ctest runs it once with --quick as a smoke test.
+ *
+ * Usage:
+ *   benchmarks            Human-readable table
+ *   benchmarks --json     Machine-readable JSON (for regression tracking)
+ *   benchmarks --csv      Machine-readable CSV
+ *   benchmarks --quick    1/10 of the default iterations
+ *
+ * Every benchmark reports ns/op, ops/sec and heap allocations per op
+ * (counted by replacing the global operator new).
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../src/MetricsData.h"
+#include "../src/AnxietyScorer.h"
+#include "../src/CSVWriter.h"
+#include "../src/DataCollector.h"
+#include "../src/DiagnosticParser.h"
+#include "../src/DigraphMatrix.h"
+#include "../src/ErrorFingerprintCache.h"
+#include "../src/Instrumentation.h"
+#include "../src/LiveMetricsSegment.h"
+#include "../src/MetricsEndpoint.h"
+#include "../src/SessionTailFollower.h"
+#include "../src/TraceRecorder.h"
+
+using namespace AnxietyMonitor;
+
+// ============================================================================
+// Allocation Counting
+// ============================================================================
+
+static std::atomic<unsigned long long> g_allocCount(0);
+static std::atomic<unsigned long long> g_allocBytes(0);
+
+void* operator new(std::size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// ============================================================================
+// Benchmark Harness
+// ============================================================================
+
+struct BenchResult {
+    std::string name;
+    long long iterations;
+    double nsPerOp;
+    double opsPerSec;
+    double allocsPerOp;
+    double bytesPerOp;
+};
+
+// Results are accumulated here so the optimizer cannot drop the work
+static volatile double g_sink = 0.0;
+
+/**
+ * @brief Time fn(i) for i in [0, iterations).
+ * One warm-up pass, then the best of three timed passes (least noise).
+ * Allocations are measured on the last pass.
+ */
+template<typename Fn>
+static BenchResult RunBenchmark(const std::string& name, long long iterations, Fn&& fn)
+{
+    const int PASSES = 3;
+    long long next = 0;
+
+    for (long long i = 0; i < iterations / 10; ++i) {
+        fn(next++);
+    }
+
+    double bestNs = 0.0;
+    unsigned long long allocs = 0;
+    unsigned long long bytes = 0;
+
+    for (int pass = 0; pass < PASSES; ++pass) {
+        unsigned long long allocsBefore = g_allocCount.load(std::memory_order_relaxed);
+        unsigned long long bytesBefore = g_allocBytes.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+
+        for (long long i = 0; i < iterations; ++i) {
+            fn(next++);
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        allocs = g_allocCount.load(std::memory_order_relaxed) - allocsBefore;
+        bytes = g_allocBytes.load(std::memory_order_relaxed) - bytesBefore;
+
+        double ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        if (pass == 0 || ns < bestNs) {
+            bestNs = ns;
+        }
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.nsPerOp = bestNs / static_cast<double>(iterations);
+    result.opsPerSec = result.nsPerOp > 0.0 ? 1e9 / result.nsPerOp : 0.0;
+    result.allocsPerOp = static_cast<double>(allocs) / static_cast<double>(iterations);
+    result.bytesPerOp = static_cast<double>(bytes) / static_cast<double>(iterations);
+    return result;
+}
+
+// A plausible mid-session snapshot for the scorer and CSV writer
+static MetricsSnapshot MakeSampleSnapshot()
+{
+    MetricsSnapshot s;
+    s.timestamp = "2026-01-13T19:30:00";
+    s.sessionId = "bench_session";
+    s.projectName = "BenchProject";
+    s.filePath = "src/main.cpp";
+    s.language = "C++";
+    s.typingSpeedWpm = 42.0;
+    s.latencyVarianceMs = 180.0;
+    s.errorFreqPerMin = 1.5;
+    s.pauseRatio = 0.35;
+    s.errorResolutionTime = 45.0;
+    s.backspaceRate = 12.0;
+    s.consecutiveErrors = 2;
+    s.undoRedoCount = 4;
+    s.idleRatio = 20.0;
+    s.focusSwitches = 0.5;
+    s.compileSuccessRate = 60.0;
+    s.sessionFragmentation = 0.1;
+    s.anxietyScore = 0.0;
+    s.riskLevel = "LOW";
+    s.cpuUsage = 0.0;
+    s.memoryUsage = 0.0;
+    s.windowFocused = true;
+    s.keystrokesTotal = 1200;
+    s.compileAttempts = 5;
+    s.errorCountTotal = 9;
+    s.bulkInserts = 0;
+    s.bulkInsertChars = 0;
+    return s;
+}
+
+// ============================================================================
+// Benchmarks
+// ============================================================================
+
+static BenchResult BenchOnKeystroke(long long iterations)
+{
+    DataCollector collector;
+    collector.StartSession();
+    auto base = std::chrono::steady_clock::now();
+
+    // 120ms between keys: normal typing, no pauses; includes the derived
+    // metrics refresh done every 10th keystroke
+    return RunBenchmark("DataCollector::OnKeystroke", iterations, [&](long long i) {
+        collector.OnKeystroke(i % 12 == 0, base + std::chrono::milliseconds(120 * i));
+    });
+}
+
+static BenchResult BenchOnKeystrokeKeyClass(long long iterations)
+{
+    DataCollector collector;
+    collector.StartSession();
+    auto base = std::chrono::steady_clock::now();
+    const char text[] = "for (int i = 0; i < n; ++i) { sum += v[i]; }\n";
+    
+    // Same cadence as above with key classes, so every key also updates
+    // one digraph cell
+    return RunBenchmark("DataCollector::OnKeystroke (key class)", iterations, [&](long long i) {
+        KeyClass key = i % 12 == 0 ? KeyClass::BACKSPACE
+                                   : DigraphMatrix::Classify(text[i % (sizeof(text) - 1)]);
+        collector.OnKeystroke(key, base + std::chrono::milliseconds(120 * i));
+    });
+}
+
+static BenchResult BenchRollingBufferPush(long long iterations)
+{
+    RollingBuffer<long> buffer(300);
+
+    return RunBenchmark("RollingBuffer::push", iterations, [&](long long i) {
+        buffer.push(static_cast<long>(i & 1023));
+    });
+}
+
+static BenchResult BenchRollingBufferStddev(long long iterations)
+{
+    RollingBuffer<long> buffer(300);
+    for (long i = 0; i < 300; ++i) {
+        buffer.push(80 + (i * 37) % 200);
+    }
+
+    return RunBenchmark("RollingBuffer::stddev", iterations, [&](long long) {
+        g_sink = g_sink + buffer.stddev();
+    });
+}
+
+static BenchResult BenchGetCurrentSnapshot(long long iterations)
+{
+    DataCollector collector;
+    collector.StartSession();
+    collector.SetActiveProject("BenchProject");
+    collector.SetActiveFile("src/main.cpp");
+
+    auto base = std::chrono::steady_clock::now();
+    for (int i = 0; i < 500; ++i) {
+        collector.OnKeystroke(i % 9 == 0, base + std::chrono::milliseconds(150 * i));
+    }
+
+    return RunBenchmark("DataCollector::GetCurrentSnapshot", iterations, [&](long long) {
+        MetricsSnapshot snapshot = collector.GetCurrentSnapshot();
+        g_sink = g_sink + snapshot.typingSpeedWpm;
+    });
+}
+
+static BenchResult BenchGetPanelSnapshot(long long iterations)
+{
+    DataCollector collector;
+    collector.StartSession();
+    collector.SetActiveProject("BenchProject");
+    collector.SetActiveFile("src/main.cpp");
+
+    auto base = std::chrono::steady_clock::now();
+    for (int i = 0; i < 500; ++i) {
+        collector.OnKeystroke(i % 9 == 0, base + std::chrono::milliseconds(150 * i));
+    }
+
+    return RunBenchmark("DataCollector::GetCurrentSnapshot(PANEL)", iterations, [&](long long) {
+        MetricsSnapshot snapshot = collector.GetCurrentSnapshot(SNAPSHOT_PANEL);
+        g_sink = g_sink + snapshot.typingSpeedWpm;
+    });
+}
+
+static BenchResult BenchGetSharedSnapshotCached(long long iterations)
+{
+    DataCollector collector;
+    collector.StartSession();
+    collector.SetActiveProject("BenchProject");
+    collector.SetActiveFile("src/main.cpp");
+
+    auto base = std::chrono::steady_clock::now();
+    for (int i = 0; i < 500; ++i) {
+        collector.OnKeystroke(i % 9 == 0, base + std::chrono::milliseconds(150 * i));
+    }
+
+    // No input between reads: served from the cache (rebuilt once per bucket)
+    return RunBenchmark("DataCollector::GetSharedSnapshot (idle)", iterations, [&](long long) {
+        std::shared_ptr<const MetricsSnapshot> snapshot = collector.GetSharedSnapshot();
+        g_sink = g_sink + snapshot->typingSpeedWpm;
+    });
+}
+
+static BenchResult BenchCalculateScore(long long iterations)
+{
+    AnxietyScorer scorer;
+    MetricsSnapshot snapshot = MakeSampleSnapshot();
+
+    return RunBenchmark("AnxietyScorer::CalculateScore", iterations, [&](long long i) {
+        snapshot.backspaceRate = static_cast<double>(i & 31);
+        g_sink = g_sink + scorer.CalculateScore(snapshot);
+    });
+}
+
+static BenchResult BenchWriteSnapshot(long long iterations)
+{
+    namespace fs = std::filesystem;
+
+    fs::path dir = fs::temp_directory_path() /
+        ("anxiety_bench_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+
+    BenchResult result;
+    {
+        CSVWriter writer;
+        writer.SetOutputDirectory(dir.string());
+        if (!writer.StartSession("bench_session")) {
+            std::cerr << "CSVWriter: could not create " << dir << std::endl;
+            std::exit(1);
+        }
+
+        MetricsSnapshot snapshot = MakeSampleSnapshot();
+        result = RunBenchmark("CSVWriter::WriteSnapshot", iterations, [&](long long) {
+            writer.WriteSnapshot(snapshot);
+        });
+        writer.EndSession();
+    }
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    return result;
+}
+
+static BenchResult BenchTailAppendedRow(long long iterations)
+{
+    namespace fs = std::filesystem;
+
+    fs::path dir = fs::temp_directory_path() /
+        ("anxiety_bench_tail_" + std::to_string(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+
+    BenchResult result;
+    {
+        CSVWriter writer;
+        writer.SetOutputDirectory(dir.string());
+        if (!writer.StartSession("bench_session", "tail.csv")) {
+            std::cerr << "CSVWriter: could not create " << dir << std::endl;
+            std::exit(1);
+        }
+
+        // A long session already on disk: each op must cost one row, not
+        // the file
+        MetricsSnapshot snapshot = MakeSampleSnapshot();
+        for (int i = 0; i < 20000; ++i) {
+            writer.WriteSnapshot(snapshot);
+        }
+        SessionTailFollower follower;
+        follower.Watch(dir.string());
+
+        result = RunBenchmark("SessionTailFollower::Poll (1 new row)", iterations, [&](long long) {
+            writer.WriteSnapshot(snapshot);
+            follower.Poll(0);
+        });
+        writer.EndSession();
+    }
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    return result;
+}
+
+static BenchResult BenchScopedProbe(long long iterations)
+{
+    // Cost of one ANXIETY_PROBE: two clock reads plus histogram update
+    return RunBenchmark("ScopedProbe (instrumentation)", iterations, [&](long long) {
+        ANXIETY_PROBE(EDITOR_CALLBACK);
+    });
+}
+
+static BenchResult BenchTraceSpanDisabled(long long iterations)
+{
+    // Cost of one ANXIETY_TRACE with tracing off: a load and a branch
+    TraceRecorder::SetEnabled(false);
+    return RunBenchmark("TraceSpan (disabled)", iterations, [&](long long) {
+        ANXIETY_TRACE("bench.disabled");
+    });
+}
+
+static BenchResult BenchTraceSpanEnabled(long long iterations)
+{
+    // Two clock reads plus a ring append
+    TraceRecorder::SetEnabled(true);
+    BenchResult result = RunBenchmark("TraceSpan (enabled)", iterations, [&](long long) {
+        ANXIETY_TRACE("bench.enabled");
+    });
+    TraceRecorder::SetEnabled(false);
+    TraceRecorder::Clear();
+    return result;
+}
+
+static BenchResult BenchParseTemplateLog(long long iterations)
+{
+    // ~4 MB build log dominated by long template instantiation notes, the
+    // worst case for a line scanner (one op = the whole log)
+    std::string log;
+    const std::string type = "std::map<std::basic_string<char>, std::vector<std::pair<int, "
+                             "std::unique_ptr<Node<std::basic_string<char>>>>>>";
+    for (int i = 0; log.size() < 4 * 1024 * 1024; ++i) {
+        log += "src/tree.cpp: In instantiation of 'void Tree<T>::insert(const T&) [with T = " + type + "]':\n";
+        log += "src/tree.cpp:" + std::to_string(40 + i % 50) + ":9:   required from here\n";
+        log += "src/tree.cpp:" + std::to_string(12 + i % 7) + ":21: error: no match for 'operator<' "
+               "(operand types are '" + type + "' and '" + type + "')\n";
+        log += "/usr/include/c++/bits/stl_function.h:386:20: note: candidate: 'bool std::less<"
+               + type + ">::operator()(const " + type + "&, const " + type + "&) const'\n";
+    }
+    
+    DiagnosticParser parser;
+    BenchResult result = RunBenchmark("DiagnosticParser::Parse (4 MB log)", iterations, [&](long long) {
+        parser.Parse(log.data(), log.size());
+    });
+    if (parser.GetCounts().errors == 0) {
+        std::cerr << "DiagnosticParser found no errors in the benchmark log" << std::endl;
+    }
+    return result;
+}
+
+static BenchResult BenchRecordErrorFingerprints(long long iterations)
+{
+    // A build with the parser's maximum of 256 kept errors: fingerprint
+    // each one and compare with the previous builds (one op = one build).
+    // Half the errors repeat from build to build, half are new.
+    std::vector<Diagnostic> errors(DiagnosticParser::MAX_KEPT_ERRORS);
+    for (size_t i = 0; i < errors.size(); ++i) {
+        errors[i].file = "src/module" + std::to_string(i % 16) + ".cpp";
+        errors[i].line = static_cast<int>(i * 10);
+        errors[i].message = "no match for 'operator<' (operand types are 'Node<"
+                            + std::to_string(i) + ">' and 'int')";
+    }
+    
+    ErrorFingerprintCache cache;
+    std::vector<uint64_t> fingerprints(errors.size());
+    return RunBenchmark("ErrorFingerprintCache::Record (256 errors)", iterations, [&](long long iter) {
+        for (size_t i = 0; i < errors.size(); ++i) {
+            fingerprints[i] = ErrorFingerprintCache::Fingerprint(errors[i]);
+            if (i % 2) fingerprints[i] += static_cast<uint64_t>(iter) << 32;
+        }
+        cache.Record(fingerprints.data(), fingerprints.size());
+    });
+}
+
+static BenchResult BenchLiveSegmentPublish(long long iterations)
+{
+    LiveMetricsSegment segment;
+    segment.Create("/anxiety_monitor_bench." + std::to_string(
+        std::chrono::steady_clock::now().time_since_epoch().count()));
+    LiveMetrics live = LiveMetrics();
+    
+    // Seqlock write of the full record; runs every 10th keystroke
+    return RunBenchmark("LiveMetricsSegment::Publish", iterations, [&](long long i) {
+        live.keystrokesTotal = i;
+        live.anxietyScore = static_cast<double>(i & 127);
+        segment.Publish(live);
+    });
+}
+
+static BenchResult BenchLiveSegmentRead(long long iterations)
+{
+    std::string name = "/anxiety_monitor_bench." + std::to_string(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+    LiveMetricsSegment segment;
+    segment.Create(name);
+    segment.Publish(LiveMetrics());
+    LiveMetricsReader reader;
+    reader.Open(name);
+    LiveMetrics live;
+    
+    return RunBenchmark("LiveMetricsReader::Read", iterations, [&](long long) {
+        reader.Read(live);
+    });
+}
+
+static BenchResult BenchMetricsEndpointPublish(long long iterations)
+{
+    DataCollector collector;
+    collector.StartSession();
+    MetricsSnapshot snapshot = collector.GetCurrentSnapshot();
+    snapshot.riskLevel = "MODERATE";
+    MetricsEndpoint endpoint;     // Not listening: rendering and swap only
+    
+    // Runs once per sample; scrapes then only copy the rendered bytes
+    return RunBenchmark("MetricsEndpoint::Publish", iterations, [&](long long i) {
+        snapshot.anxietyScore = static_cast<double>(i & 127);
+        endpoint.Publish(snapshot);
+    });
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+static void PrintText(const std::vector<BenchResult>& results)
+{
+    std::cout << "==================================" << std::endl;
+    std::cout << " Anxiety Monitor Benchmarks" << std::endl;
+    std::cout << "==================================" << std::endl;
+    std::cout << std::left << std::setw(42) << "benchmark"
+              << std::right << std::setw(12) << "ns/op"
+              << std::setw(14) << "ops/sec"
+              << std::setw(12) << "allocs/op"
+              << std::setw(12) << "bytes/op" << std::endl;
+
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(42) << r.name
+                  << std::right << std::fixed
+                  << std::setw(12) << std::setprecision(1) << r.nsPerOp
+                  << std::setw(14) << std::setprecision(0) << r.opsPerSec
+                  << std::setw(12) << std::setprecision(2) << r.allocsPerOp
+                  << std::setw(12) << std::setprecision(1) << r.bytesPerOp
+                  << std::endl;
+    }
+}
+
+static void PrintJson(const std::vector<BenchResult>& results)
+{
+    std::cout << "{\"benchmarks\":[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        if (i > 0) std::cout << ",";
+        std::cout << "\n  {\"name\":\"" << r.name << "\""
+                  << ",\"iterations\":" << r.iterations
+                  << std::fixed << std::setprecision(3)
+                  << ",\"ns_per_op\":" << r.nsPerOp
+                  << ",\"ops_per_sec\":" << std::setprecision(0) << r.opsPerSec
+                  << std::setprecision(3)
+                  << ",\"allocs_per_op\":" << r.allocsPerOp
+                  << ",\"bytes_per_op\":" << r.bytesPerOp << "}";
+    }
+    std::cout << "\n]}" << std::endl;
+}
+
+static void PrintCsv(const std::vector<BenchResult>& results)
+{
+    std::cout << "name,iterations,ns_per_op,ops_per_sec,allocs_per_op,bytes_per_op" << std::endl;
+    for (const auto& r : results) {
+        std::cout << r.name << "," << r.iterations
+                  << std::fixed << std::setprecision(3)
+                  << "," << r.nsPerOp
+                  << "," << std::setprecision(0) << r.opsPerSec
+                  << std::setprecision(3)
+                  << "," << r.allocsPerOp
+                  << "," << r.bytesPerOp << std::endl;
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv)
+{
+    enum class Format { TEXT, JSON, CSV } format = Format::TEXT;
+    long long scale = 10;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            format = Format::JSON;
+        } else if (std::strcmp(argv[i], "--csv") == 0) {
+            format = Format::CSV;
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            scale = 1;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--json|--csv] [--quick]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    results.push_back(BenchOnKeystroke(20000 * scale));
+    results.push_back(BenchOnKeystrokeKeyClass(20000 * scale));
+    results.push_back(BenchRollingBufferPush(100000 * scale));
+    results.push_back(BenchRollingBufferStddev(10000 * scale));
+    results.push_back(BenchGetCurrentSnapshot(5000 * scale));
+    results.push_back(BenchGetPanelSnapshot(50000 * scale));
+    results.push_back(BenchGetSharedSnapshotCached(100000 * scale));
+    results.push_back(BenchCalculateScore(50000 * scale));
+    results.push_back(BenchWriteSnapshot(2000 * scale));
+    results.push_back(BenchScopedProbe(100000 * scale));
+    results.push_back(BenchTraceSpanDisabled(1000000 * scale));
+    results.push_back(BenchTraceSpanEnabled(100000 * scale));
+    results.push_back(BenchParseTemplateLog(5 * scale));
+    results.push_back(BenchRecordErrorFingerprints(2000 * scale));
+    results.push_back(BenchLiveSegmentPublish(100000 * scale));
+    results.push_back(BenchLiveSegmentRead(100000 * scale));
+    results.push_back(BenchMetricsEndpointPublish(5000 * scale));
+    results.push_back(BenchTailAppendedRow(2000 * scale));
+
+    switch (format) {
+        case Format::JSON: PrintJson(results); break;
+        case Format::CSV:  PrintCsv(results);  break;
+        default:           PrintText(results); break;
+    }
+
+    return 0;
+}
@@ -1,12 +1,47 @@
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 
 // Include the headers we want to test
 #include "../src/MetricsData.h"
 #include "../src/AnxietyScorer.h"
+#include "../src/ChangePointDetector.h"
+#include "../src/CompileHistory.h"
+#include "../src/CSVReader.h"
+#include "../src/CSVWriter.h"
+#include "../src/BurstFilter.h"
+#include "../src/DataCollector.h"
+#include "../src/DiagnosticParser.h"
+#include "../src/DigraphMatrix.h"
+#include "../src/ErrorFingerprintCache.h"
+#include "../src/EventQueue.h"
+#include "../src/Instrumentation.h"
+#include "../src/LiveMetricsSegment.h"
+#include "../src/MetricsEndpoint.h"
+#include "../src/SystemSampler.h"
+#include "../src/SessionClock.h"
+#include "../src/SessionTailFollower.h"
+#include "../src/TraceRecorder.h"
+#include "../src/TrendRing.h"
+#include "../src/WorkloadGenerator.h"
 
 using namespace AnxietyMonitor;
 
@@ -268,6 +303,1634 @@ TEST(test_recommendations_exist)
     ASSERT_TRUE(!critRec.empty());
 }
 
+// ============================================================================
+// Change-Point Detection Tests
+// ============================================================================
+
+TEST(test_page_hinkley_stable_stream)
+{
+    PageHinkleyDetector detector(2.0, 25.0, 4);
+    for (int i = 0; i < 200; ++i) {
+        double value = 20.0 + ((i % 2) ? 1.5 : -1.5);  // Noisy but stable
+        ASSERT_EQ(0, detector.Update(value));
+    }
+    ASSERT_NEAR(20.0, detector.GetBaseline(), 0.5);
+}
+
+TEST(test_page_hinkley_upward_shift)
+{
+    PageHinkleyDetector detector(2.0, 25.0, 4);
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_EQ(0, detector.Update(20.0));
+    }
+    
+    int direction = 0;
+    int samplesToDetect = 0;
+    while (direction == 0 && samplesToDetect < 20) {
+        direction = detector.Update(60.0);
+        ++samplesToDetect;
+    }
+    
+    ASSERT_EQ(1, direction);
+    ASSERT_TRUE(samplesToDetect <= 3);
+}
+
+TEST(test_page_hinkley_downward_shift)
+{
+    PageHinkleyDetector detector(2.0, 25.0, 4);
+    for (int i = 0; i < 20; ++i) {
+        detector.Update(70.0);
+    }
+    
+    int direction = 0;
+    for (int i = 0; i < 20 && direction == 0; ++i) {
+        direction = detector.Update(30.0);
+    }
+    ASSERT_EQ(-1, direction);
+}
+
+TEST(test_shift_detector_emits_events)
+{
+    ShiftDetector detector;
+    std::vector<ShiftEvent> events;
+    
+    MetricsSnapshot snapshot;
+    snapshot.anxietyScore = 15.0;
+    snapshot.errorFreqPerMin = 0.0;
+    snapshot.backspaceRate = 3.0;
+    for (int i = 0; i < 10; ++i) {
+        detector.Update(snapshot, events);
+    }
+    ASSERT_TRUE(events.empty());
+    
+    // Sudden spike in score only
+    snapshot.anxietyScore = 75.0;
+    snapshot.timestamp = "2026-01-13T19:33:00";
+    for (int i = 0; i < 5 && events.empty(); ++i) {
+        detector.Update(snapshot, events);
+    }
+    
+    ASSERT_EQ(static_cast<size_t>(1), events.size());
+    ASSERT_TRUE(events[0].metric == ShiftMetric::ANXIETY_SCORE);
+    ASSERT_EQ(1, events[0].direction);
+    ASSERT_NEAR(15.0, events[0].baseline, 0.01);
+    ASSERT_TRUE(events[0].timestamp == "2026-01-13T19:33:00");
+}
+
+// ============================================================================
+// Burst Coalescing Tests
+// ============================================================================
+
+static std::chrono::steady_clock::time_point AtMicros(
+    std::chrono::steady_clock::time_point base, long long us)
+{
+    return base + std::chrono::microseconds(us);
+}
+
+TEST(test_burst_filter_paste_coalesced)
+{
+    DataCollector collector;
+    collector.StartSession();
+    CollectorEventQueue queue;
+    KeystrokeBurstFilter filter(&queue);
+    
+    auto base = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10000; ++i) {
+        filter.OnChar('a' + (i % 26), false, AtMicros(base, i * 100LL));
+    }
+    filter.Flush(AtMicros(base, 10000 * 100LL + 1000000));
+    
+    collector.ProcessEvents(queue);
+    MetricsSnapshot snapshot = collector.GetCurrentSnapshot();
+    ASSERT_EQ(1, snapshot.bulkInserts);
+    ASSERT_EQ(9999L, snapshot.bulkInsertChars);
+    ASSERT_EQ(1L, snapshot.keystrokesTotal);  // Only the burst's first char
+}
+
+TEST(test_burst_filter_normal_typing_passthrough)
+{
+    DataCollector collector;
+    collector.StartSession();
+    CollectorEventQueue queue;
+    KeystrokeBurstFilter filter(&queue);
+    
+    auto base = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5; ++i) {
+        filter.OnChar('x', false, AtMicros(base, i * 150000LL));
+    }
+    ASSERT_EQ(0, filter.GetPendingChars());
+    
+    collector.ProcessEvents(queue);
+    MetricsSnapshot snapshot = collector.GetCurrentSnapshot();
+    ASSERT_EQ(0, snapshot.bulkInserts);
+    ASSERT_EQ(5L, snapshot.keystrokesTotal);
+}
+
+TEST(test_burst_filter_short_burst_replayed)
+{
+    DataCollector collector;
+    collector.StartSession();
+    CollectorEventQueue queue;
+    KeystrokeBurstFilter filter(&queue);
+    
+    // Key rollover: three chars within 2ms, below the bulk threshold
+    auto base = std::chrono::steady_clock::now();
+    filter.OnChar('a', false, AtMicros(base, 0));
+    filter.OnChar('b', false, AtMicros(base, 200000));
+    filter.OnChar('c', false, AtMicros(base, 201000));
+    filter.OnChar('d', false, AtMicros(base, 202000));
+    ASSERT_EQ(2, filter.GetPendingChars());
+    filter.OnChar('e', false, AtMicros(base, 500000));
+    
+    collector.ProcessEvents(queue);
+    MetricsSnapshot snapshot = collector.GetCurrentSnapshot();
+    ASSERT_EQ(0, snapshot.bulkInserts);
+    ASSERT_EQ(5L, snapshot.keystrokesTotal);
+}
+
+TEST(test_burst_filter_auto_repeat_coalesced)
+{
+    DataCollector collector;
+    collector.StartSession();
+    CollectorEventQueue queue;
+    KeystrokeBurstFilter filter(&queue);
+    
+    // Held-down key: steady 33ms auto-repeat
+    auto base = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i) {
+        filter.OnChar('z', false, AtMicros(base, i * 33000LL));
+    }
+    filter.Flush(AtMicros(base, 100 * 33000LL + 1000000));
+    
+    collector.ProcessEvents(queue);
+    MetricsSnapshot snapshot = collector.GetCurrentSnapshot();
+    ASSERT_EQ(1, snapshot.bulkInserts);
+    ASSERT_TRUE(snapshot.keystrokesTotal <= 6);
+    ASSERT_EQ(100L, snapshot.keystrokesTotal + snapshot.bulkInsertChars);
+}
+
+TEST(test_burst_filter_held_backspace_not_folded)
+{
+    DataCollector collector;
+    collector.StartSession();
+    CollectorEventQueue queue;
+    KeystrokeBurstFilter filter(&queue);
+    
+    // Held-down backspace: steady 33ms auto-repeat after four typed chars
+    auto base = std::chrono::steady_clock::now();
+    for (int i = 0; i < 4; ++i) {
+        filter.OnChar('a' + i, false, AtMicros(base, i * 150000LL));
+    }
+    for (int i = 0; i < 40; ++i) {
+        filter.OnChar(8, true, AtMicros(base, 1000000LL + i * 33000LL));
+    }
+    ASSERT_EQ(0, filter.GetPendingChars());
+    filter.Flush(AtMicros(base, 3000000LL));
+    
+    collector.ProcessEvents(queue);
+    MetricsSnapshot snapshot = collector.GetCurrentSnapshot();
+    ASSERT_EQ(0, snapshot.bulkInserts);
+    ASSERT_EQ(44L, snapshot.keystrokesTotal);
+    ASSERT_NEAR(40.0 * 100.0 / 44.0, snapshot.backspaceRate, 0.01);
+}
+
+// ============================================================================
+// Event Queue Tests
+// ============================================================================
+
+TEST(test_event_queue_bounded_drop)
+{
+    BoundedEventQueue<int> queue(4);
+    ASSERT_EQ(static_cast<size_t>(4), queue.capacity());
+    
+    for (int i = 0; i < 6; ++i) {
+        queue.TryPush(int(i));
+    }
+    ASSERT_EQ(2ULL, queue.dropped());
+    
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.TryPop(value));
+        ASSERT_EQ(i, value);  // FIFO
+    }
+    ASSERT_TRUE(!queue.TryPop(value));
+}
+
+TEST(test_collector_derived_metrics_no_self_deadlock)
+{
+    // Every 10th keystroke and every compile end recompute derived metrics
+    // under the collector lock; this used to re-lock and hang
+    DataCollector collector;
+    collector.StartSession();
+    
+    auto base = std::chrono::steady_clock::now();
+    for (int i = 0; i < 25; ++i) {
+        collector.OnKeystroke(false, base + std::chrono::milliseconds(100 * i));
+    }
+    collector.OnCompileStart();
+    collector.OnCompileEnd(2, 0, false);
+    
+    MetricsSnapshot snapshot = collector.GetCurrentSnapshot();
+    ASSERT_EQ(25L, snapshot.keystrokesTotal);
+    ASSERT_EQ(1, snapshot.compileAttempts);
+}
+
+TEST(test_event_queue_concurrent_producers)
+{
+    DataCollector collector;
+    collector.StartSession();
+    CollectorEventQueue queue(1024);
+    
+    const int PRODUCERS = 4;
+    const int EVENTS_PER_PRODUCER = 20000;
+    std::atomic<int> producersDone(0);
+    std::atomic<bool> stop(false);
+    
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, &producersDone, p]() {
+            for (int i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+                CollectorEvent event;
+                event.type = CollectorEventType::KEYSTROKE;
+                event.when = std::chrono::steady_clock::now();
+                event.flag = (p == 0 && i % 10 == 0);
+                queue.TryPush(std::move(event));
+            }
+            ++producersDone;
+        });
+    }
+    
+    // Readers poll snapshots while the consumer drains
+    std::thread reader([&collector, &stop]() {
+        while (!stop.load()) {
+            collector.GetCurrentSnapshot();
+        }
+    });
+    
+    size_t processed = 0;
+    while (producersDone.load() < PRODUCERS) {
+        processed += collector.ProcessEvents(queue);
+    }
+    processed += collector.ProcessEvents(queue);
+    
+    for (auto& t : producers) t.join();
+    stop = true;
+    reader.join();
+    
+    const long long total = static_cast<long long>(PRODUCERS) * EVENTS_PER_PRODUCER;
+    ASSERT_EQ(total, static_cast<long long>(processed + queue.dropped()));
+    
+    MetricsSnapshot snapshot = collector.GetCurrentSnapshot();
+    ASSERT_EQ(static_cast<long>(processed), snapshot.keystrokesTotal);
+    
+    // Consumer held: producers fill the queue and keep going, dropping
+    // instead of waiting, and no single push stalls
+    CollectorEventQueue held(64);
+    std::atomic<long long> slowestPushNs(0);
+    producersDone = 0;
+    producers.clear();
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&held, &producersDone, &slowestPushNs]() {
+            long long slowest = 0;
+            for (int i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+                CollectorEvent event;
+                event.type = CollectorEventType::KEYSTROKE;
+                auto start = std::chrono::steady_clock::now();
+                held.TryPush(std::move(event));
+                slowest = std::max<long long>(slowest, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+            }
+            long long previous = slowestPushNs.load();
+            while (previous < slowest && !slowestPushNs.compare_exchange_weak(previous, slowest)) {
+            }
+            ++producersDone;
+        });
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (producersDone.load() < PRODUCERS && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bool finishedWhileHeld = producersDone.load() == PRODUCERS;
+    for (auto& t : producers) t.join();
+    
+    ASSERT_TRUE(finishedWhileHeld);
+    ASSERT_EQ(total - static_cast<long long>(held.capacity()), static_cast<long long>(held.dropped()));
+    // Generous for preempted CI threads; a blocking push would wait forever
+    ASSERT_TRUE(slowestPushNs.load() < 50LL * 1000 * 1000);
+}
+
+// ============================================================================
+// Snapshot Tests
+// ============================================================================
+
+TEST(test_snapshot_field_mask)
+{
+    DataCollector collector;
+    collector.StartSession();
+    collector.SetActiveProject("MaskProject");
+    collector.SetActiveFile("main.cpp");
+    
+    auto base = std::chrono::steady_clock::now();
+    for (int i = 0; i < 40; ++i) {
+        collector.OnKeystroke(i % 5 == 0, base + std::chrono::milliseconds(120 * i));
+    }
+    collector.OnCompileStart();
+    collector.OnCompileEnd(2, 0, false);
+    
+    MetricsSnapshot full = collector.GetCurrentSnapshot();
+    MetricsSnapshot panel = collector.GetCurrentSnapshot(SNAPSHOT_PANEL);
+    
+    // Requested fields match the full snapshot
+    ASSERT_NEAR(full.anxietyScore, panel.anxietyScore, 1e-9);
+    ASSERT_NEAR(full.typingSpeedWpm, panel.typingSpeedWpm, 1e-9);
+    ASSERT_NEAR(full.backspaceRate, panel.backspaceRate, 1e-9);
+    ASSERT_NEAR(full.pauseRatio, panel.pauseRatio, 1e-9);
+    ASSERT_TRUE(panel.errorFreqPerMin > 0.0);
+    ASSERT_TRUE(panel.riskLevel == full.riskLevel);
+    
+    // Everything else is left empty / zero
+    ASSERT_TRUE(panel.timestamp.empty() && panel.sessionId.empty());
+    ASSERT_TRUE(panel.projectName.empty() && panel.filePath.empty());
+    ASSERT_EQ(0L, panel.keystrokesTotal);
+    ASSERT_EQ(0, panel.compileAttempts);
+    ASSERT_NEAR(0.0, panel.compileSuccessRate, 1e-9);
+    
+    ASSERT_TRUE(full.projectName == "MaskProject");
+    ASSERT_EQ(40L, full.keystrokesTotal);
+}
+
+TEST(test_snapshot_cache_generation)
+{
+    DataCollector collector;
+    PluginSettings settings;
+    settings.sampleIntervalMs = 250;    // 125 ms cache buckets
+    collector.ApplySettings(settings);
+    collector.StartSession();
+    collector.OnKeystroke(false);
+    
+    // Unchanged input, same bucket: the same snapshot object comes back
+    // (retry in case a bucket boundary falls between the two reads)
+    bool reused = false;
+    for (int attempt = 0; attempt < 3 && !reused; ++attempt) {
+        auto first = collector.GetSharedSnapshot();
+        reused = collector.GetSharedSnapshot() == first;
+    }
+    ASSERT_TRUE(reused);
+    
+    // New input invalidates; idle ticks do not bump the generation
+    auto before = collector.GetSharedSnapshot();
+    uint64_t generation = collector.GetGeneration();
+    collector.OnIdleTick();
+    ASSERT_EQ(generation, collector.GetGeneration());
+    collector.OnKeystroke(true);
+    ASSERT_TRUE(collector.GetGeneration() > generation);
+    auto after = collector.GetSharedSnapshot();
+    ASSERT_TRUE(after != before);
+    ASSERT_EQ(2L, after->keystrokesTotal);
+    
+    // Time-dependent fields refresh once the bucket rolls over
+    std::this_thread::sleep_for(std::chrono::milliseconds(140));
+    ASSERT_TRUE(collector.GetSharedSnapshot() != after);
+}
+
+// ============================================================================
+// Instrumentation Tests
+// ============================================================================
+
+TEST(test_latency_histogram_percentiles)
+{
+    LatencyHistogram histogram;
+    
+    // 98 fast samples (100 ticks), two slow outliers
+    for (int i = 0; i < 98; ++i) {
+        histogram.Record(100);
+    }
+    histogram.Record(5000);
+    histogram.Record(1000000);
+    
+    OverheadStats stats = histogram.Summarize(1.0);
+    ASSERT_EQ(100ULL, stats.count);
+    ASSERT_TRUE(stats.p50Ns >= 100.0 && stats.p50Ns < 200.0);   // Within 2x
+    ASSERT_TRUE(stats.p99Ns >= 5000.0 && stats.p99Ns < 10000.0);
+    ASSERT_NEAR(1000000.0, stats.maxNs, 0.01);
+    
+    histogram.Reset();
+    ASSERT_EQ(0ULL, histogram.Summarize(1.0).count);
+}
+
+TEST(test_scoped_probe_records_site)
+{
+    Instrumentation::Reset();
+    {
+        ANXIETY_PROBE(GET_SNAPSHOT);
+    }
+    
+    DataCollector collector;
+    collector.StartSession();
+    collector.GetCurrentSnapshot();
+    
+    OverheadStats stats = Instrumentation::GetStats(ProbeSite::GET_SNAPSHOT);
+    if (Instrumentation::IsEnabled()) {
+        ASSERT_EQ(2ULL, stats.count);
+        ASSERT_TRUE(stats.maxNs >= stats.p50Ns);
+    } else {
+        ASSERT_EQ(0ULL, stats.count);
+    }
+    ASSERT_EQ(0ULL, Instrumentation::GetStats(ProbeSite::WRITE_SNAPSHOT).count);
+}
+
+// ============================================================================
+// Trace Recorder Tests
+// ============================================================================
+
+static size_t CountOccurrences(const std::string& text, const std::string& needle)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos;
+         pos = text.find(needle, pos + needle.size())) {
+        ++count;
+    }
+    return count;
+}
+
+TEST(test_trace_disabled_records_nothing)
+{
+    TraceRecorder::SetEnabled(false);
+    TraceRecorder::Clear();
+    {
+        ANXIETY_TRACE("test.disabled");
+    }
+    
+    std::ostringstream out;
+    ASSERT_EQ(size_t(0), TraceRecorder::WriteChromeTrace(out));
+    ASSERT_TRUE(out.str().find("test.disabled") == std::string::npos);
+    ASSERT_TRUE(out.str().find("\"traceEvents\"") != std::string::npos);
+}
+
+TEST(test_trace_spans_from_two_threads)
+{
+    TraceRecorder::Clear();
+    TraceRecorder::SetEnabled(true);
+    {
+        ANXIETY_TRACE("test.outer");
+        ANXIETY_TRACE("test.inner");
+    }
+    std::thread worker([]() {
+        for (int i = 0; i < 10; ++i) {
+            ANXIETY_TRACE("test.worker");
+        }
+    });
+    worker.join();
+    TraceRecorder::SetEnabled(false);
+    
+    std::ostringstream out;
+    size_t written = TraceRecorder::WriteChromeTrace(out);
+    std::string json = out.str();
+    if (Instrumentation::IsEnabled()) {
+        ASSERT_EQ(size_t(12), written);
+        ASSERT_EQ(size_t(12), CountOccurrences(json, "\"ph\":\"X\""));
+        ASSERT_EQ(size_t(10), CountOccurrences(json, "\"test.worker\""));
+        // Outer span starts first, so it is emitted first
+        ASSERT_TRUE(json.find("test.outer") < json.find("test.inner"));
+    } else {
+        ASSERT_EQ(size_t(0), written);
+    }
+    
+    // Clear hides everything recorded so far
+    TraceRecorder::Clear();
+    std::ostringstream cleared;
+    ASSERT_EQ(size_t(0), TraceRecorder::WriteChromeTrace(cleared));
+}
+
+TEST(test_trace_ring_keeps_newest_spans)
+{
+    TraceRecorder::Clear();
+    TraceRecorder::SetEnabled(true);
+    std::thread worker([]() {
+        for (size_t i = 0; i < TraceRecorder::RING_CAPACITY + 100; ++i) {
+            ANXIETY_TRACE(i < 100 ? "test.old" : "test.new");
+        }
+    });
+    worker.join();
+    TraceRecorder::SetEnabled(false);
+    
+    std::ostringstream out;
+    size_t written = TraceRecorder::WriteChromeTrace(out);
+    if (Instrumentation::IsEnabled()) {
+        ASSERT_EQ(TraceRecorder::RING_CAPACITY, written);
+        ASSERT_TRUE(out.str().find("test.old") == std::string::npos);
+    }
+}
+
+// ============================================================================
+// System Sampler Tests
+// ============================================================================
+
+TEST(test_parse_proc_stat)
+{
+    const char* text =
+        "cpu  4705 150 1120 16250 520 20 30 10 0 0\n"
+        "cpu0 1393280 32966 572056 13343292 6130 0 17875 0 0 0\n";
+    SystemSampler::CpuTimes times;
+    ASSERT_TRUE(SystemSampler::ParseProcStat(text, std::strlen(text), times));
+    ASSERT_EQ(22805ULL, times.total);           // First 8 fields
+    ASSERT_EQ(22805ULL - 16770ULL, times.busy); // Minus idle + iowait
+    
+    // Per-core line or garbage is rejected
+    ASSERT_TRUE(!SystemSampler::ParseProcStat("cpu0 1 2 3 4", 12, times));
+    ASSERT_TRUE(!SystemSampler::ParseProcStat("intr 1 2", 8, times));
+}
+
+TEST(test_parse_statm_and_cpu_delta)
+{
+    const char* statm = "51234 10240 2048 300 0 40000 0\n";
+    unsigned long long resident = 0;
+    ASSERT_TRUE(SystemSampler::ParseStatmResident(statm, std::strlen(statm), resident));
+    ASSERT_EQ(10240ULL, resident);
+    
+    SystemSampler::CpuTimes before, after;
+    before.busy = 1000; before.total = 4000;
+    after.busy = 1750;  after.total = 5000;
+    ASSERT_NEAR(75.0, SystemSampler::CpuUsageBetween(before, after), 0.01);
+    ASSERT_NEAR(0.0, SystemSampler::CpuUsageBetween(after, after), 0.01);
+}
+
+TEST(test_system_sampler_publishes_to_snapshot)
+{
+    SystemSampler sampler;
+    sampler.Start(10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sampler.Stop();
+    ASSERT_TRUE(!sampler.IsRunning());
+    
+    DataCollector collector;
+    collector.SetSystemSampler(&sampler);
+    collector.StartSession();
+    MetricsSnapshot snapshot = collector.GetCurrentSnapshot();
+    
+    ASSERT_TRUE(snapshot.cpuUsage >= 0.0 && snapshot.cpuUsage <= 100.0);
+#ifdef __linux__
+    ASSERT_TRUE(snapshot.memoryUsage > 0.0);    // This process has RSS
+#endif
+}
+
+// ============================================================================
+// CSV Round-Trip Tests
+// ============================================================================
+
+static std::filesystem::path MakeTempDir(const char* name)
+{
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / name / "nested";
+    std::filesystem::remove_all(dir.parent_path());
+    return dir;
+}
+
+TEST(test_csv_writer_reader_round_trip)
+{
+    std::filesystem::path dir = MakeTempDir("anxiety_csv_round_trip");
+    
+    MetricsSnapshot written = MetricsSnapshot();
+    written.timestamp = "2026-01-13T19:30:00";
+    written.sessionId = "session_1";
+    written.projectName = "My, \"Quoted\" Project";
+    written.filePath = "src/main.cpp";
+    written.language = "C++";
+    written.typingSpeedWpm = 42.5;
+    written.backspaceRate = 3.25;
+    written.consecutiveErrors = 4;
+    written.anxietyScore = 61.75;
+    written.riskLevel = "HIGH";
+    written.windowFocused = true;
+    written.keystrokesTotal = 1234;
+    written.bulkInsertChars = 80;
+    written.overhead[static_cast<size_t>(ProbeSite::GET_SNAPSHOT)].p99Ns = 2048;
+    written.digraphs[0].first = KeyClass::LETTER_LEFT;
+    written.digraphs[0].second = KeyClass::BRACKET;
+    written.digraphs[0].deltaMs = 85.5;
+    written.digraphs[0].zScore = -2.25;
+    
+    CSVWriter writer;
+    writer.SetOutputDirectory(dir.string());
+    writer.SetOverheadColumns(true);
+    writer.SetDigraphColumns(true);
+    // Output directory (and its parent) must be created on demand
+    ASSERT_TRUE(writer.StartSession("session_1"));
+    ASSERT_TRUE(writer.GetLastError().empty());
+    ASSERT_TRUE(writer.WriteSnapshot(written));
+    written.anxietyScore = 20.0;
+    ASSERT_TRUE(writer.WriteSnapshot(written));
+    writer.EndSession();
+    
+    std::vector<MetricsSnapshot> rows;
+    std::string error;
+    ASSERT_TRUE(CSVReader::ReadSession(writer.GetCurrentFilePath(), rows, &error));
+    ASSERT_EQ(size_t(2), rows.size());
+    ASSERT_TRUE(rows[0].projectName == written.projectName);
+    ASSERT_TRUE(rows[0].riskLevel == "HIGH");
+    ASSERT_NEAR(42.5, rows[0].typingSpeedWpm, 0.001);
+    ASSERT_NEAR(3.25, rows[0].backspaceRate, 0.001);
+    ASSERT_EQ(4, rows[0].consecutiveErrors);
+    ASSERT_NEAR(61.75, rows[0].anxietyScore, 0.001);
+    ASSERT_NEAR(20.0, rows[1].anxietyScore, 0.001);
+    ASSERT_TRUE(rows[0].windowFocused);
+    ASSERT_EQ(1234L, rows[0].keystrokesTotal);
+    ASSERT_EQ(80L, rows[0].bulkInsertChars);
+    ASSERT_NEAR(2048.0, rows[0].overhead[static_cast<size_t>(ProbeSite::GET_SNAPSHOT)].p99Ns, 0.5);
+    ASSERT_TRUE(rows[0].digraphs[0].first == KeyClass::LETTER_LEFT);
+    ASSERT_TRUE(rows[0].digraphs[0].second == KeyClass::BRACKET);
+    ASSERT_NEAR(85.5, rows[0].digraphs[0].deltaMs, 0.001);
+    ASSERT_NEAR(-2.25, rows[0].digraphs[0].zScore, 0.001);
+    ASSERT_TRUE(rows[0].digraphs[1].first == KeyClass::UNKNOWN);
+    
+    std::filesystem::remove_all(dir.parent_path());
+}
+
+TEST(test_csv_reader_older_format)
+{
+    std::filesystem::path dir = MakeTempDir("anxiety_csv_older_format");
+    std::filesystem::create_directories(dir);
+    std::string path = (dir / "old_session.csv").string();
+    {
+        // Pre bulk-insert columns, a quoted multi-line field and CRLF endings
+        std::ofstream out(path, std::ios::binary);
+        out << "timestamp,project_name,anxiety_score,risk_level,window_focused\r\n"
+            << "2026-01-13T19:30:00,\"Line one\nline two\",15.42,LOW,true\r\n"
+            << "2026-01-13T19:30:30,Plain,72.00,HIGH,false\r\n"
+            << "\r\n";
+    }
+    
+    CSVReader reader;
+    ASSERT_TRUE(reader.Open(path));
+    ASSERT_TRUE(reader.HasColumn("risk_level"));
+    ASSERT_TRUE(!reader.HasColumn("bulk_inserts"));
+    
+    MetricsSnapshot row;
+    ASSERT_TRUE(reader.ReadNext(row));
+    ASSERT_TRUE(row.projectName == "Line one\nline two");
+    ASSERT_NEAR(15.42, row.anxietyScore, 0.001);
+    ASSERT_TRUE(row.windowFocused);
+    ASSERT_EQ(0, row.bulkInserts);
+    ASSERT_TRUE(reader.ReadNext(row));
+    ASSERT_TRUE(row.riskLevel == "HIGH");
+    ASSERT_TRUE(!row.windowFocused);
+    ASSERT_TRUE(!reader.ReadNext(row));
+    ASSERT_EQ(size_t(2), reader.GetRowsRead());
+    reader.Close();
+    
+    // Files without the score column are rejected with a reason
+    {
+        std::ofstream out(path, std::ios::trunc);
+        out << "a,b,c\n1,2,3\n";
+    }
+    ASSERT_TRUE(!reader.Open(path));
+    ASSERT_TRUE(!reader.GetLastError().empty());
+    
+    std::filesystem::remove_all(dir.parent_path());
+}
+
+// ============================================================================
+// Trend Ring Tests
+// ============================================================================
+
+TEST(test_trend_ring_columns)
+{
+    TrendRing ring(5, 1000);
+    auto t0 = std::chrono::steady_clock::now();
+    
+    // Three scores in the first second share one open column
+    ASSERT_EQ(size_t(0), ring.Add(20.0, t0));
+    ASSERT_EQ(size_t(0), ring.Add(50.0, t0 + std::chrono::milliseconds(400)));
+    ASSERT_EQ(size_t(0), ring.Add(35.0, t0 + std::chrono::milliseconds(900)));
+    ASSERT_EQ(size_t(1), ring.Size());
+    ASSERT_NEAR(20.0, ring[0].minScore, 1e-6);
+    ASSERT_NEAR(50.0, ring[0].maxScore, 1e-6);
+    ASSERT_NEAR(35.0, ring[0].lastScore, 1e-6);
+    ASSERT_EQ(3u, ring[0].count);
+    
+    // Next second closes one column; a 3 s silence leaves two empty ones
+    ASSERT_EQ(size_t(1), ring.Add(60.0, t0 + std::chrono::milliseconds(1100)));
+    ASSERT_EQ(size_t(3), ring.Add(70.0, t0 + std::chrono::milliseconds(4000)));
+    ASSERT_EQ(size_t(5), ring.Size());
+    ASSERT_EQ(0u, ring[2].count);
+    ASSERT_EQ(0u, ring[3].count);
+    ASSERT_NEAR(70.0, ring[4].lastScore, 1e-6);
+}
+
+TEST(test_trend_ring_wraps_and_caps_gaps)
+{
+    TrendRing ring(4, 1000);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) {
+        ring.Add(i * 10.0, t0 + std::chrono::seconds(i));
+    }
+    
+    // Oldest retained first
+    ASSERT_EQ(size_t(4), ring.Size());
+    ASSERT_NEAR(60.0, ring[0].lastScore, 1e-6);
+    ASSERT_NEAR(90.0, ring[3].lastScore, 1e-6);
+    
+    // A gap longer than the ring closes at most Capacity() columns
+    ASSERT_EQ(size_t(4), ring.Add(5.0, t0 + std::chrono::hours(1)));
+    ASSERT_EQ(0u, ring[0].count);
+    ASSERT_NEAR(5.0, ring[3].lastScore, 1e-6);
+    
+    ring.Clear();
+    ASSERT_EQ(size_t(0), ring.Size());
+}
+
+// ============================================================================
+// Compile History Tests
+// ============================================================================
+
+TEST(test_compile_history_resolution_stats)
+{
+    using std::chrono::seconds;
+    CompileHistory history(4);
+    auto t0 = std::chrono::steady_clock::time_point() + std::chrono::hours(1);
+    
+    // fail @10 -> ok @40 (30 s), fail @50 -> fail @60 -> ok @70 (10 s)
+    history.OnStart(t0);
+    history.OnEnd(2, 0, false, t0 + seconds(10));
+    history.OnEnd(0, 1, true, t0 + seconds(40));
+    history.OnEnd(1, 0, false, t0 + seconds(50));
+    history.OnEnd(3, 0, false, t0 + seconds(60));
+    ASSERT_NEAR(30.0, history.GetRecentMeanResolutionSec(), 1e-9);
+    history.OnEnd(0, 0, true, t0 + seconds(70));
+    
+    // Ring of 4: the first failure is gone, both resolutions remain
+    ASSERT_EQ(size_t(4), history.Size());
+    ASSERT_TRUE(history[0].compile.success);
+    ASSERT_NEAR(20.0, history.GetRecentMeanResolutionSec(), 1e-9);
+    
+    // Evicting the 30 s resolution drops it from the recent mean only
+    history.OnEnd(0, 0, true, t0 + seconds(80));
+    ASSERT_NEAR(10.0, history.GetRecentMeanResolutionSec(), 1e-9);
+    
+    ResolutionStats stats = history.GetSessionStats();
+    ASSERT_EQ(2ULL, static_cast<unsigned long long>(stats.count));
+    ASSERT_NEAR(20.0, stats.meanSec, 1e-9);
+    ASSERT_NEAR(30.0, stats.maxSec, 1e-9);
+    ASSERT_NEAR(10.0, stats.p50Sec, 10.0 * 0.125);
+    ASSERT_NEAR(30.0, stats.p90Sec, 30.0 * 0.125);
+    
+    history.Clear();
+    ASSERT_EQ(size_t(0), history.Size());
+    ASSERT_EQ(0ULL, static_cast<unsigned long long>(history.GetSessionStats().count));
+}
+
+TEST(test_resolution_sketch_quantiles)
+{
+    ResolutionSketch sketch;
+    for (long long ms = 1; ms <= 100000; ++ms) {
+        sketch.Record(ms);
+    }
+    ASSERT_EQ(100000ULL, static_cast<unsigned long long>(sketch.GetCount()));
+    ASSERT_NEAR(50000.0, sketch.Quantile(0.50), 50000.0 * 0.125);
+    ASSERT_NEAR(99000.0, sketch.Quantile(0.99), 99000.0 * 0.125);
+    ASSERT_NEAR(100000.0, sketch.Quantile(1.0), 1e-9);   // Clamped to the max
+    ASSERT_NEAR(1.0, sketch.Quantile(0.0), 1e-9);
+}
+
+// ============================================================================
+// Diagnostic Parser Tests
+// ============================================================================
+
+TEST(test_diagnostic_parser_gcc_clang_log)
+{
+    const std::string log =
+        "g++ -c src/main.cpp -o obj/main.o\n"
+        "src/main.cpp: In function 'int main()':\n"
+        "src/main.cpp:12:5: error: 'foo' was not declared in this scope\n"
+        "src/main.cpp:14:10: error: expected ';' before 'return'\r\n"
+        "src/main.cpp:20:3: warning: unused variable 'x' [-Wunused-variable]\n"
+        "C:\\proj\\util.h:7:12: error: cannot convert 'std::string' to 'int'\n"
+        "/usr/include/c++/vector:100:7: note: candidate: 'void f(int)'\n"
+        "src/parse.cpp:3:10: fatal error: missing.h: No such file or directory\n"
+        "obj/main.o:main.cpp:(.text+0x1a): undefined reference to `bar()'\n"
+        "collect2.exe: error: ld returned 1 exit status\n"
+        "=== Build finished: 6 error(s), 1 warning(s) ===";
+    
+    DiagnosticParser parser;
+    parser.Parse(log.data(), log.size());
+    const DiagnosticCounts& counts = parser.GetCounts();
+    
+    ASSERT_EQ(11u, static_cast<unsigned>(parser.GetLineCount()));
+    ASSERT_EQ(6, counts.errors);
+    ASSERT_EQ(1, counts.warnings);
+    ASSERT_EQ(1, counts.notes);
+    ASSERT_EQ(1, counts.errorsByKind[static_cast<size_t>(DiagnosticKind::UNDECLARED)]);
+    ASSERT_EQ(1, counts.errorsByKind[static_cast<size_t>(DiagnosticKind::SYNTAX)]);
+    ASSERT_EQ(1, counts.errorsByKind[static_cast<size_t>(DiagnosticKind::TYPE)]);
+    ASSERT_EQ(1, counts.errorsByKind[static_cast<size_t>(DiagnosticKind::PREPROCESSOR)]);
+    ASSERT_EQ(2, counts.errorsByKind[static_cast<size_t>(DiagnosticKind::LINK)]);
+    ASSERT_EQ(3, counts.filesWithErrors);   // main.cpp, util.h, parse.cpp
+    
+    const std::vector<Diagnostic>& errors = parser.GetErrors();
+    ASSERT_EQ(size_t(6), errors.size());
+    ASSERT_TRUE(errors[0].file == "src/main.cpp");
+    ASSERT_EQ(12, errors[0].line);
+    ASSERT_EQ(5, errors[0].column);
+    ASSERT_TRUE(errors[1].message == "expected ';' before 'return'");
+    ASSERT_TRUE(errors[2].file == "C:\\proj\\util.h");
+    ASSERT_EQ(7, errors[2].line);
+    ASSERT_TRUE(errors[4].message == "undefined reference to `bar()'");
+}
+
+TEST(test_diagnostic_parser_html_build_log)
+{
+    // As Code::Blocks saves it: escaped messages, one per "<br />" line
+    std::string html =
+        "<html>\n<head>\n<title>demo build log</title>\n</head>\n\n<body>\n<tt>\n"
+        "Build started on: <u>10:00</u><br />\n"
+        "<font color=\"#ff0000\">src/a.cpp:3:9: error: no match for &apos;operator&lt;&lt;&apos; "
+        "(operand types are &quot;std::ostream&quot; and &quot;A&amp;&quot;)</font><br />"
+        "src/a.cpp:4:1: warning: unused variable<br />\n"
+        "</tt>\n</body>\n</html>\n";
+    
+    std::string text;
+    DiagnosticParser::HtmlToText(html, text);
+    ASSERT_TRUE(text.find("src/a.cpp:3:9: error: no match for 'operator<<' "
+                          "(operand types are \"std::ostream\" and \"A&\")\n") != std::string::npos);
+    ASSERT_TRUE(text.find('<') == text.find("<<"));
+    
+    DiagnosticParser parser;
+    parser.Parse(text.data(), text.size());
+    ASSERT_EQ(1, parser.GetCounts().errors);
+    ASSERT_EQ(1, parser.GetCounts().warnings);
+    ASSERT_EQ(3, parser.GetErrors()[0].line);
+}
+
+TEST(test_diagnostic_parser_streams_chunks)
+{
+    std::string log;
+    for (int i = 0; i < 200; ++i) {
+        log += "src/t.cpp:" + std::to_string(i + 1) + ":1: error: no matching function for call to 'f'\n";
+        log += "src/t.cpp:" + std::to_string(i + 1) + ":1: note: candidate expects 2 arguments\n";
+    }
+    log += "src/t.cpp:999:1: warning: no newline at end";
+    
+    // Any chunking gives the same result as one pass
+    DiagnosticParser whole;
+    whole.Parse(log.data(), log.size());
+    for (size_t chunk : {size_t(1), size_t(7), size_t(4096)}) {
+        DiagnosticParser parser;
+        for (size_t at = 0; at < log.size(); at += chunk) {
+            parser.Feed(log.data() + at, std::min(chunk, log.size() - at));
+        }
+        parser.Finish();
+        ASSERT_EQ(200, parser.GetCounts().errors);
+        ASSERT_EQ(200, parser.GetCounts().notes);
+        ASSERT_EQ(1, parser.GetCounts().warnings);
+        ASSERT_EQ(200, parser.GetCounts().errorsByKind[static_cast<size_t>(DiagnosticKind::TYPE)]);
+        ASSERT_EQ(1, parser.GetCounts().filesWithErrors);
+        ASSERT_EQ(whole.GetErrors().back().line, parser.GetErrors().back().line);
+    }
+}
+
+// ============================================================================
+// Digraph Matrix Tests
+// ============================================================================
+
+TEST(test_digraph_matrix_deviations)
+{
+    ASSERT_TRUE(DigraphMatrix::Classify('f') == KeyClass::LETTER_LEFT);
+    ASSERT_TRUE(DigraphMatrix::Classify('j') == KeyClass::LETTER_RIGHT);
+    ASSERT_TRUE(DigraphMatrix::Classify('Q') == KeyClass::UPPER);
+    ASSERT_TRUE(DigraphMatrix::Classify('{') == KeyClass::BRACKET);
+    ASSERT_TRUE(DigraphMatrix::Classify('=') == KeyClass::OPERATOR);
+    ASSERT_TRUE(DigraphMatrix::Classify('_') == KeyClass::SYMBOL);
+    ASSERT_TRUE(DigraphMatrix::Classify(127) == KeyClass::BACKSPACE);
+    ASSERT_TRUE(DigraphMatrix::Classify(0xE9) == KeyClass::OTHER);
+    
+    DigraphMatrix matrix;
+    for (int i = 0; i < 40; ++i) {
+        matrix.Record(KeyClass::LETTER_LEFT, KeyClass::SPACE, 100.0f + (i % 2 ? 10.0f : -10.0f));
+        matrix.Record(KeyClass::SPACE, KeyClass::BRACKET, 150.0f);
+        matrix.Record(KeyClass::UNKNOWN, KeyClass::SPACE, 5000.0f);     // Ignored
+    }
+    for (int i = 0; i < 10; ++i) {
+        matrix.Record(KeyClass::LETTER_LEFT, KeyClass::SPACE, 250.0f);  // Slowing down
+        matrix.Record(KeyClass::DIGIT, KeyClass::DIGIT, 400.0f);        // Too few samples
+    }
+    ASSERT_EQ(50u, matrix.GetCount(KeyClass::LETTER_LEFT, KeyClass::SPACE));
+    ASSERT_EQ(0u, matrix.GetCount(KeyClass::UNKNOWN, KeyClass::SPACE));
+    ASSERT_NEAR(130.0, matrix.GetMeanMs(KeyClass::LETTER_LEFT, KeyClass::SPACE), 1e-3);
+    
+    DigraphDeviation top[DIGRAPH_TOP_N];
+    ASSERT_EQ(size_t(2), matrix.TopDeviations(top, DIGRAPH_TOP_N));
+    ASSERT_TRUE(top[0].first == KeyClass::LETTER_LEFT && top[0].second == KeyClass::SPACE);
+    ASSERT_TRUE(top[0].deltaMs > 50.0);
+    ASSERT_TRUE(top[0].zScore > 1.0);
+    ASSERT_TRUE(top[1].first == KeyClass::SPACE && top[1].second == KeyClass::BRACKET);
+    ASSERT_NEAR(0.0, top[1].zScore, 1e-9);
+    ASSERT_TRUE(top[2].first == KeyClass::UNKNOWN);
+    
+    matrix.Clear();
+    ASSERT_EQ(size_t(0), matrix.TopDeviations(top, DIGRAPH_TOP_N));
+}
+
+TEST(test_collector_digraphs_from_typed_keys)
+{
+    using std::chrono::milliseconds;
+    DataCollector collector;
+    auto t0 = std::chrono::steady_clock::time_point() + std::chrono::hours(1);
+    collector.StartSession(t0);
+    
+    // "akak...": a->k slows from 100 ms to 300 ms, k->a stays at 100 ms
+    CollectorEventQueue queue(256);
+    KeystrokeBurstFilter filter(&queue);
+    auto when = t0;
+    for (int i = 0; i < 160; ++i) {
+        bool isK = (i % 2) == 1;
+        when += milliseconds(isK && i > 120 ? 300 : 100);
+        filter.OnChar(isK ? 'k' : 'a', false, when);
+        collector.ProcessEvents(queue);
+    }
+    
+    MetricsSnapshot snapshot = collector.GetSnapshotAt(when);
+    ASSERT_TRUE(snapshot.digraphs[0].first == KeyClass::LETTER_LEFT);
+    ASSERT_TRUE(snapshot.digraphs[0].second == KeyClass::LETTER_RIGHT);
+    ASSERT_TRUE(snapshot.digraphs[0].zScore > 1.0);
+    ASSERT_TRUE(snapshot.digraphs[1].first == KeyClass::LETTER_RIGHT);
+    ASSERT_NEAR(0.0, snapshot.digraphs[1].deltaMs, 1e-6);
+}
+
+// ============================================================================
+// Error Fingerprint Tests
+// ============================================================================
+
+TEST(test_error_fingerprint_cache_recurrence)
+{
+    typedef ErrorFingerprintCache Cache;
+    
+    // Path, digits, quoted names and lines within a bucket do not matter
+    uint64_t a = Cache::Fingerprint("src/main.cpp", 41, "'x1' was not declared in this scope");
+    ASSERT_TRUE(a == Cache::Fingerprint("C:\\proj\\main.cpp", 43, "\xE2\x80\x98y\xE2\x80\x99 was not declared in this scope"));
+    ASSERT_TRUE(a != Cache::Fingerprint("src/main.cpp", 41 + Cache::LINE_BUCKET, "'x1' was not declared in this scope"));
+    ASSERT_TRUE(a != Cache::Fingerprint("src/util.cpp", 41, "'x1' was not declared in this scope"));
+    uint64_t b = Cache::Fingerprint("src/main.cpp", 90, "expected ';' before 'return'");
+    uint64_t c = Cache::Fingerprint("src/main.cpp", 200, "no match for 'operator<'");
+    
+    Cache cache;
+    uint64_t build1[] = {a, b};
+    ErrorRecurrence r = cache.Record(build1, 2);
+    ASSERT_EQ(2, r.newErrors);
+    ASSERT_EQ(0, r.repeatedErrors);
+    ASSERT_EQ(0, r.resolvedErrors);
+    
+    uint64_t build2[] = {b, c, c};      // c twice (template instantiations)
+    r = cache.Record(build2, 3);
+    ASSERT_EQ(1, r.newErrors);
+    ASSERT_EQ(1, r.repeatedErrors);
+    ASSERT_EQ(1, r.resolvedErrors);     // a
+    
+    r = cache.Record(nullptr, 0);       // Clean build
+    ASSERT_EQ(2, r.resolvedErrors);
+    
+    uint64_t build4[] = {a};            // Comes back after being fixed
+    r = cache.Record(build4, 1);
+    ASSERT_EQ(0, r.newErrors);
+    ASSERT_EQ(1, r.repeatedErrors);
+    
+    // Memory stays bounded; the least recently seen errors go first
+    std::vector<uint64_t> batch(100);
+    for (int build = 0; build < 20; ++build) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch[i] = 1000000 + build * 1000 + i;
+        }
+        cache.Record(batch.data(), batch.size());
+        ASSERT_TRUE(cache.Size() <= Cache::MAX_ENTRIES);
+    }
+    r = cache.Record(build4, 1);
+    ASSERT_EQ(1, r.newErrors);          // a was evicted
+    ASSERT_EQ(100, r.resolvedErrors);
+    batch.assign(1, 1000000 + 19 * 1000);
+    r = cache.Record(batch.data(), 1);
+    ASSERT_EQ(1, r.repeatedErrors);     // Recent build still remembered
+}
+
+TEST(test_collector_reports_repeated_errors)
+{
+    using std::chrono::milliseconds;
+    DataCollector collector;
+    auto t0 = std::chrono::steady_clock::time_point() + std::chrono::hours(1);
+    collector.StartSession(t0);
+    
+    const std::string logs[] = {
+        "src/a.cpp:10:5: error: 'foo' was not declared in this scope\n"
+        "src/a.cpp:30:1: error: expected ';' before '}' token\n",
+        "src/a.cpp:11:5: error: 'fooo' was not declared in this scope\n",
+        "",
+    };
+    
+    DiagnosticParser parser;
+    CollectorEventQueue queue(16);
+    for (int i = 0; i < 3; ++i) {
+        parser.Parse(logs[i].data(), logs[i].size());
+        auto diagnostics = std::make_shared<BuildDiagnostics>();
+        diagnostics->counts = parser.GetCounts();
+        for (const Diagnostic& error : parser.GetErrors()) {
+            diagnostics->errorFingerprints.push_back(ErrorFingerprintCache::Fingerprint(error));
+        }
+        
+        CollectorEvent compile;
+        compile.type = CollectorEventType::COMPILE_END;
+        compile.when = t0 + milliseconds(10000 * (i + 1));
+        compile.count = parser.GetCounts().errors;
+        compile.flag = compile.count == 0;
+        compile.diagnostics = std::move(diagnostics);
+        queue.TryPush(std::move(compile));
+        collector.ProcessEvents(queue);
+        
+        ErrorRecurrence last = collector.GetLastErrorRecurrence();
+        if (i == 1) {
+            ASSERT_EQ(0, last.newErrors);
+            ASSERT_EQ(1, last.repeatedErrors);  // Same error, renamed and moved
+            ASSERT_EQ(1, last.resolvedErrors);  // The syntax error
+        }
+    }
+    
+    ErrorRecurrence totals = collector.GetErrorRecurrenceTotals();
+    ASSERT_EQ(2, totals.newErrors);
+    ASSERT_EQ(1, totals.repeatedErrors);
+    ASSERT_EQ(2, totals.resolvedErrors);
+    ASSERT_EQ(3, collector.GetDiagnosticTotals().errors);
+}
+
+// ============================================================================
+// Live Metrics Segment Tests
+// ============================================================================
+
+static std::string UniqueSegmentName()
+{
+    return "/anxiety_monitor_test." +
+           std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+TEST(test_live_segment_seqlock_round_trip)
+{
+    std::string name = UniqueSegmentName();
+    LiveMetricsSegment segment;
+    ASSERT_TRUE(segment.Create(name));
+    
+    LiveMetricsReader reader;
+    ASSERT_TRUE(reader.Open(name));
+    LiveMetrics live;
+    ASSERT_TRUE(!reader.Read(live));        // Nothing published yet
+    
+    LiveMetrics published = LiveMetrics();
+    published.anxietyScore = 42.5;
+    published.riskLevel = 1;
+    published.keystrokesTotal = 1234;
+    segment.Publish(published);
+    ASSERT_TRUE(reader.Read(live));
+    ASSERT_EQ(1u, live.updateCount);
+    ASSERT_NEAR(42.5, live.anxietyScore, 1e-9);
+    ASSERT_EQ(1u, live.riskLevel);
+    ASSERT_EQ(1234, live.keystrokesTotal);
+    ASSERT_TRUE(live.writerPid != 0);
+    
+    // A concurrent writer never exposes a torn payload: every field of a
+    // publication derives from the same counter
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        LiveMetrics next = LiveMetrics();
+        for (int64_t i = 0; i < 200000; ++i) {
+            next.keystrokesTotal = i;
+            next.anxietyScore = static_cast<double>(i);
+            next.compileAttempts = static_cast<int32_t>(i);
+            next.sessionFragmentation = static_cast<double>(i) * 0.5;
+            segment.Publish(next);
+        }
+        done = true;
+    });
+    int torn = 0;
+    while (!done) {
+        if (!reader.Read(live) || live.updateCount == 1) continue;
+        if (live.anxietyScore != static_cast<double>(live.keystrokesTotal) ||
+            live.compileAttempts != static_cast<int32_t>(live.keystrokesTotal) ||
+            live.sessionFragmentation != live.anxietyScore * 0.5) {
+            ++torn;
+        }
+    }
+    writer.join();
+    ASSERT_EQ(0, torn);
+    ASSERT_TRUE(reader.Read(live));
+    ASSERT_EQ(200001u, live.updateCount);
+    
+    segment.Close();
+    LiveMetricsReader late;
+    ASSERT_TRUE(!late.Open(name));          // Name removed on Close()
+}
+
+TEST(test_live_segment_single_writer)
+{
+    std::string name = UniqueSegmentName();
+    LiveMetricsSegment first;
+    ASSERT_TRUE(first.Create(name));
+    LiveMetrics published = LiveMetrics();
+    published.keystrokesTotal = 7;
+    first.Publish(published);
+    
+    // A second writer gets a name of its own and leaves the first intact
+    LiveMetricsSegment second;
+    ASSERT_TRUE(second.Create(name));
+    ASSERT_TRUE(second.GetName() != name);
+    second.Publish(LiveMetrics());
+    second.Close();
+    
+    LiveMetricsReader reader;
+    ASSERT_TRUE(reader.Open(name));
+    LiveMetrics live;
+    ASSERT_TRUE(reader.Read(live));
+    ASSERT_EQ(7, live.keystrokesTotal);
+    reader.Close();
+    
+    // Once the owner is gone the name is free again
+    first.Close();
+    ASSERT_TRUE(!reader.Open(name));
+    LiveMetricsSegment third;
+    ASSERT_TRUE(third.Create(name));
+    ASSERT_TRUE(third.GetName() == name);
+}
+
+TEST(test_collector_publishes_live_metrics)
+{
+    using std::chrono::milliseconds;
+    std::string name = UniqueSegmentName();
+    LiveMetricsSegment segment;
+    ASSERT_TRUE(segment.Create(name));
+    LiveMetricsReader reader;
+    ASSERT_TRUE(reader.Open(name));
+    
+    DataCollector collector;
+    collector.SetLiveSegment(&segment);
+    auto t0 = std::chrono::steady_clock::time_point() + std::chrono::hours(1);
+    collector.StartSession(t0);
+    
+    LiveMetrics live;
+    ASSERT_TRUE(reader.Read(live));
+    ASSERT_EQ(static_cast<uint32_t>(SessionState::RUNNING), live.sessionState);
+    
+    for (int i = 1; i <= 40; ++i) {
+        collector.OnKeystroke(i % 5 == 0, t0 + milliseconds(150 * i));
+    }
+    // Keystrokes alone publish nothing; the plugin's scored sample does
+    uint64_t updates = live.updateCount;
+    ASSERT_TRUE(reader.Read(live));
+    ASSERT_EQ(updates, live.updateCount);
+    
+    MetricsSnapshot sample = collector.GetSnapshotAt(t0 + milliseconds(6500));
+    sample.anxietyScore = 72.5;
+    sample.riskLevel = "HIGH";
+    collector.PublishLiveSample(sample);
+    ASSERT_TRUE(reader.Read(live));
+    ASSERT_EQ(40, live.keystrokesTotal);
+    ASSERT_NEAR(72.5, live.anxietyScore, 1e-9);
+    ASSERT_EQ(static_cast<uint32_t>(RiskLevel::HIGH), live.riskLevel);
+    ASSERT_TRUE(live.typingSpeedWpm > 0.0);
+    
+    // A state change repeats the last sample with the new state
+    collector.PauseSession(t0 + milliseconds(7000));
+    ASSERT_TRUE(reader.Read(live));
+    ASSERT_EQ(static_cast<uint32_t>(SessionState::PAUSED), live.sessionState);
+    ASSERT_NEAR(72.5, live.anxietyScore, 1e-9);
+    
+    // Detached: later changes are not published
+    updates = live.updateCount;
+    collector.SetLiveSegment(nullptr);
+    collector.ResumeSession(t0 + milliseconds(9000));
+    ASSERT_TRUE(reader.Read(live));
+    ASSERT_EQ(updates, live.updateCount);
+}
+
+// ============================================================================
+// Metrics Endpoint Tests
+// ============================================================================
+
+TEST(test_metrics_endpoint_renders_prometheus)
+{
+    MetricsSnapshot snapshot = MetricsSnapshot();
+    snapshot.timestamp = "2026-01-13T19:30:00";
+    snapshot.anxietyScore = 61.75;
+    snapshot.riskLevel = "HIGH";
+    snapshot.typingSpeedWpm = 42.5;
+    snapshot.keystrokesTotal = 1234;
+    
+    std::string text = MetricsEndpoint::RenderPrometheus(snapshot);
+    ASSERT_TRUE(text.find("# TYPE anxiety_score gauge\nanxiety_score 61.75\n") != std::string::npos);
+    ASSERT_TRUE(text.find("\nanxiety_risk_level 2\n") != std::string::npos);
+    ASSERT_TRUE(text.find("\nanxiety_typing_speed_wpm 42.5\n") != std::string::npos);
+    ASSERT_TRUE(text.find("# TYPE anxiety_keystrokes_total counter\nanxiety_keystrokes_total 1234\n") != std::string::npos);
+    
+    // One line, so it fits a single SSE data field
+    std::string json = MetricsEndpoint::RenderJson(snapshot);
+    ASSERT_EQ('{', json.front());
+    ASSERT_EQ('}', json.back());
+    ASSERT_TRUE(json.find('\n') == std::string::npos);
+    ASSERT_TRUE(json.find("\"timestamp\":\"2026-01-13T19:30:00\"") != std::string::npos);
+    ASSERT_TRUE(json.find("\"risk_level\":\"HIGH\"") != std::string::npos);
+    ASSERT_TRUE(json.find("\"anxiety_score\":61.75") != std::string::npos);
+    ASSERT_TRUE(json.find("\"keystrokes_total\":1234") != std::string::npos);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+static int ConnectTcp(int port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = sockaddr_in();
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int ConnectUnix(const std::string& path)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = sockaddr_un();
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Read until `marker` arrives (true) or the peer closes / 2 s pass (false)
+static bool ReadUntil(int fd, std::string& received, const std::string& marker)
+{
+    while (received.find(marker) == std::string::npos) {
+        pollfd entry = {fd, POLLIN, 0};
+        if (poll(&entry, 1, 2000) <= 0) return false;
+        char buffer[4096];
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return false;
+        received.append(buffer, static_cast<size_t>(n));
+    }
+    return true;
+}
+
+// One request on a fresh connection; the response up to the server's close
+static std::string HttpGet(int fd, const std::string& path)
+{
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    std::string response;
+    if (fd < 0 || send(fd, request.data(), request.size(), 0) < 0) return response;
+    ReadUntil(fd, response, "\n\n\n");      // Never sent: reads to close
+    close(fd);
+    return response;
+}
+
+TEST(test_metrics_endpoint_serves_scrape_and_events)
+{
+    MetricsEndpoint endpoint;
+    ASSERT_TRUE(endpoint.StartTcp(0));
+    ASSERT_TRUE(endpoint.GetPort() > 0);
+    ASSERT_TRUE(HttpGet(ConnectTcp(endpoint.GetPort()), "/metrics").find(" 503 ") != std::string::npos);
+    
+    MetricsSnapshot snapshot = MetricsSnapshot();
+    snapshot.anxietyScore = 61.75;
+    snapshot.riskLevel = "HIGH";
+    endpoint.Publish(snapshot);
+    
+    std::string scrape = HttpGet(ConnectTcp(endpoint.GetPort()), "/metrics?x=1");
+    ASSERT_TRUE(scrape.find("HTTP/1.1 200 OK\r\n") == 0);
+    ASSERT_TRUE(scrape.find("text/plain; version=0.0.4") != std::string::npos);
+    ASSERT_TRUE(scrape.find("\nanxiety_score 61.75\n") != std::string::npos);
+    ASSERT_TRUE(HttpGet(ConnectTcp(endpoint.GetPort()), "/other").find(" 404 ") != std::string::npos);
+    
+    // SSE: the current rendering right away, then each new one
+    int stream = ConnectTcp(endpoint.GetPort());
+    std::string request = "GET /events HTTP/1.1\r\n\r\n";
+    ASSERT_TRUE(send(stream, request.data(), request.size(), 0) > 0);
+    std::string events;
+    ASSERT_TRUE(ReadUntil(stream, events, "}\n\n"));
+    ASSERT_TRUE(events.find("text/event-stream") != std::string::npos);
+    ASSERT_TRUE(events.find("id: 1\nevent: metrics\ndata: {") != std::string::npos);
+    ASSERT_TRUE(events.find("\"anxiety_score\":61.75,") != std::string::npos);
+    
+    snapshot.anxietyScore = 70;
+    endpoint.Publish(snapshot);
+    events.clear();
+    ASSERT_TRUE(ReadUntil(stream, events, "}\n\n"));
+    ASSERT_TRUE(events.find("id: 2\n") == 0);
+    ASSERT_TRUE(events.find("\"anxiety_score\":70,") != std::string::npos);
+    close(stream);
+    ASSERT_EQ(4, static_cast<int>(endpoint.GetRequestCount()));
+    endpoint.Stop();
+    ASSERT_TRUE(!endpoint.IsRunning());
+    
+    // Same responses over a Unix domain socket
+    std::string path = (std::filesystem::temp_directory_path() / "anxiety_endpoint_test.sock").string();
+    ASSERT_TRUE(endpoint.StartUnix(path));
+    endpoint.Publish(snapshot);
+    ASSERT_TRUE(HttpGet(ConnectUnix(path), "/metrics").find("\nanxiety_score 70\n") != std::string::npos);
+    endpoint.Stop();
+    ASSERT_TRUE(!std::filesystem::exists(path));
+}
+
+TEST(test_metrics_endpoint_never_replaces_other_files)
+{
+    std::string path = (std::filesystem::temp_directory_path() / "anxiety_endpoint_keep.sock").string();
+    {
+        std::ofstream file(path);
+        file << "not a socket\n";
+    }
+    MetricsEndpoint endpoint;
+    ASSERT_TRUE(!endpoint.StartUnix(path));
+    ASSERT_TRUE(std::filesystem::is_regular_file(path));
+    std::filesystem::remove(path);
+    
+    // A socket with a live listener is not taken over either
+    MetricsEndpoint first;
+    ASSERT_TRUE(first.StartUnix(path));
+    ASSERT_TRUE(!endpoint.StartUnix(path));
+    ASSERT_TRUE(first.IsRunning());
+    first.Stop();
+}
+
+TEST(test_metrics_endpoint_closes_idle_connections)
+{
+    MetricsEndpoint endpoint(200);
+    ASSERT_TRUE(endpoint.StartTcp(0));
+    endpoint.Publish(MetricsSnapshot());
+    
+    // Connections that never send a request fill every slot, then time out
+    std::vector<int> idle;
+    for (size_t i = 0; i < MetricsEndpoint::MAX_CLIENTS; ++i) {
+        idle.push_back(ConnectTcp(endpoint.GetPort()));
+        ASSERT_TRUE(idle.back() >= 0);
+    }
+    std::string received;
+    ASSERT_TRUE(!ReadUntil(idle.front(), received, "\n"));
+    ASSERT_TRUE(received.empty());
+    
+    std::string scrape = HttpGet(ConnectTcp(endpoint.GetPort()), "/metrics");
+    ASSERT_TRUE(scrape.find("HTTP/1.1 200 OK\r\n") == 0);
+    for (int fd : idle) {
+        close(fd);
+    }
+    endpoint.Stop();
+}
+#endif
+
+// ============================================================================
+// Session Tail Tests
+// ============================================================================
+
+TEST(test_csv_parse_record_from_buffer)
+{
+    std::vector<std::string> fields;
+    const std::string buffer = "a,\"x\ny, \"\"q\"\"\",3\r\nnext,row";
+    size_t used = CSVReader::ParseRecord(buffer.data(), buffer.size(), fields);
+    ASSERT_EQ(buffer.find("next"), used);
+    ASSERT_EQ(3, static_cast<int>(fields.size()));
+    ASSERT_TRUE(fields[1] == "x\ny, \"q\"");
+    ASSERT_TRUE(fields[2] == "3");
+    
+    // Incomplete: no newline yet, or the newline is inside quotes
+    ASSERT_EQ(0, static_cast<int>(CSVReader::ParseRecord(buffer.data() + used, buffer.size() - used, fields)));
+    ASSERT_EQ(0, static_cast<int>(CSVReader::ParseRecord("a,\"open\n", 8, fields)));
+    
+    // At end of input the buffer end closes the record
+    ASSERT_EQ(8, static_cast<int>(CSVReader::ParseRecord("a,\"open\n", 8, fields, true)));
+    ASSERT_TRUE(fields.size() == 2 && fields[1] == "open\n");
+    
+    // The stream reader gives the same records
+    std::istringstream stream(buffer + "\n\"tail");
+    ASSERT_TRUE(CSVReader::ReadRecord(stream, fields));
+    ASSERT_TRUE(fields.size() == 3 && fields[1] == "x\ny, \"q\"");
+    ASSERT_TRUE(CSVReader::ReadRecord(stream, fields));
+    ASSERT_TRUE(fields.size() == 2 && fields[1] == "row");
+    ASSERT_TRUE(CSVReader::ReadRecord(stream, fields));
+    ASSERT_TRUE(fields.size() == 1 && fields[0] == "tail");
+    ASSERT_TRUE(!CSVReader::ReadRecord(stream, fields));
+}
+
+TEST(test_tail_follower_ingests_appended_rows)
+{
+    std::filesystem::path dir = MakeTempDir("anxiety_tail");
+    CSVWriter writer;
+    writer.SetOutputDirectory(dir.string());
+    ASSERT_TRUE(writer.StartSession("s1", "live.csv"));
+    std::string path = writer.GetCurrentFilePath();
+    
+    MetricsSnapshot row = MetricsSnapshot();
+    row.sessionId = "s1";
+    row.anxietyScore = 20;
+    row.riskLevel = "LOW";
+    ASSERT_TRUE(writer.WriteSnapshot(row));
+    
+    SessionTailFollower follower;
+    ASSERT_TRUE(follower.Watch(dir.string()));
+    ASSERT_EQ(1, static_cast<int>(follower.GetSessions().at("live.csv").rows));
+    
+    // Other CSVs in the folder are not sessions
+    std::ofstream(dir / "anxiety_events_x.csv") << "timestamp,session_id,metric\n1,s1,score\n";
+    row.anxietyScore = 70;
+    row.riskLevel = "HIGH";
+    ASSERT_TRUE(writer.WriteSnapshot(row));
+    ASSERT_EQ(1, static_cast<int>(follower.Poll(1000)));
+    writer.EndSession();
+    
+    // A partial line waits for its newline; only new bytes are counted,
+    // the partial line once although it is read twice
+    uint64_t readBefore = follower.GetBytesRead();
+    uint64_t sizeBefore = std::filesystem::file_size(path);
+    std::ofstream(path, std::ios::app | std::ios::binary) << "2026-01-13T19:30:00,s1";
+    ASSERT_EQ(0, static_cast<int>(follower.Poll(1000)));
+    std::ofstream(path, std::ios::app | std::ios::binary) << std::string(16, ',') << "90,CRITICAL\n";
+    ASSERT_EQ(1, static_cast<int>(follower.Poll(1000)));
+    ASSERT_EQ(std::filesystem::file_size(path) - sizeBefore, follower.GetBytesRead() - readBefore);
+    
+    const TailSessionStats& stats = follower.GetSessions().at("live.csv");
+    ASSERT_EQ(3, static_cast<int>(stats.rows));
+    ASSERT_NEAR(60.0, stats.MeanScore(), 1e-9);
+    ASSERT_NEAR(90.0, stats.latest.anxietyScore, 1e-9);
+    ASSERT_EQ(1, static_cast<int>(stats.rowsByRisk[static_cast<int>(RiskLevel::CRITICAL)]));
+    ASSERT_TRUE(stats.sessionId == "s1");
+    
+    // Truncated and rewritten in place: totals restart
+    std::string header;
+    std::getline(std::ifstream(path), header);
+    std::ofstream(path, std::ios::trunc | std::ios::binary) << header << "\n2026-01-13T20:00:00,s2" << std::string(16, ',') << "40,MODERATE\n";
+    ASSERT_EQ(1, static_cast<int>(follower.Poll(1000)));
+    ASSERT_EQ(1, static_cast<int>(follower.GetSessions().at("live.csv").rows));
+    ASSERT_EQ(1, follower.GetSessions().at("live.csv").resets);
+    
+    // Rotated away and replaced under the same name
+    std::filesystem::rename(path, path + ".1");
+    std::ofstream(path, std::ios::binary) << header << "\n,s3" << std::string(16, ',') << "10,LOW\n,s3"
+                                          << std::string(16, ',') << "30,LOW\n";
+    ASSERT_EQ(2, static_cast<int>(follower.Poll(1000)));
+    
+    TailTotals totals = follower.GetTotals();
+    ASSERT_EQ(1, static_cast<int>(totals.sessions));
+    ASSERT_EQ(2, static_cast<int>(totals.rows));
+    ASSERT_NEAR(20.0, totals.MeanScore(), 1e-9);
+    ASSERT_EQ(2, static_cast<int>(totals.rowsByRisk[static_cast<int>(RiskLevel::LOW)]));
+    std::filesystem::remove_all(dir.parent_path());
+}
+
+// ============================================================================
+// Session Clock Tests
+// ============================================================================
+
+TEST(test_session_clock_spans)
+{
+    using std::chrono::milliseconds;
+    SessionClock clock(2000);
+    auto t0 = std::chrono::steady_clock::time_point() + std::chrono::hours(1);
+    
+    clock.Start(t0);
+    clock.MarkActivity(t0 + milliseconds(1000));
+    // Idle from 3 s (activity + threshold) until the pause at 10 s
+    clock.Pause(t0 + milliseconds(10000));
+    ASSERT_EQ(7000LL, clock.IdleMs(t0 + milliseconds(50000)));
+    ASSERT_EQ(40000LL, clock.PausedMs(t0 + milliseconds(50000)));
+    ASSERT_EQ(10000LL, clock.RunningMs(t0 + milliseconds(50000)));
+    
+    // Resume counts as activity; reports the pause length
+    ASSERT_TRUE(clock.Resume(t0 + milliseconds(60000)) == milliseconds(50000));
+    ASSERT_EQ(7000LL, clock.IdleMs(t0 + milliseconds(61000)));
+    ASSERT_EQ(8000LL, clock.IdleMs(t0 + milliseconds(63000)));
+    
+    // Late (out-of-order) activity does not rewind the idle span
+    clock.MarkActivity(t0 + milliseconds(64000));
+    clock.MarkActivity(t0 + milliseconds(61500));
+    ASSERT_EQ(9000LL, clock.IdleMs(t0 + milliseconds(65000)));
+    
+    // Stop freezes every total
+    clock.Stop(t0 + milliseconds(70000));
+    ASSERT_EQ(70000LL, clock.ElapsedMs(t0 + milliseconds(99000)));
+    ASSERT_EQ(20000LL, clock.RunningMs(t0 + milliseconds(99000)));
+    ASSERT_EQ(13000LL, clock.IdleMs(t0 + milliseconds(99000)));
+    ASSERT_EQ(7000LL, clock.ActiveMs(t0 + milliseconds(99000)));
+}
+
+TEST(test_collector_excludes_paused_time)
+{
+    using std::chrono::milliseconds;
+    DataCollector collector;
+    auto t0 = std::chrono::steady_clock::time_point() + std::chrono::hours(1);
+    
+    collector.StartSession(t0);
+    for (int i = 1; i <= 295; ++i) {
+        collector.OnKeystroke(false, t0 + milliseconds(200 * i));  // Last at 59 s
+    }
+    CollectorEventQueue queue(16);
+    CollectorEvent compile;
+    compile.type = CollectorEventType::COMPILE_END;
+    compile.when = t0 + milliseconds(30000);
+    compile.count = 3;
+    compile.flag = false;
+    queue.TryPush(std::move(compile));
+    collector.ProcessEvents(queue);
+    
+    // A 9 minute pause, then a key 0.5 s after resuming: the gap is 1.5 s
+    // of unpaused time, not a pause or a break
+    collector.PauseSession(t0 + milliseconds(60000));
+    collector.ResumeSession(t0 + milliseconds(600000));
+    collector.OnKeystroke(false, t0 + milliseconds(600500));
+    
+    MetricsSnapshot snapshot = collector.GetSnapshotAt(t0 + milliseconds(660000));
+    double runningMinutes = (60000 + 60000) / 60000.0;
+    ASSERT_NEAR(3.0 / runningMinutes, snapshot.errorFreqPerMin, 1e-6);
+    ASSERT_NEAR(0.0, snapshot.pauseRatio, 1e-9);
+    ASSERT_NEAR(0.0, snapshot.sessionFragmentation, 1e-9);
+    // Idle only after the last key (+2 s threshold), over running time
+    ASSERT_NEAR(57500.0 / 120000.0, snapshot.idleRatio, 1e-6);
+}
+
+// ============================================================================
+// Workload Generator Tests
+// ============================================================================
+
+static WorkloadConfig MakeWorkloadConfig(uint32_t participant, const WorkloadProfile& profile)
+{
+    WorkloadConfig config;
+    config.seed = 42;
+    config.participant = participant;
+    config.durationMinutes = 30.0;
+    config.startProfile = profile;
+    config.endProfile = profile;
+    return config;
+}
+
+TEST(test_workload_is_reproducible_from_seed)
+{
+    WorkloadGenerator a(MakeWorkloadConfig(7, WorkloadProfile::Moderate()));
+    WorkloadGenerator b(MakeWorkloadConfig(7, WorkloadProfile::Moderate()));
+    WorkloadGenerator other(MakeWorkloadConfig(8, WorkloadProfile::Moderate()));
+    
+    CollectorEvent ea, eb, eo;
+    bool differs = false;
+    long long lastMs = 0;
+    while (a.Next(ea)) {
+        ASSERT_TRUE(b.Next(eb));
+        ASSERT_TRUE(ea.type == eb.type && ea.when == eb.when && ea.count == eb.count &&
+                    ea.flag == eb.flag && ea.text == eb.text);
+        if (!other.Next(eo) || eo.type != ea.type || eo.when != ea.when) {
+            differs = true;
+        }
+        // Time-ordered and within the session
+        long long ms = WorkloadGenerator::ElapsedMs(ea);
+        ASSERT_TRUE(ms >= lastMs && ms <= 30 * 60000);
+        lastMs = ms;
+    }
+    ASSERT_TRUE(!b.Next(eb));
+    ASSERT_TRUE(differs);
+    ASSERT_TRUE(a.GetEventCount() > 1000);
+}
+
+TEST(test_workload_profiles_drive_score)
+{
+    // Replay is deterministic too, and a stressed profile scores higher
+    auto averageScore = [](const WorkloadProfile& profile, size_t& samples) {
+        WorkloadGenerator generator(MakeWorkloadConfig(3, profile));
+        DataCollector collector;
+        double total = 0.0;
+        samples = generator.Replay(collector, 30000, [&](const MetricsSnapshot& snapshot) {
+            total += snapshot.anxietyScore;
+        });
+        return samples ? total / samples : 0.0;
+    };
+    
+    size_t calmSamples = 0, stressedSamples = 0, againSamples = 0;
+    double calm = averageScore(WorkloadProfile::Calm(), calmSamples);
+    double stressed = averageScore(WorkloadProfile::Stressed(), stressedSamples);
+    double again = averageScore(WorkloadProfile::Calm(), againSamples);
+    
+    ASSERT_EQ(size_t(60), calmSamples);     // 30 min at 30 s
+    ASSERT_EQ(size_t(60), stressedSamples);
+    ASSERT_NEAR(calm, again, 1e-9);
+    ASSERT_TRUE(stressed > calm);
+}
+
+TEST(test_workload_synthetic_timestamps)
+{
+    ASSERT_TRUE(WorkloadGenerator::FormatTimestamp(1767603600, 0, false) == "2026-01-05T09:00:00");
+    ASSERT_TRUE(WorkloadGenerator::FormatTimestamp(951782400 + 86399, 250, true) == "2000-02-29T23:59:59.250");
+    
+    WorkloadGenerator generator(MakeWorkloadConfig(1, WorkloadProfile::Calm()));
+    DataCollector collector;
+    std::vector<std::string> stamps;
+    generator.Replay(collector, 60000, [&](const MetricsSnapshot& snapshot) {
+        stamps.push_back(snapshot.timestamp);
+        ASSERT_TRUE(snapshot.sessionId == "synthetic_s42_p1");
+        ASSERT_TRUE(snapshot.projectName == "Project1");
+    });
+    ASSERT_EQ(size_t(30), stamps.size());
+    ASSERT_TRUE(stamps.front() == "2026-01-05T09:01:00");
+    ASSERT_TRUE(stamps.back() == "2026-01-05T09:30:00");
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -300,6 +1963,93 @@ int main()
     RUN_TEST(test_risk_level_labels);
     RUN_TEST(test_recommendations_exist);
     
+    // Change-Point Detection Tests
+    RUN_TEST(test_page_hinkley_stable_stream);
+    RUN_TEST(test_page_hinkley_upward_shift);
+    RUN_TEST(test_page_hinkley_downward_shift);
+    RUN_TEST(test_shift_detector_emits_events);
+    
+    // Burst Coalescing Tests
+    RUN_TEST(test_burst_filter_paste_coalesced);
+    RUN_TEST(test_burst_filter_normal_typing_passthrough);
+    RUN_TEST(test_burst_filter_short_burst_replayed);
+    RUN_TEST(test_burst_filter_auto_repeat_coalesced);
+    RUN_TEST(test_burst_filter_held_backspace_not_folded);
+    
+    // Event Queue Tests
+    RUN_TEST(test_event_queue_bounded_drop);
+    RUN_TEST(test_collector_derived_metrics_no_self_deadlock);
+    RUN_TEST(test_event_queue_concurrent_producers);
+    
+    // Snapshot Tests
+    RUN_TEST(test_snapshot_field_mask);
+    RUN_TEST(test_snapshot_cache_generation);
+    
+    // Instrumentation Tests
+    RUN_TEST(test_latency_histogram_percentiles);
+    RUN_TEST(test_scoped_probe_records_site);
+    
+    // Trace Recorder Tests
+    RUN_TEST(test_trace_disabled_records_nothing);
+    RUN_TEST(test_trace_spans_from_two_threads);
+    RUN_TEST(test_trace_ring_keeps_newest_spans);
+    
+    // System Sampler Tests
+    RUN_TEST(test_parse_proc_stat);
+    RUN_TEST(test_parse_statm_and_cpu_delta);
+    RUN_TEST(test_system_sampler_publishes_to_snapshot);
+    
+    // CSV Round-Trip Tests
+    RUN_TEST(test_csv_writer_reader_round_trip);
+    RUN_TEST(test_csv_reader_older_format);
+    
+    // Trend Ring Tests
+    RUN_TEST(test_trend_ring_columns);
+    RUN_TEST(test_trend_ring_wraps_and_caps_gaps);
+    
+    // Compile History Tests
+    RUN_TEST(test_compile_history_resolution_stats);
+    RUN_TEST(test_resolution_sketch_quantiles);
+    
+    // Diagnostic Parser Tests
+    RUN_TEST(test_diagnostic_parser_gcc_clang_log);
+    RUN_TEST(test_diagnostic_parser_html_build_log);
+    RUN_TEST(test_diagnostic_parser_streams_chunks);
+    
+    // Digraph Matrix Tests
+    RUN_TEST(test_digraph_matrix_deviations);
+    RUN_TEST(test_collector_digraphs_from_typed_keys);
+    
+    // Error Fingerprint Tests
+    RUN_TEST(test_error_fingerprint_cache_recurrence);
+    RUN_TEST(test_collector_reports_repeated_errors);
+    
+    // Live Metrics Segment Tests
+    RUN_TEST(test_live_segment_seqlock_round_trip);
+    RUN_TEST(test_live_segment_single_writer);
+    RUN_TEST(test_collector_publishes_live_metrics);
+    
+    // Metrics Endpoint Tests
+    RUN_TEST(test_metrics_endpoint_renders_prometheus);
+#if defined(__unix__) || defined(__APPLE__)
+    RUN_TEST(test_metrics_endpoint_serves_scrape_and_events);
+    RUN_TEST(test_metrics_endpoint_never_replaces_other_files);
+    RUN_TEST(test_metrics_endpoint_closes_idle_connections);
+#endif
+    
+    // Session Tail Tests
+    RUN_TEST(test_csv_parse_record_from_buffer);
+    RUN_TEST(test_tail_follower_ingests_appended_rows);
+    
+    // Session Clock Tests
+    RUN_TEST(test_session_clock_spans);
+    RUN_TEST(test_collector_excludes_paused_time);
+    
+    // Workload Generator Tests
+    RUN_TEST(test_workload_is_reproducible_from_seed);
+    RUN_TEST(test_workload_profiles_drive_score);
+    RUN_TEST(test_workload_synthetic_timestamps);
+    
     std::cout << std::endl;
     std::cout << "==================================" << std::endl;
     std::cout << " Results: " << testsPassed << "/" << testsRun << " passed" << std::endl;
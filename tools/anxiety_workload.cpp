@@ -0,0 +1,291 @@
+/**
+ * @file anxiety_workload.cpp
+ * @brief Synthetic workload generator for load and scaling tests.
+ *
+ * Generates deterministic editor event streams for many participants (see
+ * WorkloadGenerator) and writes, per participant:
+ *   participant_NNNNNN_events.csv    Raw event trace (t_ms,type,count,count2,flag,text)
+ *   participant_NNNNNN_session.csv   Session CSV, replayed through DataCollector
+ *                                    and written by CSVWriter
+ *
+ * Output depends only on --seed and the participant number, so a large run
+ * can be split into shards (--first / --participants) on several processes
+ * or machines and still produce exactly the same files.
+ *
+ * Usage:
+ *   anxiety_workload --out DIR [options]
+ *     --seed N            Base seed (default 1)
+ *     --participants N    Participants to generate (default 10)
+ *     --first N           First participant number (default 0)
+ *     --minutes M         Session length per participant (default 60)
+ *     --sample-ms N       Sample interval, one CSV row each (default 30000)
+ *     --profile P         calm | moderate | stressed | escalating | mixed (default mixed)
+ *     --jobs N            Worker threads (default: hardware concurrency)
+ *     --max-gb G          Stop starting participants once G GB are written
+ *     --no-events         Skip the raw event traces
+ *     --no-sessions       Skip the session CSVs
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/CSVWriter.h"
+#include "../src/DataCollector.h"
+#include "../src/WorkloadGenerator.h"
+
+using namespace AnxietyMonitor;
+
+namespace {
+
+struct Options {
+    std::string outDir;
+    uint64_t seed = 1;
+    uint32_t participants = 10;
+    uint32_t first = 0;
+    double minutes = 60.0;
+    int sampleMs = 30000;
+    std::string profile = "mixed";
+    unsigned jobs = 0;
+    double maxGb = 0.0;
+    bool events = true;
+    bool sessions = true;
+};
+
+struct Totals {
+    std::atomic<uint64_t> participants{0};
+    std::atomic<uint64_t> events{0};
+    std::atomic<uint64_t> rows{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+void PrintUsage()
+{
+    std::cerr << "usage: anxiety_workload --out DIR [--seed N] [--participants N] [--first N]\n"
+                 "                        [--minutes M] [--sample-ms N] [--profile P] [--jobs N]\n"
+                 "                        [--max-gb G] [--no-events] [--no-sessions]\n"
+                 "profiles: calm, moderate, stressed, escalating, mixed\n";
+}
+
+bool ParseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--out" && hasValue) {
+            options.outDir = argv[++i];
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--participants" && hasValue) {
+            options.participants = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--first" && hasValue) {
+            options.first = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--minutes" && hasValue) {
+            options.minutes = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--sample-ms" && hasValue) {
+            options.sampleMs = std::atoi(argv[++i]);
+        } else if (arg == "--profile" && hasValue) {
+            options.profile = argv[++i];
+        } else if (arg == "--jobs" && hasValue) {
+            options.jobs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--max-gb" && hasValue) {
+            options.maxGb = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--no-events") {
+            options.events = false;
+        } else if (arg == "--no-sessions") {
+            options.sessions = false;
+        } else {
+            std::cerr << "unknown or incomplete option: " << arg << "\n";
+            return false;
+        }
+    }
+    return !options.outDir.empty() && options.minutes > 0.0 && options.sampleMs > 0;
+}
+
+// Start/end profile for a participant ("mixed" draws one per participant)
+bool ResolveProfile(const std::string& name, uint64_t seed, uint32_t participant,
+                    WorkloadConfig& config)
+{
+    std::string chosen = name;
+    if (name == "mixed") {
+        static const char* const MIX[] = {"calm", "calm", "moderate", "stressed", "escalating"};
+        WorkloadRandom pick(seed * 31 + participant);
+        chosen = MIX[pick.NextU64() % (sizeof(MIX) / sizeof(MIX[0]))];
+    }
+
+    if (chosen == "calm") {
+        config.startProfile = config.endProfile = WorkloadProfile::Calm();
+    } else if (chosen == "moderate") {
+        config.startProfile = config.endProfile = WorkloadProfile::Moderate();
+    } else if (chosen == "stressed") {
+        config.startProfile = config.endProfile = WorkloadProfile::Stressed();
+    } else if (chosen == "escalating") {
+        config.startProfile = WorkloadProfile::Calm();
+        config.endProfile = WorkloadProfile::Stressed();
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string ParticipantName(uint32_t participant)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "participant_%06u", participant);
+    return name;
+}
+
+// Event trace: one line per event, milliseconds since session start
+uint64_t WriteEventTrace(const WorkloadConfig& config, const std::string& path)
+{
+    std::ofstream out(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "cannot write " << path << "\n";
+        return 0;
+    }
+    out << "t_ms,type,count,count2,flag,text\n";
+
+    WorkloadGenerator generator(config);
+    CollectorEvent event;
+    while (generator.Next(event)) {
+        out << WorkloadGenerator::ElapsedMs(event) << ','
+            << GetCollectorEventTypeLabel(event.type) << ','
+            << event.count << ',' << event.count2 << ','
+            << (event.flag ? 1 : 0) << ',' << event.text << '\n';
+    }
+    return generator.GetEventCount();
+}
+
+// Session CSV: replay through the collector, write with the plugin's writer
+uint64_t WriteSession(const WorkloadConfig& config, int sampleMs, const std::string& dir,
+                      const std::string& fileName, uint64_t& events)
+{
+    WorkloadGenerator generator(config);
+    CSVWriter writer;
+    writer.SetOutputDirectory(dir);
+
+    char sessionId[64];
+    std::snprintf(sessionId, sizeof(sessionId), "synthetic_s%llu_p%u",
+                  static_cast<unsigned long long>(config.seed), config.participant);
+    if (!writer.StartSession(sessionId, fileName)) {
+        std::cerr << writer.GetLastError() << "\n";
+        return 0;
+    }
+
+    // Write in batches: one flush per batch instead of per row
+    const size_t BATCH_ROWS = 512;
+    std::vector<std::shared_ptr<const MetricsSnapshot>> batch;
+    batch.reserve(BATCH_ROWS);
+
+    DataCollector collector;
+    uint64_t rows = generator.Replay(collector, sampleMs, [&](const MetricsSnapshot& snapshot) {
+        batch.push_back(std::make_shared<MetricsSnapshot>(snapshot));
+        if (batch.size() == BATCH_ROWS) {
+            writer.WriteSnapshots(batch);
+            batch.clear();
+        }
+    });
+    if (!batch.empty()) {
+        writer.WriteSnapshots(batch);
+    }
+    writer.EndSession();
+
+    events = generator.GetEventCount();
+    return rows;
+}
+
+uint64_t FileSize(const std::string& path)
+{
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : static_cast<uint64_t>(size);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    WorkloadConfig probe;
+    if (!ResolveProfile(options.profile, options.seed, 0, probe)) {
+        std::cerr << "unknown profile: " << options.profile << "\n";
+        return 2;
+    }
+
+    std::string error;
+    if (!CSVWriter::EnsureDirectoryExists(options.outDir, &error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    unsigned jobs = options.jobs ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    uint64_t byteLimit = static_cast<uint64_t>(options.maxGb * 1024.0 * 1024.0 * 1024.0);
+
+    Totals totals;
+    std::atomic<uint32_t> next{0};
+    auto started = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        for (;;) {
+            uint32_t index = next.fetch_add(1);
+            if (index >= options.participants) return;
+            if (byteLimit && totals.bytes.load() >= byteLimit) return;
+
+            WorkloadConfig config;
+            config.seed = options.seed;
+            config.participant = options.first + index;
+            config.durationMinutes = options.minutes;
+            // Stagger sessions over three months of working days
+            config.wallClockStart += static_cast<int64_t>(config.participant % 90) * 86400;
+            ResolveProfile(options.profile, options.seed, config.participant, config);
+
+            std::string base = ParticipantName(config.participant);
+            uint64_t events = 0;
+            if (options.events) {
+                std::string path = (std::filesystem::path(options.outDir) / (base + "_events.csv")).string();
+                events = WriteEventTrace(config, path);
+                totals.bytes += FileSize(path);
+            }
+            if (options.sessions) {
+                std::string fileName = base + "_session.csv";
+                totals.rows += WriteSession(config, options.sampleMs, options.outDir, fileName, events);
+                totals.bytes += FileSize((std::filesystem::path(options.outDir) / fileName).string());
+            }
+            totals.events += events;
+            ++totals.participants;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < jobs; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    double megabytes = totals.bytes.load() / (1024.0 * 1024.0);
+    std::cout << "participants=" << totals.participants.load()
+              << " events=" << totals.events.load()
+              << " rows=" << totals.rows.load()
+              << " bytes=" << totals.bytes.load()
+              << " seconds=" << seconds
+              << " MB/s=" << (seconds > 0.0 ? megabytes / seconds : 0.0) << std::endl;
+    return 0;
+}